@@ -7,24 +7,68 @@
  *   3. Fuzzy hash early-exit (check upper 24 bits first)
  *   4. Meet-in-the-middle attack support
  *   5. Prefix hash caching
+ *   6. Sibling-target solver (shared high-24-bit clusters, free last char)
+ *   7. Paired-target joint search (play_X/stop_X stems, both hashes must hit)
+ *   8. Edit-distance / token mutation search around cracked names (threaded)
+ *   9. Cross-bank template transplant (hero/creature/level token substitution)
+ *  10. Abbreviation / alias expansion (truncations, skeletons, initialisms)
+ *  11. Templated sandwich MITM (LIT1 ?{m} LIT2, forward table + inverted probes)
+ *  12. Lattice (LLL) preimage finder for long '?'-templated names (experimental)
+ *  13. Mask / hybrid kernel engine with 16-bit-lane low-bits prefilter and bitsliced (bit-plane trie) backends
+ *  14. Hash policies (FNV-1/32, Hash30, FNV-1a/32, FNV-1/64), single-pass 32+30-bit matching
+ *  15. Tagged multi-class target sets (event/switch/state/RTPC/bus/bank, bank tags)
+ *  16. Bank-routed attacks (per-route vocabulary, grammar and target subset)
+ *  17. Collision plausibility scorer (n-gram, vocabulary, bank, structure triage)
+ *  18. Priority-weighted attack scheduler (stride shares, live pruning of cracked targets)
+ *  19. Attack planner (keyspace, runtime, false-positive and yield estimates, budget fill)
+ *  20. Search-space ledger (completed units per target-set version, new-target-only re-runs)
+ *  21. Keyspace sharding (mixed-radix index ranges for mask/hybrid/brute, shard i of N)
+ *  22. Asynchronous jobs (start/poll/cancel/wait handles over the kernel engines)
+ *  23. Live target-set swap for running jobs (RCU-style snapshots, picked up per chunk)
+ *  24. NUMA-aware placement (Linux: pinned workers, per-node target filters, MITM partitions)
+ *  25. Candidate pipeline (generator -> hasher -> matcher threads over lock-free SPSC rings)
+ *  26. Packed batch hashing (offset/length arrays, length-bucketed lane-major SIMD)
+ *  27. Compiled dictionaries (mmap'd sorted word lists, LCP-incremental hashing, stored states)
+ *  28. DAWG vocabularies (minimal word graph, DFS hashing along edges, separator loop-back combinator)
+ *  29. Stream matching (newline/NUL-delimited stdin or FIFO, SIMD line split, tagged match output)
  *
  * Compile as DLL/shared library:
- *   Windows: gcc -O3 -march=native -shared fnv1_hash.c -o fnv1_hash.dll
- *   Linux:   gcc -O3 -march=native -shared -fPIC fnv1_hash.c -o fnv1_hash.so
+ *   Windows: gcc -O3 -march=native -shared fnv1_hash.c -o fnv1_hash.dll -lm
+ *   Linux:   gcc -O3 -march=native -shared -fPIC -pthread fnv1_hash.c -o fnv1_hash.so -lm
+ *
+ * Standalone benchmark (see BENCHMARK at the end):
+ *   gcc -O3 -march=native -DBENCHMARK fnv1_hash.c -o fnv_bench -pthread -lm
+ *
+ * Standalone stream matcher (pipe any generator in, see STREAM CLI at the end):
+ *   gcc -O3 -march=native -DSTREAM fnv1_hash.c -o fnv_stream -pthread -lm
  */
 
+#ifdef __linux__
+#define _GNU_SOURCE                 /* sched_setaffinity / CPU_SET */
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
 #include <string.h>
 #include <ctype.h>
 #include <time.h>
+#include <math.h>
+#include <errno.h>
 
 #ifdef _WIN32
     #define EXPORT __declspec(dllexport)
     #include <windows.h>
+    #include <io.h>
+    #include <fcntl.h>
 #else
     #define EXPORT __attribute__((visibility("default")))
+    #include <pthread.h>
+    #include <unistd.h>
+    #include <sched.h>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
 #endif
 
 /* Constants from official Audiokinetic Wwise SDK AkFNVHash.h */
@@ -32,6 +76,15 @@
 #define FNV_PRIME  16777619u       /* Hash32::Prime() */
 #define FNV_INVERSE 899433627u     /* Modular inverse of FNV_PRIME mod 2^32 */
 #define HASH30_MASK 0x3FFFFFFFu    /* For Hash30 XOR-fold variant */
+#define FNV64_OFFSET 14695981039346656037ull
+#define FNV64_PRIME  1099511628211ull
+
+/* Hash policies (target forms) understood by the tagged search engines */
+#define HASH_FNV1_32    0   /* Wwise short IDs */
+#define HASH_HASH30     1   /* FNV-1/32 XOR-folded to 30 bits (Hash30) */
+#define HASH_FNV1A_32   2   /* xor-then-multiply, other titles */
+#define HASH_FNV1_64    3
+#define HASH_POLICY_COUNT 4
 
 /* ============================================================================
  * CORE HASH FUNCTIONS
@@ -76,6 +129,40 @@ EXPORT uint32_t wwise_hash32_to_30(uint32_t h32) {
     return (h32 >> 30) ^ (h32 & HASH30_MASK);
 }
 
+/*
+ * Every 30-bit ID has exactly four 32-bit preimages under the fold
+ * (one per value of the top two bits), so any FNV-1/32 engine can hunt
+ * Hash30 IDs by matching out[] instead.  out must hold 4 * count entries.
+ */
+EXPORT int hash30_expand_targets(const uint32_t* ids, int count, uint32_t* out) {
+    for (int i = 0; i < count; i++) {
+        uint32_t id = ids[i] & HASH30_MASK;
+        for (uint32_t top = 0; top < 4; top++) {
+            out[i * 4 + top] = (top << 30) | (id ^ top);
+        }
+    }
+    return count * 4;
+}
+
+/* Digest of a (lowercased) string under any HASH_* policy */
+EXPORT uint64_t hash_policy_digest(int policy, const char* s) {
+    uint64_t h64 = FNV64_OFFSET;
+    uint32_t h = FNV_OFFSET;
+
+    switch (policy) {
+        case HASH_HASH30:
+            return wwise_hash30(s);
+        case HASH_FNV1A_32:
+            for (; *s; s++) h = (h ^ (uint8_t)tolower(*s)) * FNV_PRIME;
+            return h;
+        case HASH_FNV1_64:
+            for (; *s; s++) h64 = (h64 * FNV64_PRIME) ^ (uint8_t)tolower(*s);
+            return h64;
+        default:
+            return wwise_hash(s);
+    }
+}
+
 /* Fixed-length version - no null check, faster */
 EXPORT uint32_t wwise_hash_len(const char* s, int len) {
     uint32_t h = FNV_OFFSET;
@@ -531,48 +618,7703 @@ EXPORT int generate_prefix_hashes_wwise(
 }
 
 /* ============================================================================
- * BENCHMARK (standalone mode)
+ * SIBLING-TARGET SOLVER
+ * Last FNV-1 step is (h * PRIME) ^ c with c < 256, so names differing only in
+ * the final character share the upper 24 bits of h * PRIME ("hashes differing
+ * by 1-3 = numbered variants").  Targets are clustered on those 24 bits and
+ * each prefix state tests every last char of every clustered target in one
+ * binary search - the final character position becomes free.
  * ============================================================================ */
 
-#ifdef BENCHMARK
-int main() {
-    printf("FNV-1 Hash Benchmark\n");
-    printf("====================\n\n");
-    
-    const char* test_strings[] = {
-        "test", "hello_world", "play_music", "footstep_grass_run",
-        "abcdefghij", "ui_button_click", "explosion_large"
-    };
-    int num_strings = sizeof(test_strings) / sizeof(test_strings[0]);
-    
-    /* Verify hash values */
-    printf("Hash verification:\n");
-    for (int i = 0; i < num_strings; i++) {
-        printf("  %s -> 0x%08X\n", test_strings[i], wwise_hash(test_strings[i]));
+typedef struct {
+    uint32_t key;       /* target >> 8 (shared by all last-char siblings) */
+    uint32_t hash;      /* full target hash */
+} SiblingEntry;
+
+static int sibling_entry_compare(const void* a, const void* b) {
+    const SiblingEntry* x = (const SiblingEntry*)a;
+    const SiblingEntry* y = (const SiblingEntry*)b;
+    if (x->key != y->key) return x->key < y->key ? -1 : 1;
+    if (x->hash != y->hash) return x->hash < y->hash ? -1 : 1;
+    return 0;
+}
+
+/* Valid trailing character (member of CHARSET_REST) */
+static int is_wwise_char(uint8_t c) {
+    return (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+static SiblingEntry* sibling_build_index(const uint32_t* targets, int target_count) {
+    SiblingEntry* index = (SiblingEntry*)malloc(sizeof(SiblingEntry) * (target_count ? target_count : 1));
+    if (!index) return NULL;
+    for (int i = 0; i < target_count; i++) {
+        index[i].key = targets[i] >> 8;
+        index[i].hash = targets[i];
     }
-    
-    /* Benchmark */
-    printf("\nBenchmarking...\n");
-    int iterations = 10000000;
-    
-    clock_t start = clock();
-    volatile uint32_t h = 0;
-    for (int i = 0; i < iterations; i++) {
-        for (int j = 0; j < num_strings; j++) {
-            h ^= wwise_hash(test_strings[j]);
+    qsort(index, target_count, sizeof(SiblingEntry), sibling_entry_compare);
+    return index;
+}
+
+/* First index entry with the given key, or -1 */
+static int sibling_find(const SiblingEntry* index, int count, uint32_t key) {
+    int lo = 0, hi = count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (index[mid].key < key) lo = mid + 1;
+        else hi = mid;
+    }
+    return (lo < count && index[lo].key == key) ? lo : -1;
+}
+
+/*
+ * Hash set over a result list: open-addressed slots holding (index + 1) of a
+ * recorded hit, keyed on its hash.  Allocated on the first hit, so searches
+ * that find nothing pay nothing; a zeroed MatchIndex is an empty set.
+ */
+typedef struct {
+    int32_t* slots;
+    uint32_t mask;
+    int shift;
+} MatchIndex;
+
+static void match_index_free(MatchIndex* seen) {
+    free(seen->slots);
+    seen->slots = NULL;
+    seen->mask = 0;
+    seen->shift = 0;
+}
+
+static int match_index_reserve(MatchIndex* seen, int max_found) {
+    int bits = 4;
+    while (bits < 30 && (1u << bits) < (uint32_t)max_found * 2u) bits++;
+    seen->slots = (int32_t*)calloc((size_t)1 << bits, sizeof(int32_t));
+    if (!seen->slots) return 0;
+    seen->mask = (1u << bits) - 1;
+    seen->shift = 32 - bits;
+    return 1;
+}
+
+static uint32_t match_index_slot(const MatchIndex* seen, uint32_t key) {
+    return (key * 0x9E3779B1u) >> seen->shift;
+}
+
+/*
+ * Record a hit unless the same hash/name pair is already in the result list.
+ * seen indexes found_hashes[0..found); callers keep one per result list and
+ * free it with match_index_free.  Without memory for it the list is scanned.
+ */
+static int record_unique_match(
+    uint32_t h, const char* name, int seed,
+    uint32_t* found_hashes, char (*found_names)[32], int* found_seeds,
+    int found, int max_found, MatchIndex* seen
+) {
+    uint32_t slot = 0;
+    if (!seen->slots && found == 0) match_index_reserve(seen, max_found);
+    if (seen->slots) {
+        for (slot = match_index_slot(seen, h); seen->slots[slot]; slot = (slot + 1) & seen->mask) {
+            int i = seen->slots[slot] - 1;
+            if (found_hashes[i] == h && strcmp(found_names[i], name) == 0) return found;
+        }
+    } else {
+        for (int i = 0; i < found; i++) {
+            if (found_hashes[i] == h && strcmp(found_names[i], name) == 0) return found;
         }
     }
-    clock_t end = clock();
-    
-    double elapsed = (double)(end - start) / CLOCKS_PER_SEC;
-    double rate = (iterations * num_strings) / elapsed / 1e6;
-    
-    printf("  %d iterations x %d strings = %lld hashes\n", 
-           iterations, num_strings, (long long)iterations * num_strings);
-    printf("  Time: %.2f seconds\n", elapsed);
-    printf("  Rate: %.2f M hashes/sec\n", rate);
-    printf("  (dummy: 0x%08X)\n", h);
-    
+    if (found >= max_found) return found;
+    found_hashes[found] = h;
+    strcpy(found_names[found], name);
+    if (found_seeds) found_seeds[found] = seed;
+    if (seen->slots) seen->slots[slot] = found + 1;
+    return found + 1;
+}
+
+/*
+ * Probe every clustered target whose upper 24 bits match state * PRIME.
+ * name[0..len) is the candidate so far; the solved last char is appended.
+ */
+static int sibling_probe(
+    uint32_t state, char* name, int len, int seed,
+    const SiblingEntry* index, int index_count,
+    uint32_t* found_hashes, char (*found_names)[32], int* found_seeds,
+    int found, int max_found, MatchIndex* seen
+) {
+    uint32_t m = state * FNV_PRIME;
+    int i = sibling_find(index, index_count, m >> 8);
+    if (i < 0) return found;
+
+    for (; i < index_count && index[i].key == (m >> 8); i++) {
+        uint8_t c = (uint8_t)((m ^ index[i].hash) & 0xFF);
+        if (!is_wwise_char(c)) continue;
+        name[len] = (char)c;
+        name[len + 1] = '\0';
+        found = record_unique_match(index[i].hash, name, seed,
+                               found_hashes, found_names, found_seeds, found, max_found, seen);
+    }
+    name[len] = '\0';
+    return found;
+}
+
+/*
+ * Cluster analysis: report every high-24-bit group holding 2+ targets.
+ * Returns number of clusters written; cluster_keys[i] is (hash >> 8),
+ * cluster_sizes[i] the member count.
+ */
+EXPORT int sibling_cluster_targets(
+    const uint32_t* targets,
+    int target_count,
+    uint32_t* cluster_keys,
+    int* cluster_sizes,
+    int max_clusters
+) {
+    SiblingEntry* index = sibling_build_index(targets, target_count);
+    if (!index) return 0;
+
+    int clusters = 0;
+    for (int i = 0; i < target_count && clusters < max_clusters; ) {
+        int j = i + 1;
+        while (j < target_count && index[j].key == index[i].key) j++;
+        if (j - i >= 2) {
+            cluster_keys[clusters] = index[i].key;
+            cluster_sizes[clusters] = j - i;
+            clusters++;
+        }
+        i = j;
+    }
+
+    free(index);
+    return clusters;
+}
+
+/*
+ * Joint prefix search: enumerate every Wwise-charset prefix of length
+ * (len - 1) for len in [min_len, max_len] and solve the last character of
+ * all clustered targets at once.  Costs 26*37^(len-2) lookups per length
+ * instead of 26*37^(len-1) hashes.
+ */
+EXPORT int sibling_prefix_search(
+    int min_len,
+    int max_len,
+    const uint32_t* targets,
+    int target_count,
+    uint32_t* found_hashes,
+    char (*found_names)[32],
+    int max_found
+) {
+    char candidate[32];
+    uint32_t states[32];
+    int idx[32];
+    int found = 0;
+    MatchIndex seen = {0};
+
+    if (min_len < 2) min_len = 2;
+    if (max_len > 30) max_len = 30;
+
+    SiblingEntry* index = sibling_build_index(targets, target_count);
+    if (!index) return 0;
+
+    for (int len = min_len; len <= max_len && found < max_found; len++) {
+        int plen = len - 1;
+
+        /* Odometer over the prefix with per-position cached states */
+        for (int i = 0; i < plen; i++) idx[i] = 0;
+        states[0] = FNV_OFFSET;
+        for (int i = 0; i < plen; i++) {
+            candidate[i] = (i == 0) ? CHARSET_FIRST[0] : CHARSET_REST[0];
+            states[i + 1] = (states[i] * FNV_PRIME) ^ (uint8_t)candidate[i];
+        }
+        candidate[plen] = '\0';
+
+        while (found < max_found) {
+            found = sibling_probe(states[plen], candidate, plen, -1, index, target_count,
+                                  found_hashes, found_names, NULL, found, max_found, &seen);
+
+            int pos = plen - 1;
+            while (pos >= 0) {
+                int limit = (pos == 0) ? CHARSET_FIRST_LEN : CHARSET_REST_LEN;
+                if (++idx[pos] < limit) break;
+                idx[pos] = 0;
+                pos--;
+            }
+            if (pos < 0) break;
+
+            for (int i = pos; i < plen; i++) {
+                candidate[i] = (i == 0) ? CHARSET_FIRST[idx[i]] : CHARSET_REST[idx[i]];
+                states[i + 1] = (states[i] * FNV_PRIME) ^ (uint8_t)candidate[i];
+            }
+        }
+    }
+
+    match_index_free(&seen);
+    free(index);
+    return found;
+}
+
+/* Depth-first continuation of a truncated seed; the final char is solved by probe */
+static int sibling_extend(
+    uint32_t state, char* name, int len, int depth_left, int seed,
+    const SiblingEntry* index, int index_count,
+    uint32_t* found_hashes, char (*found_names)[32], int* found_seeds,
+    int found, int max_found, MatchIndex* seen
+) {
+    found = sibling_probe(state, name, len, seed, index, index_count,
+                         found_hashes, found_names, found_seeds, found, max_found, seen);
+    if (depth_left <= 1 || len + 2 >= 32) return found;
+
+    for (int c = 0; c < CHARSET_REST_LEN && found < max_found; c++) {
+        name[len] = CHARSET_REST[c];
+        name[len + 1] = '\0';
+        found = sibling_extend((state * FNV_PRIME) ^ (uint8_t)CHARSET_REST[c],
+                               name, len + 1, depth_left - 1, seed, index, index_count,
+                               found_hashes, found_names, found_seeds, found, max_found, seen);
+    }
+    name[len] = '\0';
+    return found;
+}
+
+/*
+ * Cracked-name neighborhood: for every known name and every truncation
+ * point, test all continuations of 1..max_extend characters.  Harvests
+ * _a02/_a03-style siblings of cracked names.  found_seeds[i] is the index
+ * of the name each hit grew from (may be NULL).
+ */
+EXPORT int sibling_neighborhood_search(
+    const char** names,
+    int name_count,
+    int max_extend,
+    const uint32_t* targets,
+    int target_count,
+    uint32_t* found_hashes,
+    char (*found_names)[32],
+    int* found_seeds,
+    int max_found
+) {
+    char candidate[32];
+    int found = 0;
+    MatchIndex seen = {0};
+
+    SiblingEntry* index = sibling_build_index(targets, target_count);
+    if (!index) return 0;
+
+    for (int n = 0; n < name_count && found < max_found; n++) {
+        int name_len = (int)strlen(names[n]);
+        if (name_len > 30) name_len = 30;
+
+        uint32_t state = FNV_OFFSET;
+        for (int t = 0; t <= name_len && found < max_found; t++) {
+            /* state == hash of names[n][0..t) */
+            if (t > 0) {
+                candidate[t - 1] = (char)tolower(names[n][t - 1]);
+                state = (state * FNV_PRIME) ^ (uint8_t)candidate[t - 1];
+            }
+            if (t == 0) continue;
+            candidate[t] = '\0';
+            found = sibling_extend(state, candidate, t, max_extend, n, index, target_count,
+                                   found_hashes, found_names, found_seeds, found, max_found, &seen);
+        }
+    }
+
+    match_index_free(&seen);
+    free(index);
+    return found;
+}
+
+/* ============================================================================
+ * PAIRED-TARGET JOINT SEARCH
+ * Events come in pairs (play_X/stop_X, start_X/end_X).  A shared stem X is
+ * enumerated once, both hashes are derived from the two cached template
+ * prefix states, and a hit needs BOTH targets of a pair to match - a false
+ * positive needs a 64-bit coincidence, so stems can run at lengths where
+ * single-target brute force drowns in collisions.
+ *
+ * Templates are "%s" format strings ("play_%s", "%s_start").  Template
+ * suffixes are removed from the targets with the inverse hash up front, so
+ * the inner loop only carries the two prefix states.
+ * ============================================================================ */
+
+typedef struct {
+    uint32_t a;         /* first target, template suffix inverted away */
+    uint32_t b;         /* second target, template suffix inverted away */
+    int pair;           /* index into caller's pair arrays */
+} PairEntry;
+
+static int pair_entry_compare(const void* x, const void* y) {
+    const PairEntry* p = (const PairEntry*)x;
+    const PairEntry* q = (const PairEntry*)y;
+    if (p->a != q->a) return p->a < q->a ? -1 : 1;
     return 0;
 }
+
+/* Split "play_%s_loop" into prefix state and the suffix after %s */
+static int pair_split_template(const char* tmpl, uint32_t* prefix_state, const char** suffix) {
+    const char* mark = strstr(tmpl, "%s");
+    if (!mark) return 0;
+    *prefix_state = FNV_OFFSET;
+    for (const char* p = tmpl; p < mark; p++) {
+        *prefix_state = (*prefix_state * FNV_PRIME) ^ (uint8_t)tolower(*p);
+    }
+    *suffix = mark + 2;
+    return 1;
+}
+
+/* Build the (inverted) pair table for one template pair, sorted on a */
+static PairEntry* pair_build_table(
+    const char* suffix_a, const char* suffix_b,
+    const uint32_t* pairs_a, const uint32_t* pairs_b, int pair_count
+) {
+    PairEntry* table = (PairEntry*)malloc(sizeof(PairEntry) * (pair_count ? pair_count : 1));
+    if (!table) return NULL;
+    int len_a = (int)strlen(suffix_a), len_b = (int)strlen(suffix_b);
+    for (int i = 0; i < pair_count; i++) {
+        table[i].a = wwise_hash_inverse(pairs_a[i], suffix_a, len_a);
+        table[i].b = wwise_hash_inverse(pairs_b[i], suffix_b, len_b);
+        table[i].pair = i;
+    }
+    qsort(table, pair_count, sizeof(PairEntry), pair_entry_compare);
+    return table;
+}
+
+/* Check one stem end-state pair against the table; returns matched pair or -1 */
+static inline int pair_probe(const PairEntry* table, int count, uint32_t ha, uint32_t hb) {
+    int lo = 0, hi = count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (table[mid].a < ha) lo = mid + 1;
+        else hi = mid;
+    }
+    for (; lo < count && table[lo].a == ha; lo++) {
+        if (table[lo].b == hb) return table[lo].pair;
+    }
+    return -1;
+}
+
+/*
+ * Build candidate pairs: every ordered pair of distinct targets sharing a
+ * bank id.  Returns pair count written to pairs_a/pairs_b.
+ */
+EXPORT int pair_targets_by_bank(
+    const uint32_t* targets,
+    const uint32_t* bank_ids,
+    int target_count,
+    uint32_t* pairs_a,
+    uint32_t* pairs_b,
+    int max_pairs
+) {
+    int count = 0;
+    for (int i = 0; i < target_count; i++) {
+        for (int j = 0; j < target_count && count < max_pairs; j++) {
+            if (i == j || bank_ids[i] != bank_ids[j]) continue;
+            pairs_a[count] = targets[i];
+            pairs_b[count] = targets[j];
+            count++;
+        }
+    }
+    return count;
+}
+
+/*
+ * Brute-force the shared stem over CHARSET_REST for stem lengths
+ * [min_stem, max_stem] under every template pair.
+ * Each hit reports the stem, template index and pair index.
+ */
+EXPORT int pair_search_brute(
+    const char** templates_a,
+    const char** templates_b,
+    int template_count,
+    int min_stem,
+    int max_stem,
+    const uint32_t* pairs_a,
+    const uint32_t* pairs_b,
+    int pair_count,
+    char (*found_stems)[32],
+    int* found_templates,
+    int* found_pairs,
+    int max_found
+) {
+    char stem[32];
+    uint32_t states_a[32], states_b[32];
+    int idx[32];
+    int found = 0;
+
+    if (min_stem < 1) min_stem = 1;
+    if (max_stem > 24) max_stem = 24;
+
+    for (int t = 0; t < template_count && found < max_found; t++) {
+        uint32_t base_a, base_b;
+        const char *suffix_a, *suffix_b;
+        if (!pair_split_template(templates_a[t], &base_a, &suffix_a)) continue;
+        if (!pair_split_template(templates_b[t], &base_b, &suffix_b)) continue;
+
+        PairEntry* table = pair_build_table(suffix_a, suffix_b, pairs_a, pairs_b, pair_count);
+        if (!table) break;
+
+        for (int len = min_stem; len <= max_stem && found < max_found; len++) {
+            states_a[0] = base_a;
+            states_b[0] = base_b;
+            for (int i = 0; i < len; i++) {
+                idx[i] = 0;
+                stem[i] = CHARSET_REST[0];
+                states_a[i + 1] = (states_a[i] * FNV_PRIME) ^ (uint8_t)stem[i];
+                states_b[i + 1] = (states_b[i] * FNV_PRIME) ^ (uint8_t)stem[i];
+            }
+            stem[len] = '\0';
+
+            while (found < max_found) {
+                int p = pair_probe(table, pair_count, states_a[len], states_b[len]);
+                if (p >= 0) {
+                    strcpy(found_stems[found], stem);
+                    found_templates[found] = t;
+                    found_pairs[found] = p;
+                    found++;
+                }
+
+                int pos = len - 1;
+                while (pos >= 0 && ++idx[pos] >= CHARSET_REST_LEN) {
+                    idx[pos] = 0;
+                    pos--;
+                }
+                if (pos < 0) break;
+
+                for (int i = pos; i < len; i++) {
+                    stem[i] = CHARSET_REST[idx[i]];
+                    states_a[i + 1] = (states_a[i] * FNV_PRIME) ^ (uint8_t)stem[i];
+                    states_b[i + 1] = (states_b[i] * FNV_PRIME) ^ (uint8_t)stem[i];
+                }
+            }
+        }
+
+        free(table);
+    }
+
+    return found;
+}
+
+/* Same joint check with stems taken from a word list */
+EXPORT int pair_search_words(
+    const char** templates_a,
+    const char** templates_b,
+    int template_count,
+    const char** stems,
+    int stem_count,
+    const uint32_t* pairs_a,
+    const uint32_t* pairs_b,
+    int pair_count,
+    char (*found_stems)[32],
+    int* found_templates,
+    int* found_pairs,
+    int max_found
+) {
+    int found = 0;
+
+    for (int t = 0; t < template_count && found < max_found; t++) {
+        uint32_t base_a, base_b;
+        const char *suffix_a, *suffix_b;
+        if (!pair_split_template(templates_a[t], &base_a, &suffix_a)) continue;
+        if (!pair_split_template(templates_b[t], &base_b, &suffix_b)) continue;
+
+        PairEntry* table = pair_build_table(suffix_a, suffix_b, pairs_a, pairs_b, pair_count);
+        if (!table) break;
+
+        for (int s = 0; s < stem_count && found < max_found; s++) {
+            uint32_t ha = wwise_hash_continue(base_a, stems[s]);
+            uint32_t hb = wwise_hash_continue(base_b, stems[s]);
+            int p = pair_probe(table, pair_count, ha, hb);
+            if (p >= 0 && strlen(stems[s]) < 32) {
+                strcpy(found_stems[found], stems[s]);
+                found_templates[found] = t;
+                found_pairs[found] = p;
+                found++;
+            }
+        }
+
+        free(table);
+    }
+
+    return found;
+}
+
+/* ============================================================================
+ * THREADING
+ * Minimal portable worker pool primitives (Win32 threads / pthreads).
+ * Worker bodies are declared with THREAD_FUNC and end with THREAD_RETURN.
+ * ============================================================================ */
+
+#ifdef _WIN32
+typedef HANDLE fnv_thread_t;
+#define THREAD_FUNC(name, arg) static DWORD WINAPI name(LPVOID arg)
+#define THREAD_RETURN return 0
+#define ATOMIC_FETCH_ADD(p, v) InterlockedExchangeAdd((volatile LONG*)(p), (LONG)(v))
+
+static int fnv_thread_start(fnv_thread_t* t, LPTHREAD_START_ROUTINE fn, void* arg) {
+    *t = CreateThread(NULL, 0, fn, arg, 0, NULL);
+    return *t != NULL;
+}
+
+static void fnv_thread_join(fnv_thread_t t) {
+    WaitForSingleObject(t, INFINITE);
+    CloseHandle(t);
+}
+
+static int fnv_cpu_count(void) {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+}
+
+typedef CRITICAL_SECTION fnv_mutex_t;
+#define fnv_mutex_init(m)     InitializeCriticalSection(m)
+#define fnv_mutex_lock(m)     EnterCriticalSection(m)
+#define fnv_mutex_unlock(m)   LeaveCriticalSection(m)
+#define fnv_mutex_destroy(m)  DeleteCriticalSection(m)
+
+/* Wall-clock seconds (clock() is process CPU time, summed over threads) */
+static double fnv_now(void) {
+    LARGE_INTEGER freq, t;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&t);
+    return (double)t.QuadPart / (double)freq.QuadPart;
+}
+#else
+typedef pthread_t fnv_thread_t;
+#define THREAD_FUNC(name, arg) static void* name(void* arg)
+#define THREAD_RETURN return NULL
+#define ATOMIC_FETCH_ADD(p, v) __atomic_fetch_add((p), (v), __ATOMIC_RELAXED)
+
+static int fnv_thread_start(fnv_thread_t* t, void* (*fn)(void*), void* arg) {
+    return pthread_create(t, NULL, fn, arg) == 0;
+}
+
+static void fnv_thread_join(fnv_thread_t t) {
+    pthread_join(t, NULL);
+}
+
+static int fnv_cpu_count(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+
+typedef pthread_mutex_t fnv_mutex_t;
+#define fnv_mutex_init(m)     pthread_mutex_init((m), NULL)
+#define fnv_mutex_lock(m)     pthread_mutex_lock(m)
+#define fnv_mutex_unlock(m)   pthread_mutex_unlock(m)
+#define fnv_mutex_destroy(m)  pthread_mutex_destroy(m)
+
+static double fnv_now(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+#endif
+
+#define MAX_THREADS 256
+
+static int resolve_thread_count(int num_threads) {
+    if (num_threads <= 0) num_threads = fnv_cpu_count();
+    if (num_threads > MAX_THREADS) num_threads = MAX_THREADS;
+    return num_threads;
+}
+
+/* ============================================================================
+ * NUMA PLACEMENT
+ * On multi-socket Linux hosts the node layout is read from
+ * /sys/devices/system/node (no libnuma).  Worker slot i maps to the i-th
+ * CPU in node order and the worker is pinned to that CPU's node, so a pool
+ * fills one node before spilling onto the next.  Pools running side by
+ * side (concurrent jobs) reserve consecutive slots and so land on
+ * different CPUs.  Memory follows the kernel's first-touch policy: a
+ * replica allocated and written by a pinned worker lands on its node.
+ * Nodes are numbered densely over those with CPUs this process may use.
+ * The blocking single-call searches (mask, hybrid, brute force, tagged)
+ * run on the caller's thread and are not pinned.  Elsewhere (Windows, one
+ * node, placement disabled) everything is a no-op on a single node 0.
+ * ============================================================================ */
+
+#define NUMA_MAX_NODES 16
+#define NUMA_SYSFS_NODES 1024       /* node numbers probed in sysfs */
+
+typedef struct {
+    int nodes;
+    int cpu_count;
+    int cpus[MAX_THREADS];          /* CPUs in node order */
+    int cpu_node[MAX_THREADS];
+    int node_cpus[NUMA_MAX_NODES];
+} NumaTopology;
+
+static NumaTopology numa_topo;
+static int numa_probed = 0;
+static int numa_placement = 1;
+static volatile long numa_next_slot = 0;
+
+#ifdef __linux__
+/* Append the allowed CPUs of a sysfs cpulist ("0-15,32-47") as node `node` */
+static void numa_add_cpulist(NumaTopology* t, int node, const char* list, const cpu_set_t* allowed) {
+    const char* p = list;
+    while (*p && *p != '\n') {
+        char* end;
+        long lo = strtol(p, &end, 10), hi = lo;
+        if (end == p) break;
+        if (*end == '-') hi = strtol(end + 1, &end, 10);
+        for (long c = lo; c <= hi && t->cpu_count < MAX_THREADS; c++) {
+            if (c >= CPU_SETSIZE || !CPU_ISSET((int)c, allowed)) continue;
+            t->cpus[t->cpu_count] = (int)c;
+            t->cpu_node[t->cpu_count++] = node;
+            t->node_cpus[node]++;
+        }
+        p = *end == ',' ? end + 1 : end;
+    }
+}
+#endif
+
+static const NumaTopology* numa_topology_get(void) {
+    if (numa_probed) return &numa_topo;
+    NumaTopology t;
+    memset(&t, 0, sizeof(t));
+#ifdef __linux__
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) CPU_ZERO(&allowed);
+    /* sysfs node numbers may have gaps; nodes without allowed CPUs are skipped */
+    for (int node = 0; node < NUMA_SYSFS_NODES && t.nodes < NUMA_MAX_NODES; node++) {
+        char path[64], list[1024];
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+        FILE* f = fopen(path, "r");
+        if (!f) continue;
+        if (fgets(list, sizeof(list), f)) numa_add_cpulist(&t, t.nodes, list, &allowed);
+        fclose(f);
+        if (t.node_cpus[t.nodes] > 0) t.nodes++;
+    }
+#endif
+    if (t.nodes == 0 || t.cpu_count == 0) {
+        memset(&t, 0, sizeof(t));
+        t.nodes = 1;
+    }
+    numa_topo = t;
+    numa_probed = 1;
+    return &numa_topo;
+}
+
+/* First of `count` consecutive worker slots for a new pool */
+static int numa_reserve_slots(int count) {
+    const NumaTopology* t = numa_topology_get();
+    if (!numa_placement || t->nodes < 2) return 0;
+    return (int)(ATOMIC_FETCH_ADD(&numa_next_slot, count) % t->cpu_count);
+}
+
+/* Node worker slot `index` runs on (0 when placement is off) */
+static int numa_worker_node(int index) {
+    const NumaTopology* t = numa_topology_get();
+    if (!numa_placement || t->nodes < 2) return 0;
+    return t->cpu_node[index % t->cpu_count];
+}
+
+/* First worker index placed on `node` */
+static int numa_node_first_worker(int node) {
+    const NumaTopology* t = numa_topology_get();
+    for (int i = 0; i < t->cpu_count; i++) {
+        if (t->cpu_node[i] == node) return i;
+    }
+    return 0;
+}
+
+/* Highest node + 1 among slots [first, first + threads) (1 = single node) */
+static int numa_pool_nodes(int first, int threads) {
+    int nodes = 1;
+    for (int i = first; i < first + threads; i++) {
+        if (numa_worker_node(i) + 1 > nodes) nodes = numa_worker_node(i) + 1;
+    }
+    return nodes;
+}
+
+/* Distinct nodes of slots [first, first + threads) in order of first use; returns the count */
+static int numa_pool_node_list(int first, int threads, int* list) {
+    int count = 0;
+    for (int i = first; i < first + threads; i++) {
+        int node = numa_worker_node(i), k = 0;
+        while (k < count && list[k] != node) k++;
+        if (k == count) list[count++] = node;
+    }
+    return count;
+}
+
+/* Pin the calling thread to the CPUs of worker slot `index`'s node */
+static void numa_pin_worker(int index) {
+#ifdef __linux__
+    const NumaTopology* t = numa_topology_get();
+    if (!numa_placement || t->nodes < 2) return;
+    int node = numa_worker_node(index);
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int i = 0; i < t->cpu_count; i++) {
+        if (t->cpu_node[i] == node) CPU_SET(t->cpus[i], &set);
+    }
+    sched_setaffinity(0, sizeof(set), &set);
+#else
+    (void)index;
+#endif
+}
+
+/*
+ * NUMA layout: returns the node count and fills node_cpus[0..max_nodes)
+ * with each node's CPU count (1 node and the CPU count off Linux).
+ */
+EXPORT int numa_topology(int* node_cpus, int max_nodes) {
+    const NumaTopology* t = numa_topology_get();
+    for (int n = 0; n < max_nodes && n < t->nodes; n++) {
+        node_cpus[n] = t->cpu_count ? t->node_cpus[n] : fnv_cpu_count();
+    }
+    return t->nodes;
+}
+
+/* Enable (default) or disable worker pinning and per-node replicas */
+EXPORT void numa_set_placement(int enabled) {
+    numa_placement = enabled != 0;
+}
+
+/*
+ * Replace the probed layout with `nodes` nodes of node_cpus[k] consecutive
+ * CPUs (manual layouts and tests); nodes <= 0 probes sysfs again.  Call it
+ * while no pool is running.
+ */
+EXPORT void numa_set_topology(const int* node_cpus, int nodes) {
+    NumaTopology t;
+    memset(&t, 0, sizeof(t));
+    numa_probed = 0;
+    if (nodes <= 0) return;
+    for (int n = 0; n < nodes && n < NUMA_MAX_NODES; n++) {
+        for (int c = 0; c < node_cpus[n] && t.cpu_count < MAX_THREADS; c++) {
+            t.cpus[t.cpu_count] = t.cpu_count;
+            t.cpu_node[t.cpu_count++] = t.nodes;
+            t.node_cpus[t.nodes]++;
+        }
+        if (t.node_cpus[t.nodes] > 0) t.nodes++;
+    }
+    if (t.nodes == 0) return;
+    numa_topo = t;
+    numa_probed = 1;
+}
+
+static int uint32_compare(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+/* Sorted private copy of a target array (is_target needs sorted input) */
+static uint32_t* sorted_targets_copy(const uint32_t* targets, int target_count) {
+    uint32_t* copy = (uint32_t*)malloc(sizeof(uint32_t) * (target_count ? target_count : 1));
+    if (!copy) return NULL;
+    memcpy(copy, targets, sizeof(uint32_t) * target_count);
+    qsort(copy, target_count, sizeof(uint32_t), uint32_compare);
+    return copy;
+}
+
+/* ============================================================================
+ * EDIT-DISTANCE MUTATION SEARCH
+ * Stubborn names are likely small variations of cracked ones (balrog_*,
+ * siege_tower_*, oli_* vs oliphaunt_*).  Every cracked name seeds:
+ *   - char insertions / deletions / substitutions up to max_edits
+ *   - token swaps (split on '_')
+ *   - token insertions from a bank vocabulary at every token boundary
+ * The hash state is carried up to each mutation point and only the tail
+ * after it is re-hashed.  Seeds are handed out to threads one at a time.
+ * ============================================================================ */
+
+#define MUTATION_MAX_TOKENS 16
+
+typedef struct {
+    /* shared, read-only */
+    const char** seeds;
+    int seed_count;
+    int max_edits;
+    const char** vocab;
+    int vocab_count;
+    const uint32_t* targets;    /* sorted */
+    int target_count;
+    volatile long* next_seed;
+
+    /* per-thread */
+    int index;                  /* pool position (NUMA placement) */
+    uint32_t* found_hashes;
+    char (*found_names)[32];
+    int* found_seeds;
+    int found;
+    int max_found;
+    MatchIndex seen;
+    uint64_t tested;
+
+    /* current seed */
+    const char* seed;
+    int seed_len;
+    int seed_index;
+    char out[64];
+} MutationWorker;
+
+static void mutation_hit(MutationWorker* w, uint32_t h, const char* head, int head_len, const char* tail) {
+    char name[64];
+    int tail_len = (int)strlen(tail);
+    if (head_len + tail_len > 31 || head_len + tail_len == 0) return;
+    memcpy(name, head, head_len);
+    memcpy(name + head_len, tail, tail_len + 1);
+    if (!(name[0] >= 'a' && name[0] <= 'z')) return;
+    w->found = record_unique_match(h, name, w->seed_index, w->found_hashes, w->found_names,
+                                   w->found_seeds, w->found, w->max_found, &w->seen);
+}
+
+/*
+ * out[0..out_len) is the mutated head with hash `state`; seed[pos..] is the
+ * untouched tail.  Test the candidate as-is, then spend one more edit at
+ * every later position.
+ */
+static void mutation_recurse(MutationWorker* w, int pos, int out_len, uint32_t state, int edits_left) {
+    const char* seed = w->seed;
+    int n = w->seed_len;
+
+    uint32_t h = state;
+    for (int i = pos; i < n; i++) h = (h * FNV_PRIME) ^ (uint8_t)seed[i];
+    w->tested++;
+    if (is_target(h, w->targets, w->target_count)) {
+        mutation_hit(w, h, w->out, out_len, seed + pos);
+    }
+    if (edits_left == 0 || w->found >= w->max_found) return;
+
+    uint32_t s = state;
+    for (int i = pos; i <= n; i++) {
+        int ol = out_len + (i - pos);
+        if (ol + 1 > 31) break;
+
+        /* insertion before seed[i] */
+        for (int c = 0; c < CHARSET_REST_LEN; c++) {
+            w->out[ol] = CHARSET_REST[c];
+            mutation_recurse(w, i, ol + 1, (s * FNV_PRIME) ^ (uint8_t)CHARSET_REST[c], edits_left - 1);
+        }
+        if (i == n) break;
+
+        /* deletion of seed[i] */
+        mutation_recurse(w, i + 1, ol, s, edits_left - 1);
+
+        /* substitution of seed[i] */
+        for (int c = 0; c < CHARSET_REST_LEN; c++) {
+            if (CHARSET_REST[c] == seed[i]) continue;
+            w->out[ol] = CHARSET_REST[c];
+            mutation_recurse(w, i + 1, ol + 1, (s * FNV_PRIME) ^ (uint8_t)CHARSET_REST[c], edits_left - 1);
+        }
+
+        /* keep seed[i] and move on */
+        w->out[ol] = seed[i];
+        s = (s * FNV_PRIME) ^ (uint8_t)seed[i];
+    }
+}
+
+/* Join tokens[from..to) with '_' into buf, continuing state; returns new length */
+static int mutation_join(char* buf, int len, uint32_t* state,
+                         const char** tokens, const int* token_lens, int from, int to) {
+    for (int t = from; t < to; t++) {
+        if (len > 0 && len < 48) {
+            buf[len++] = '_';
+            *state = (*state * FNV_PRIME) ^ (uint8_t)'_';
+        }
+        for (int i = 0; i < token_lens[t] && len < 48; i++) {
+            buf[len++] = tokens[t][i];
+            *state = (*state * FNV_PRIME) ^ (uint8_t)tokens[t][i];
+        }
+    }
+    buf[len] = '\0';
+    return len;
+}
+
+static void mutation_tokens(MutationWorker* w) {
+    const char* tokens[MUTATION_MAX_TOKENS];
+    int token_lens[MUTATION_MAX_TOKENS];
+    int k = 0;
+    char buf[64];
+
+    /* split seed on '_' (empty tokens dropped) */
+    for (const char* p = w->seed; *p && k < MUTATION_MAX_TOKENS; ) {
+        while (*p == '_') p++;
+        if (!*p) break;
+        const char* start = p;
+        while (*p && *p != '_') p++;
+        tokens[k] = start;
+        token_lens[k] = (int)(p - start);
+        k++;
+    }
+
+    /* token swaps */
+    for (int i = 0; i < k; i++) {
+        for (int j = i + 1; j < k && w->found < w->max_found; j++) {
+            const char* tmp = tokens[i]; tokens[i] = tokens[j]; tokens[j] = tmp;
+            int tl = token_lens[i]; token_lens[i] = token_lens[j]; token_lens[j] = tl;
+
+            uint32_t h = FNV_OFFSET;
+            int len = mutation_join(buf, 0, &h, tokens, token_lens, 0, k);
+            w->tested++;
+            if (len <= 31 && is_target(h, w->targets, w->target_count)) mutation_hit(w, h, buf, len, "");
+
+            tmp = tokens[i]; tokens[i] = tokens[j]; tokens[j] = tmp;
+            tl = token_lens[i]; token_lens[i] = token_lens[j]; token_lens[j] = tl;
+        }
+    }
+
+    /* vocabulary token insertions at every boundary */
+    for (int b = 0; b <= k && w->vocab; b++) {
+        uint32_t head_state = FNV_OFFSET;
+        int head_len = mutation_join(buf, 0, &head_state, tokens, token_lens, 0, b);
+        if (head_len > 0) {
+            buf[head_len++] = '_';
+            head_state = (head_state * FNV_PRIME) ^ (uint8_t)'_';
+        }
+
+        for (int v = 0; v < w->vocab_count && w->found < w->max_found; v++) {
+            const char* word = w->vocab[v];
+            int len = head_len;
+            uint32_t h = head_state;
+            for (const char* p = word; *p && len < 48; p++) {
+                buf[len++] = (char)tolower(*p);
+                h = (h * FNV_PRIME) ^ (uint8_t)buf[len - 1];
+            }
+            len = mutation_join(buf, len, &h, tokens, token_lens, b, k);
+            w->tested++;
+            if (len <= 31 && is_target(h, w->targets, w->target_count)) mutation_hit(w, h, buf, len, "");
+        }
+    }
+}
+
+THREAD_FUNC(mutation_worker, arg) {
+    MutationWorker* w = (MutationWorker*)arg;
+    char lowered[64];
+
+    numa_pin_worker(w->index);
+    for (;;) {
+        long s = ATOMIC_FETCH_ADD(w->next_seed, 1);
+        if (s >= w->seed_count || w->found >= w->max_found) break;
+
+        int n = 0;
+        for (const char* p = w->seeds[s]; *p && n < 31; p++) lowered[n++] = (char)tolower(*p);
+        lowered[n] = '\0';
+
+        w->seed = lowered;
+        w->seed_len = n;
+        w->seed_index = (int)s;
+        mutation_recurse(w, 0, 0, FNV_OFFSET, w->max_edits);
+        mutation_tokens(w);
+    }
+    THREAD_RETURN;
+}
+
+/*
+ * Run the mutation neighborhood of every seed against the target set.
+ * max_edits is clamped to 1..3; vocab may be NULL.  found_seeds[i] is the
+ * index of the seed that produced hit i.  *tested (optional) receives the
+ * number of candidates hashed.  num_threads <= 0 uses every core.
+ */
+EXPORT int mutation_search(
+    const char** seeds,
+    int seed_count,
+    int max_edits,
+    const char** vocab,
+    int vocab_count,
+    const uint32_t* targets,
+    int target_count,
+    int num_threads,
+    uint32_t* found_hashes,
+    char (*found_names)[32],
+    int* found_seeds,
+    int max_found,
+    uint64_t* tested
+) {
+    fnv_thread_t threads[MAX_THREADS];
+    MutationWorker* workers;
+    volatile long next_seed = 0;
+    int found = 0;
+
+    if (max_edits < 1) max_edits = 1;
+    if (max_edits > 3) max_edits = 3;
+    num_threads = resolve_thread_count(num_threads);
+
+    uint32_t* sorted = sorted_targets_copy(targets, target_count);
+    workers = (MutationWorker*)calloc(num_threads, sizeof(MutationWorker));
+    if (!sorted || !workers) {
+        free(sorted);
+        free(workers);
+        return 0;
+    }
+
+    int slot = numa_reserve_slots(num_threads);
+    for (int t = 0; t < num_threads; t++) {
+        MutationWorker* w = &workers[t];
+        w->index = slot + t;
+        w->seeds = seeds;
+        w->seed_count = seed_count;
+        w->max_edits = max_edits;
+        w->vocab = vocab;
+        w->vocab_count = vocab ? vocab_count : 0;
+        w->targets = sorted;
+        w->target_count = target_count;
+        w->next_seed = &next_seed;
+        w->max_found = max_found;
+        w->found_hashes = (uint32_t*)malloc(sizeof(uint32_t) * max_found);
+        w->found_names = (char (*)[32])malloc(32 * (size_t)max_found);
+        w->found_seeds = (int*)malloc(sizeof(int) * max_found);
+    }
+
+    int started = 0;
+    for (; started < num_threads; started++) {
+        if (!workers[started].found_hashes || !workers[started].found_names ||
+            !workers[started].found_seeds) break;
+        if (!fnv_thread_start(&threads[started], mutation_worker, &workers[started])) break;
+    }
+    for (int t = 0; t < started; t++) fnv_thread_join(threads[t]);
+
+    /* merge per-thread results (deduplicated) */
+    MatchIndex seen = {0};
+    if (tested) *tested = 0;
+    for (int t = 0; t < num_threads; t++) {
+        MutationWorker* w = &workers[t];
+        for (int i = 0; i < w->found; i++) {
+            found = record_unique_match(w->found_hashes[i], w->found_names[i], w->found_seeds[i],
+                                        found_hashes, found_names, found_seeds, found, max_found, &seen);
+        }
+        if (tested) *tested += w->tested;
+        match_index_free(&w->seen);
+        free(w->found_hashes);
+        free(w->found_names);
+        free(w->found_seeds);
+    }
+    match_index_free(&seen);
+
+    free(workers);
+    free(sorted);
+    return found;
+}
+
+/* ============================================================================
+ * CROSS-BANK TEMPLATE TRANSPLANT
+ * legolas_sa1 / gandalf_sa2 / frodo_sa3: a template carries across banks
+ * when its subject token changes.  Every cracked name is scanned for subject
+ * aliases (heroes, creatures, level prefixes like isen/helms/pf, matched on
+ * '_' boundaries, multi-token aliases allowed); each occurrence becomes a
+ * one-slot template "prefix{class}suffix".  Templates are compiled with the
+ * prefix state pre-hashed and deduplicated, then instantiated with every
+ * alias of the slot class.
+ * ============================================================================ */
+
+#define TRANSPLANT_MAX_CLASSES 16
+
+typedef struct {
+    uint32_t prefix_state;      /* hash of prefix (incl. trailing '_') */
+    int cls;                    /* subject class of the slot */
+    int seed;                   /* cracked name the template came from */
+    char prefix[32];
+    char suffix[32];            /* text after the slot (incl. leading '_') */
+} TransplantTemplate;
+
+static int transplant_template_compare(const void* a, const void* b) {
+    const TransplantTemplate* x = (const TransplantTemplate*)a;
+    const TransplantTemplate* y = (const TransplantTemplate*)b;
+    if (x->cls != y->cls) return x->cls - y->cls;
+    int c = strcmp(x->prefix, y->prefix);
+    return c ? c : strcmp(x->suffix, y->suffix);
+}
+
+/* Alias matches name at pos and ends on a token boundary */
+static int transplant_alias_at(const char* name, int pos, const char* alias, int alias_len) {
+    if (pos > 0 && name[pos - 1] != '_') return 0;
+    if (strncmp(name + pos, alias, alias_len) != 0) return 0;
+    return name[pos + alias_len] == '\0' || name[pos + alias_len] == '_';
+}
+
+/*
+ * Extract and compile one-slot templates into *templates (grown as
+ * needed, *capacity tracks its size); returns template count, or -1 when
+ * the array cannot grow.
+ */
+static int transplant_extract(
+    const char** cracked, int cracked_count,
+    const char** aliases, const int* alias_classes, int alias_count,
+    TransplantTemplate** templates, int* capacity
+) {
+    char name[32];
+    int count = 0;
+
+    for (int n = 0; n < cracked_count; n++) {
+        int len = 0;
+        for (const char* p = cracked[n]; *p && len < 31; p++) name[len++] = (char)tolower(*p);
+        name[len] = '\0';
+
+        for (int a = 0; a < alias_count; a++) {
+            int alias_len = (int)strlen(aliases[a]);
+            if (alias_len == 0 || alias_len > len) continue;
+            if (alias_classes[a] < 0 || alias_classes[a] >= TRANSPLANT_MAX_CLASSES) continue;
+
+            for (int pos = 0; pos + alias_len <= len; pos++) {
+                if (!transplant_alias_at(name, pos, aliases[a], alias_len)) continue;
+
+                if (count == *capacity) {
+                    TransplantTemplate* grown = (TransplantTemplate*)realloc(
+                        *templates, sizeof(TransplantTemplate) * (size_t)*capacity * 2);
+                    if (!grown) return -1;
+                    *templates = grown;
+                    *capacity *= 2;
+                }
+                TransplantTemplate* t = &(*templates)[count++];
+                memcpy(t->prefix, name, pos);
+                t->prefix[pos] = '\0';
+                strcpy(t->suffix, name + pos + alias_len);
+                t->cls = alias_classes[a];
+                t->seed = n;
+                t->prefix_state = wwise_hash(t->prefix);
+            }
+        }
+    }
+
+    /* dedupe templates that several cracked names share */
+    TransplantTemplate* list = *templates;
+    qsort(list, count, sizeof(TransplantTemplate), transplant_template_compare);
+    int unique = 0;
+    for (int i = 0; i < count; i++) {
+        if (unique > 0 && transplant_template_compare(&list[unique - 1], &list[i]) == 0) continue;
+        list[unique++] = list[i];
+    }
+    return unique;
+}
+
+/*
+ * Transplant every template onto every alias of its slot class.
+ * aliases/alias_classes is the subject table (class ids 0..15, several
+ * aliases per subject: "isen", "isengard").  found_seeds[i] is the cracked
+ * name hit i was transplanted from.  Optional out-params report the
+ * compiled template count (-1: out of memory) and instantiations tested.
+ */
+EXPORT int transplant_search(
+    const char** cracked,
+    int cracked_count,
+    const char** aliases,
+    const int* alias_classes,
+    int alias_count,
+    const uint32_t* targets,
+    int target_count,
+    uint32_t* found_hashes,
+    char (*found_names)[32],
+    int* found_seeds,
+    int max_found,
+    int* template_count,
+    uint64_t* tested
+) {
+    /* per-class alias lists: contiguous char pool + offsets */
+    int class_start[TRANSPLANT_MAX_CLASSES + 1] = {0};
+    int* alias_order = (int*)malloc(sizeof(int) * (alias_count ? alias_count : 1));
+    int max_templates = cracked_count * 4 + 16;
+    TransplantTemplate* templates = (TransplantTemplate*)malloc(sizeof(TransplantTemplate) * max_templates);
+    uint32_t* sorted = sorted_targets_copy(targets, target_count);
+    char name[64];
+    uint64_t count_tested = 0;
+    int found = 0;
+    MatchIndex seen = {0};
+
+    if (!alias_order || !templates || !sorted) {
+        free(alias_order);
+        free(templates);
+        free(sorted);
+        return 0;
+    }
+
+    for (int a = 0; a < alias_count; a++) {
+        if (alias_classes[a] >= 0 && alias_classes[a] < TRANSPLANT_MAX_CLASSES)
+            class_start[alias_classes[a] + 1]++;
+    }
+    for (int c = 0; c < TRANSPLANT_MAX_CLASSES; c++) class_start[c + 1] += class_start[c];
+    {
+        int fill[TRANSPLANT_MAX_CLASSES];
+        memcpy(fill, class_start, sizeof(fill));
+        for (int a = 0; a < alias_count; a++) {
+            if (alias_classes[a] >= 0 && alias_classes[a] < TRANSPLANT_MAX_CLASSES)
+                alias_order[fill[alias_classes[a]]++] = a;
+        }
+    }
+
+    int n_templates = transplant_extract(cracked, cracked_count, aliases, alias_classes,
+                                         alias_count, &templates, &max_templates);
+    if (template_count) *template_count = n_templates;
+
+    for (int t = 0; t < n_templates && found < max_found; t++) {
+        const TransplantTemplate* tp = &templates[t];
+        int prefix_len = (int)strlen(tp->prefix);
+
+        for (int k = class_start[tp->cls]; k < class_start[tp->cls + 1]; k++) {
+            const char* alias = aliases[alias_order[k]];
+            uint32_t h = tp->prefix_state;
+            for (const char* p = alias; *p; p++) h = (h * FNV_PRIME) ^ (uint8_t)tolower(*p);
+            for (const char* p = tp->suffix; *p; p++) h = (h * FNV_PRIME) ^ (uint8_t)*p;
+            count_tested++;
+
+            if (!is_target(h, sorted, target_count)) continue;
+            int len = snprintf(name, sizeof(name), "%s%s%s", tp->prefix, alias, tp->suffix);
+            if (len > 31 || prefix_len + (int)strlen(alias) > 31) continue;
+            for (int i = 0; i < len; i++) name[i] = (char)tolower(name[i]);
+            found = record_unique_match(h, name, tp->seed, found_hashes, found_names,
+                                        found_seeds, found, max_found, &seen);
+        }
+    }
+
+    if (tested) *tested = count_tested;
+    match_index_free(&seen);
+    free(alias_order);
+    free(templates);
+    free(sorted);
+    return found;
+}
+
+/* ============================================================================
+ * ABBREVIATION / ALIAS EXPANSION
+ * Names use truncations and acronyms (isen_ = Isengard, oli_ = Oliphaunt,
+ * pf_ = Pelennor Fields, helms_) while the dictionary holds full tokens.
+ * Every term ("isengard", "pelennor_fields") is expanded into:
+ *   - prefix truncations       isengard -> isen, ise, iseng ...
+ *   - vowel-dropped forms      isengard -> isngrd
+ *   - consonant skeletons      oliphaunt -> lphnt
+ *   - initialisms / head token pelennor_fields -> pf, pelennor
+ * Each form gets a plausibility weight (0-1000) and its FNV state, and the
+ * set is returned as a compact weighted vocabulary: one sorted AliasForm
+ * array plus a shared char pool, ready for the combinator/rule engines.
+ * ============================================================================ */
+
+typedef struct {
+    uint32_t state;     /* wwise_hash of the form (usable as a prefix state) */
+    uint32_t offset;    /* into the caller's char pool (NUL-terminated) */
+    uint16_t len;
+    uint16_t weight;    /* plausibility, higher = more likely */
+    int32_t term;       /* index of the source term */
+} AliasForm;
+
+#define ALIAS_KIND_INITIALISM   900
+#define ALIAS_KIND_HEAD_TOKEN   850
+#define ALIAS_KIND_TRUNCATION   700
+#define ALIAS_KIND_VOWEL_DROP   500
+#define ALIAS_KIND_SKELETON     400
+
+static int is_vowel(char c) {
+    return c == 'a' || c == 'e' || c == 'i' || c == 'o' || c == 'u';
+}
+
+typedef struct {
+    AliasForm* forms;
+    int count;
+    int max_forms;
+    char* pool;
+    int pool_used;
+    int pool_size;
+} AliasBuilder;
+
+static void alias_emit(AliasBuilder* b, const char* form, int len, int weight, int term) {
+    if (len < 2 || len > 31 || b->count >= b->max_forms) return;
+    if (b->pool_used + len + 1 > b->pool_size) return;
+    if (weight < 1) weight = 1;
+    if (weight > 1000) weight = 1000;
+
+    AliasForm* f = &b->forms[b->count++];
+    f->offset = (uint32_t)b->pool_used;
+    f->len = (uint16_t)len;
+    f->weight = (uint16_t)weight;
+    f->term = term;
+    f->state = wwise_hash_len(form, len);
+    memcpy(b->pool + b->pool_used, form, len);
+    b->pool[b->pool_used + len] = '\0';
+    b->pool_used += len + 1;
+}
+
+/* Drop vowels after the first char (keep_first) or everywhere; collapse doubles */
+static int alias_strip_vowels(const char* src, int len, char* dst, int keep_first, int collapse) {
+    int n = 0;
+    for (int i = 0; i < len; i++) {
+        char c = src[i];
+        int token_start = (i == 0 || src[i - 1] == '_');
+        if (is_vowel(c) && !(keep_first && token_start)) continue;
+        if (collapse && n > 0 && dst[n - 1] == c) continue;
+        dst[n++] = c;
+    }
+    dst[n] = '\0';
+    return n;
+}
+
+/* Lowercase a term and map ' '/'-' to '_' (the form alphabet); returns length */
+static int alias_normalize(const char* raw, char t[64]) {
+    int len = 0;
+    for (const char* p = raw; *p && len < 63; p++) {
+        t[len] = (char)tolower(*p);
+        if (t[len] == ' ' || t[len] == '-') t[len] = '_';
+        len++;
+    }
+    t[len] = '\0';
+    return len;
+}
+
+static void alias_expand_term(AliasBuilder* b, const char* raw, int term, int min_len) {
+    char t[64], form[64];
+    int len = alias_normalize(raw, t), words = 1;
+    for (int i = 0; i < len; i++) words += t[i] == '_';
+    if (len < 2) return;
+
+    /* initialism + head token for multi-word names */
+    if (words > 1) {
+        int n = 0, head = -1;
+        for (int i = 0; i < len; i++) {
+            if (t[i] == '_') {
+                if (head < 0) head = i;
+                continue;
+            }
+            if (i == 0 || t[i - 1] == '_') form[n++] = t[i];
+        }
+        alias_emit(b, form, n, ALIAS_KIND_INITIALISM - (n > 3 ? 100 : 0), term);
+        if (head >= min_len) alias_emit(b, t, head, ALIAS_KIND_HEAD_TOKEN, term);
+    }
+
+    /* prefix truncations of the leading token, best around 3-5 chars */
+    int first_len = 0;
+    while (first_len < len && t[first_len] != '_') first_len++;
+    for (int k = min_len; k < first_len; k++) {
+        int w = ALIAS_KIND_TRUNCATION - 60 * abs(k - 4);
+        if (!is_vowel(t[k])) w += 50;       /* cut before a consonant: isen|gard, oli|phaunt */
+        if (t[k] == 'h') w -= 100;          /* splits ph/th/sh/ch */
+        if (k <= 2) w -= 200;
+        alias_emit(b, t, k, w, term);
+    }
+
+    /* vowel-dropped and consonant skeleton of the whole term */
+    int n = alias_strip_vowels(t, len, form, 1, 0);
+    if (n != len && n >= min_len) alias_emit(b, form, n, ALIAS_KIND_VOWEL_DROP - (n <= 2 ? 200 : 0), term);
+    int m = alias_strip_vowels(t, len, form, 0, 1);
+    if (m != len && m != n && m >= min_len) alias_emit(b, form, m, ALIAS_KIND_SKELETON - (m <= 2 ? 200 : 0), term);
+}
+
+static int string_row_compare(const void* a, const void* b) {
+    return strcmp((const char*)a, (const char*)b);
+}
+
+/* Sort record carrying its own text pointer, so no shared sort context */
+typedef struct {
+    const char* text;
+    AliasForm form;
+} AliasSortRecord;
+
+static int alias_form_compare(const void* a, const void* b) {
+    const AliasSortRecord* x = (const AliasSortRecord*)a;
+    const AliasSortRecord* y = (const AliasSortRecord*)b;
+    int c = strcmp(x->text, y->text);
+    if (c) return c;
+    return (int)y->form.weight - (int)x->form.weight;
+}
+
+static int alias_weight_compare(const void* a, const void* b) {
+    const AliasSortRecord* x = (const AliasSortRecord*)a;
+    const AliasSortRecord* y = (const AliasSortRecord*)b;
+    if (x->form.weight != y->form.weight) return (int)y->form.weight - (int)x->form.weight;
+    return strcmp(x->text, y->text);
+}
+
+/* qsort forms through records; returns 0 when the scratch cannot be allocated */
+static int alias_sort_forms(AliasForm* forms, int count, const char* pool,
+                            int (*compare)(const void*, const void*)) {
+    AliasSortRecord* records = (AliasSortRecord*)malloc(sizeof(AliasSortRecord) * (size_t)(count > 0 ? count : 1));
+    if (!records) return 0;
+    for (int i = 0; i < count; i++) {
+        records[i].text = pool + forms[i].offset;
+        records[i].form = forms[i];
+    }
+    qsort(records, count, sizeof(AliasSortRecord), compare);
+    for (int i = 0; i < count; i++) forms[i] = records[i].form;
+    free(records);
+    return 1;
+}
+
+/*
+ * Expand every term into weighted abbreviation forms.  Identical forms
+ * from different terms keep their highest weight; forms equal to a source
+ * term (compared after normalization) are dropped.  Output is sorted by
+ * descending weight.  Returns the number of forms (0 when out of memory);
+ * pool receives the NUL-terminated strings.
+ */
+EXPORT int alias_expand(
+    const char** terms,
+    int term_count,
+    int min_len,
+    char* pool,
+    int pool_size,
+    AliasForm* forms,
+    int max_forms
+) {
+    AliasBuilder b = { forms, 0, max_forms, pool, 0, pool_size };
+    if (min_len < 2) min_len = 2;
+
+    for (int i = 0; i < term_count; i++) alias_expand_term(&b, terms[i], i, min_len);
+
+    /* dedupe on text, keeping the highest weight */
+    if (!alias_sort_forms(forms, b.count, pool, alias_form_compare)) return 0;
+    int unique = 0;
+    for (int i = 0; i < b.count; i++) {
+        if (unique > 0 && strcmp(pool + forms[unique - 1].offset, pool + forms[i].offset) == 0) continue;
+        forms[unique++] = forms[i];
+    }
+
+    /* drop forms that are themselves full terms, in the forms' own alphabet */
+    char (*sorted_terms)[64] = (char (*)[64])malloc(sizeof(*sorted_terms) * (size_t)(term_count > 0 ? term_count : 1));
+    int kept = 0;
+    if (sorted_terms) {
+        for (int i = 0; i < term_count; i++) alias_normalize(terms[i], sorted_terms[i]);
+        qsort(sorted_terms, term_count, sizeof(*sorted_terms), string_row_compare);
+    }
+    for (int i = 0; i < unique; i++) {
+        const char* key = pool + forms[i].offset;
+        if (sorted_terms && bsearch(key, sorted_terms, term_count, sizeof(*sorted_terms), string_row_compare)) continue;
+        forms[kept++] = forms[i];
+    }
+    free(sorted_terms);
+
+    if (!alias_sort_forms(forms, kept, pool, alias_weight_compare)) return 0;
+    return kept;
+}
+
+/* ============================================================================
+ * TEMPLATED SANDWICH MITM
+ * Patterns LIT1 ?{m} LIT2 ("saruman_??????_01", "play_amb_?????_loop"):
+ * LIT1 is hashed forward once, LIT2 is inverted out of every target, and
+ * the unknown middle is split in two:
+ *   forward table  = every LIT1 + first-half state (m1 chars), bucketed
+ *   probe side     = every target, inverse-hashed through each second half
+ * Cost per template is 37^m1 + targets * 37^m2 instead of targets * 37^m;
+ * m1 is chosen as large as the table memory cap allows.  Note a 10-char
+ * middle still carries 37^10 * targets / 2^32 expected collisions, so
+ * keep charsets tight and route small target subsets at long middles.
+ * ============================================================================ */
+
+#define SANDWICH_MAX_MIDDLE 14
+#define SANDWICH_DEFAULT_TABLE (1 << 27)
+
+typedef struct {
+    uint32_t* states;       /* forward states, bucket-sorted */
+    uint32_t* indices;      /* mixed-radix index of the first half */
+    uint32_t* buckets;      /* bucket b = [buckets[b - lo], buckets[b - lo + 1]) */
+    int bucket_shift;
+    uint32_t count;
+    uint32_t bucket_lo;     /* buckets held: [bucket_lo, bucket_hi) */
+    uint32_t bucket_hi;
+} SandwichTable;
+
+static void sandwich_table_free(SandwichTable* t) {
+    free(t->states);
+    free(t->indices);
+    free(t->buckets);
+    memset(t, 0, sizeof(*t));
+}
+
+/* Enumerate every m1-char first half from base_state, counting-sort by top bits */
+static int sandwich_table_build(SandwichTable* t, uint32_t base_state,
+                                const char* charset, int charset_len, int m1) {
+    uint64_t n = 1;
+    for (int i = 0; i < m1; i++) n *= charset_len;
+
+    int bits = 8;
+    while (bits < 26 && ((uint64_t)1 << bits) < n) bits++;
+    uint32_t nb = 1u << bits;
+
+    memset(t, 0, sizeof(*t));
+    t->count = (uint32_t)n;
+    t->bucket_shift = 32 - bits;
+    t->bucket_hi = nb;
+    t->states = (uint32_t*)malloc(sizeof(uint32_t) * n);
+    t->indices = (uint32_t*)malloc(sizeof(uint32_t) * n);
+    t->buckets = (uint32_t*)calloc(nb + 1, sizeof(uint32_t));
+    uint32_t* raw = (uint32_t*)malloc(sizeof(uint32_t) * n);
+    if (!t->states || !t->indices || !t->buckets || !raw) {
+        free(raw);
+        sandwich_table_free(t);
+        return 0;
+    }
+
+    /* odometer with cached states; index = sum(digit[i] * r^(m1-1-i)) */
+    uint32_t states[SANDWICH_MAX_MIDDLE + 1];
+    int idx[SANDWICH_MAX_MIDDLE];
+    states[0] = base_state;
+    for (int i = 0; i < m1; i++) {
+        idx[i] = 0;
+        states[i + 1] = (states[i] * FNV_PRIME) ^ (uint8_t)charset[0];
+    }
+    for (uint64_t k = 0; k < n; k++) {
+        raw[k] = states[m1];
+        t->buckets[(states[m1] >> t->bucket_shift) + 1]++;
+
+        int pos = m1 - 1;
+        while (pos >= 0 && ++idx[pos] >= charset_len) idx[pos--] = 0;
+        if (pos < 0) break;
+        for (int i = pos; i < m1; i++) {
+            states[i + 1] = (states[i] * FNV_PRIME) ^ (uint8_t)charset[idx[i]];
+        }
+    }
+
+    for (uint32_t b = 0; b < nb; b++) t->buckets[b + 1] += t->buckets[b];
+    {
+        uint32_t* fill = (uint32_t*)malloc(sizeof(uint32_t) * nb);
+        if (!fill) {
+            free(raw);
+            sandwich_table_free(t);
+            return 0;
+        }
+        memcpy(fill, t->buckets, sizeof(uint32_t) * nb);
+        for (uint64_t k = 0; k < n; k++) {
+            uint32_t slot = fill[raw[k] >> t->bucket_shift]++;
+            t->states[slot] = raw[k];
+            t->indices[slot] = (uint32_t)k;
+        }
+        free(fill);
+    }
+
+    free(raw);
+    return 1;
+}
+
+/*
+ * NUMA partition: node k keeps buckets [k*nb/N, (k+1)*nb/N) of the forward
+ * table in its own memory.  Every node's workers enumerate every target's
+ * second halves (cheap multiply chains) but only look up states that fall
+ * in their slice, so all the random table probes stay node-local.
+ */
+typedef struct {
+    const SandwichTable* src;
+    SandwichTable* dst;
+    uint32_t lo, hi;
+    int worker;
+    int ok;
+} SandwichSlice;
+
+THREAD_FUNC(sandwich_slice_worker, arg) {
+    SandwichSlice* job = (SandwichSlice*)arg;
+    const SandwichTable* src = job->src;
+    SandwichTable* dst = job->dst;
+    uint32_t first = src->buckets[job->lo], last = src->buckets[job->hi];
+
+    numa_pin_worker(job->worker);
+    memset(dst, 0, sizeof(*dst));
+    dst->bucket_shift = src->bucket_shift;
+    dst->bucket_lo = job->lo;
+    dst->bucket_hi = job->hi;
+    dst->count = last - first;
+    dst->states = (uint32_t*)malloc(sizeof(uint32_t) * (dst->count ? dst->count : 1));
+    dst->indices = (uint32_t*)malloc(sizeof(uint32_t) * (dst->count ? dst->count : 1));
+    dst->buckets = (uint32_t*)malloc(sizeof(uint32_t) * (job->hi - job->lo + 1));
+    job->ok = dst->states && dst->indices && dst->buckets;
+    if (job->ok) {
+        memcpy(dst->states, src->states + first, sizeof(uint32_t) * dst->count);
+        memcpy(dst->indices, src->indices + first, sizeof(uint32_t) * dst->count);
+        for (uint32_t b = job->lo; b <= job->hi; b++) dst->buckets[b - job->lo] = src->buckets[b] - first;
+    }
+    THREAD_RETURN;
+}
+
+/*
+ * Split a built table into one slice per pool node (node_list[k] gets
+ * slice k, written by a thread pinned to that node).  Returns the part
+ * count; 1 means `parts[0]` is the unsplit table.  The source table is
+ * moved or freed either way.
+ */
+static int sandwich_table_partition(SandwichTable* table, SandwichTable* parts, const int* node_list, int nodes) {
+    SandwichSlice slices[NUMA_MAX_NODES];
+    fnv_thread_t threads[NUMA_MAX_NODES];
+    uint32_t nb = table->bucket_hi;
+    int started = 0, ok = 1;
+
+    if (nodes > 1) {
+        for (; started < nodes; started++) {
+            SandwichSlice* sl = &slices[started];
+            sl->src = table;
+            sl->dst = &parts[started];
+            sl->lo = (uint32_t)((uint64_t)nb * started / nodes);
+            sl->hi = (uint32_t)((uint64_t)nb * (started + 1) / nodes);
+            sl->worker = numa_node_first_worker(node_list[started]);
+            sl->ok = 0;
+            if (!fnv_thread_start(&threads[started], sandwich_slice_worker, sl)) break;
+        }
+        for (int i = 0; i < started; i++) {
+            fnv_thread_join(threads[i]);
+            ok = ok && slices[i].ok;
+        }
+        if (started == nodes && ok) {
+            sandwich_table_free(table);
+            return nodes;
+        }
+        for (int i = 0; i < started; i++) sandwich_table_free(&parts[i]);
+    }
+    parts[0] = *table;
+    memset(table, 0, sizeof(*table));
+    return 1;
+}
+
+typedef struct {
+    /* shared */
+    const SandwichTable* table;
+    const char* lit1;
+    const char* lit2;
+    const char* charset;
+    int charset_len;
+    int m1, m2;
+    const uint32_t* targets;
+    int target_count;
+    volatile long* next_target;
+
+    /* per-thread */
+    int index;              /* pool position (NUMA placement) */
+    uint32_t* found_hashes;
+    char (*found_names)[32];
+    int found;
+    int max_found;
+    MatchIndex seen;
+    uint64_t tested;
+} SandwichWorker;
+
+static void sandwich_emit(SandwichWorker* w, uint32_t target, uint32_t fwd_index, const int* back) {
+    char name[64];
+    int len = (int)strlen(w->lit1);
+    if (len + w->m1 + w->m2 + (int)strlen(w->lit2) > 31) return;
+
+    memcpy(name, w->lit1, len);
+    for (int i = w->m1 - 1; i >= 0; i--) {
+        name[len + i] = w->charset[fwd_index % w->charset_len];
+        fwd_index /= w->charset_len;
+    }
+    len += w->m1;
+    for (int i = 0; i < w->m2; i++) name[len++] = w->charset[back[i]];
+    strcpy(name + len, w->lit2);
+    for (char* p = name; *p; p++) *p = (char)tolower(*p);
+
+    if (!(name[0] >= 'a' && name[0] <= 'z')) return;
+    if (wwise_hash(name) != target) return;        /* verify */
+    w->found = record_unique_match(target, name, -1, w->found_hashes, w->found_names,
+                                   NULL, w->found, w->max_found, &w->seen);
+}
+
+THREAD_FUNC(sandwich_worker, arg) {
+    SandwichWorker* w = (SandwichWorker*)arg;
+    const SandwichTable* t = w->table;
+    int lit2_len = (int)strlen(w->lit2);
+    uint32_t inv[SANDWICH_MAX_MIDDLE + 1];
+    int back[SANDWICH_MAX_MIDDLE];
+
+    numa_pin_worker(w->index);
+    for (;;) {
+        long ti = ATOMIC_FETCH_ADD(w->next_target, 1);
+        if (ti >= w->target_count || w->found >= w->max_found) break;
+
+        uint32_t target = w->targets[ti];
+        int m2 = w->m2;
+
+        /* inv[i] = state needed before back[i..m2) + LIT2; back[0] varies fastest */
+        inv[m2] = wwise_hash_inverse(target, w->lit2, lit2_len);
+        for (int i = m2 - 1; i >= 0; i--) {
+            back[i] = 0;
+            inv[i] = (inv[i + 1] ^ (uint8_t)w->charset[0]) * FNV_INVERSE;
+        }
+
+        for (;;) {
+            uint32_t need = inv[0];
+            uint32_t b = need >> t->bucket_shift;
+            if (b >= t->bucket_lo && b < t->bucket_hi) {
+                const uint32_t* bucket = t->buckets + (b - t->bucket_lo);
+                for (uint32_t k = bucket[0]; k < bucket[1]; k++) {
+                    if (t->states[k] == need) sandwich_emit(w, target, t->indices[k], back);
+                }
+                w->tested++;
+            }
+
+            int pos = 0;
+            while (pos < m2 && ++back[pos] >= w->charset_len) back[pos++] = 0;
+            if (pos >= m2) break;
+            for (int i = pos; i >= 0; i--) {
+                inv[i] = (inv[i + 1] ^ (uint8_t)w->charset[back[i]]) * FNV_INVERSE;
+            }
+        }
+    }
+    THREAD_RETURN;
+}
+
+/*
+ * Probe one template against a built forward table (threaded over
+ * targets).  Worker i takes slot `slot + i`; with parts > 1 the workers on
+ * node_list[k] sweep every target against slice k.
+ */
+static int sandwich_probe(
+    const SandwichTable* tables, int parts, const int* node_list, int slot,
+    const char* lit1, const char* lit2,
+    const char* charset, int charset_len, int m1, int m2,
+    const uint32_t* targets, int target_count, int num_threads,
+    uint32_t* found_hashes, char (*found_names)[32], int found, int max_found,
+    MatchIndex* seen, uint64_t* tested
+) {
+    fnv_thread_t threads[MAX_THREADS];
+    SandwichWorker workers[MAX_THREADS];
+    volatile long next_target[NUMA_MAX_NODES] = { 0 };
+
+    for (int i = 0; i < num_threads; i++) {
+        SandwichWorker* w = &workers[i];
+        int part = 0;
+        while (parts > 1 && part < parts - 1 && node_list[part] != numa_worker_node(slot + i)) part++;
+        memset(w, 0, sizeof(*w));
+        w->index = slot + i;
+        w->table = &tables[part];
+        w->lit1 = lit1;
+        w->lit2 = lit2;
+        w->charset = charset;
+        w->charset_len = charset_len;
+        w->m1 = m1;
+        w->m2 = m2;
+        w->targets = targets;
+        w->target_count = target_count;
+        w->next_target = &next_target[part];
+        w->max_found = max_found - found;
+        w->found_hashes = (uint32_t*)malloc(sizeof(uint32_t) * (w->max_found + 1));
+        w->found_names = (char (*)[32])malloc(32 * (size_t)(w->max_found + 1));
+    }
+
+    int started = 0;
+    for (; started < num_threads; started++) {
+        if (!workers[started].found_hashes || !workers[started].found_names) break;
+        if (!fnv_thread_start(&threads[started], sandwich_worker, &workers[started])) break;
+    }
+    for (int i = 0; i < started; i++) fnv_thread_join(threads[i]);
+
+    for (int i = 0; i < num_threads; i++) {
+        for (int k = 0; k < workers[i].found; k++) {
+            found = record_unique_match(workers[i].found_hashes[k], workers[i].found_names[k], -1,
+                                        found_hashes, found_names, NULL, found, max_found, seen);
+        }
+        if (tested) *tested += workers[i].tested;
+        match_index_free(&workers[i].seen);
+        free(workers[i].found_hashes);
+        free(workers[i].found_names);
+    }
+    return found;
+}
+
+/*
+ * Run a batch of sandwich templates lit1s[i] ?{middle_lens[i]} lit2s[i].
+ * Consecutive templates with the same LIT1 and split reuse the forward
+ * table, so callers should sort templates by LIT1.  charset NULL means
+ * CHARSET_REST; max_table_entries caps the forward table (0 = 2^27).
+ * found_templates[i] (optional) is the template index of hit i.
+ */
+EXPORT int sandwich_mitm_batch(
+    const char** lit1s,
+    const char** lit2s,
+    const int* middle_lens,
+    int template_count,
+    const char* charset,
+    int max_table_entries,
+    const uint32_t* targets,
+    int target_count,
+    int num_threads,
+    uint32_t* found_hashes,
+    char (*found_names)[32],
+    int* found_templates,
+    int max_found,
+    uint64_t* tested
+) {
+    SandwichTable table, parts[NUMA_MAX_NODES];
+    int node_list[NUMA_MAX_NODES];
+    const char* table_lit1 = NULL;
+    int table_m1 = -1, part_count = 0;
+    int found = 0;
+    MatchIndex seen = {0};
+
+    if (!charset || !*charset) charset = CHARSET_REST;
+    int charset_len = (int)strlen(charset);
+    if (max_table_entries <= 0) max_table_entries = SANDWICH_DEFAULT_TABLE;
+    num_threads = resolve_thread_count(num_threads);
+    int slot = numa_reserve_slots(num_threads);
+    int nodes = numa_pool_node_list(slot, num_threads, node_list);
+    memset(&table, 0, sizeof(table));
+    if (tested) *tested = 0;
+
+    for (int t = 0; t < template_count && found < max_found; t++) {
+        int m = middle_lens[t];
+        if (m < 1 || m > SANDWICH_MAX_MIDDLE) continue;
+
+        /* largest forward half that fits the table cap, at most m - 1 */
+        int m1 = 0;
+        uint64_t size = 1;
+        while (m1 < m - 1 && size * charset_len <= (uint64_t)max_table_entries) {
+            size *= charset_len;
+            m1++;
+        }
+        if (m1 > (m + 1) / 2 + 2) m1 = (m + 1) / 2 + 2;  /* balance against targets * 37^m2 */
+        int m2 = m - m1;
+
+        if (!table_lit1 || strcmp(table_lit1, lit1s[t]) != 0 || table_m1 != m1) {
+            for (int i = 0; i < part_count; i++) sandwich_table_free(&parts[i]);
+            part_count = 0;
+            table_lit1 = NULL;
+            if (!sandwich_table_build(&table, wwise_hash(lit1s[t]), charset, charset_len, m1)) break;
+            part_count = sandwich_table_partition(&table, parts, node_list, nodes);
+            table_lit1 = lit1s[t];
+            table_m1 = m1;
+        }
+
+        int before = found;
+        found = sandwich_probe(parts, part_count, node_list, slot, lit1s[t], lit2s[t], charset, charset_len, m1, m2,
+                               targets, target_count, num_threads,
+                               found_hashes, found_names, found, max_found, &seen, tested);
+        for (int i = before; i < found && found_templates; i++) found_templates[i] = t;
+    }
+
+    for (int i = 0; i < part_count; i++) sandwich_table_free(&parts[i]);
+    match_index_free(&seen);
+    return found;
+}
+
+/* Single-template convenience wrapper */
+EXPORT int sandwich_mitm_search(
+    const char* lit1,
+    const char* lit2,
+    int middle_len,
+    const char* charset,
+    int max_table_entries,
+    const uint32_t* targets,
+    int target_count,
+    int num_threads,
+    uint32_t* found_hashes,
+    char (*found_names)[32],
+    int max_found,
+    uint64_t* tested
+) {
+    return sandwich_mitm_batch(&lit1, &lit2, &middle_len, 1, charset, max_table_entries,
+                               targets, target_count, num_threads,
+                               found_hashes, found_names, NULL, max_found, tested);
+}
+
+/* ============================================================================
+ * LATTICE (LLL) PREIMAGE FINDER  (experimental)
+ * FNV-1 XOR steps are "almost additive": (m ^ c) = m + d with |d| <= 127
+ * for 7-bit c.  Over an unknown span of n chars starting at state s:
+ *     h_n = s * P^n + sum d_i * P^(n-1-i)      (mod 2^32)
+ * so a preimage is a small vector d solving one modular linear equation.
+ * The equation is embedded in a (n+2)-dim lattice (Kannan embedding),
+ * LLL-reduced in-tree (int64 basis, exact __int128 Gram products,
+ * long double Gram-Schmidt, overflow-checked updates), and every solution within a radius of the origin is enumerated over the
+ * reduced kernel basis (Schnorr-Euchner).  Each d is turned back into chars position by position
+ * (c_i = (m_i + d_i) ^ m_i) and must land in the charset / known char at
+ * that position; survivors are verified with wwise_hash.
+ *
+ * Patterns mark unknown chars with '?': "pf_siege_tower_??????_hit".
+ * Known prefix is hashed forward and known suffix inverted from the
+ * target; known chars between unknowns stay lattice variables that must
+ * reproduce the fixed char.  Real names' deltas are NOT short (|d| is
+ * spread over [-127,127]); per-candidate validity is roughly
+ * (37/256)^span, so yields depend on radius and candidate budget.
+ * ============================================================================ */
+
+#define LATTICE_MAX_DIM 34
+#define LATTICE_WEIGHT ((int64_t)1 << 16)
+#define LATTICE_EMBED 64
+#define LATTICE_ENTRY_MAX ((int64_t)1 << 62)   /* basis entries stay below this */
+
+typedef struct {
+    int dim;                                    /* rows == cols */
+    int64_t b[LATTICE_MAX_DIM][LATTICE_MAX_DIM];
+} Lattice;
+
+/*
+ * Exact dot product.  Entries start near 2^48 (WEIGHT * 2^32), so the
+ * products need 128 bits; the sum is rounded once into long double.
+ */
+static long double lattice_dot(const int64_t* x, const int64_t* y, int n) {
+    __int128 s = 0;
+    for (int i = 0; i < n; i++) s += (__int128)x[i] * y[i];
+    return (long double)s;
+}
+
+/*
+ * Gram-Schmidt of the current basis from exact Gram products: mu
+ * coefficients and squared norms of the b* rows.  With t != NULL also
+ * projects t onto each b* (tau[j] = <t, b*_j> / |b*_j|^2).
+ */
+static void lattice_gram_schmidt(const Lattice* L, long double mu[][LATTICE_MAX_DIM],
+                                 long double* norm, const int64_t* t, long double* tau) {
+    long double r[LATTICE_MAX_DIM][LATTICE_MAX_DIM];
+    int n = L->dim;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j <= i; j++) {
+            long double v = lattice_dot(L->b[i], L->b[j], n);
+            for (int k = 0; k < j; k++) v -= mu[j][k] * r[i][k];
+            r[i][j] = v;
+            if (j < i) mu[i][j] = norm[j] > 0 ? v / norm[j] : 0.0L;
+        }
+        norm[i] = r[i][i];
+    }
+    if (!t) return;
+    long double rt[LATTICE_MAX_DIM];
+    for (int j = 0; j < n; j++) {
+        long double v = lattice_dot(t, L->b[j], n);
+        for (int k = 0; k < j; k++) v -= mu[j][k] * rt[k];
+        rt[j] = v;
+        tau[j] = norm[j] > 0 ? v / norm[j] : 0.0L;
+    }
+}
+
+/* b_k -= q * b_j, refusing (returns 0) if any entry would leave the int64 range */
+static int lattice_row_sub(Lattice* L, int k, int j, long double q) {
+    if (fabsl(q) >= (long double)LATTICE_ENTRY_MAX) return 0;
+    int64_t qi = (int64_t)q;
+    int64_t row[LATTICE_MAX_DIM];
+    for (int c = 0; c < L->dim; c++) {
+        __int128 v = (__int128)L->b[k][c] - (__int128)qi * L->b[j][c];
+        if (v >= LATTICE_ENTRY_MAX || v <= -LATTICE_ENTRY_MAX) return 0;
+        row[c] = (int64_t)v;
+    }
+    memcpy(L->b[k], row, sizeof(int64_t) * L->dim);
+    return 1;
+}
+
+/*
+ * Textbook LLL (delta = 0.99) with full GS recomputation; fine for dim <= 34.
+ * Returns 0 if a size reduction would overflow the int64 basis.
+ */
+static int lattice_lll(Lattice* L) {
+    static const long double delta = 0.99L;
+    long double mu[LATTICE_MAX_DIM][LATTICE_MAX_DIM];
+    long double norm[LATTICE_MAX_DIM];
+    int n = L->dim;
+    int k = 1;
+    int guard = 0;
+
+    lattice_gram_schmidt(L, mu, norm, NULL, NULL);
+    while (k < n && guard++ < 200000) {
+        /* size-reduce b_k against b_{k-1} .. b_0 */
+        for (int j = k - 1; j >= 0; j--) {
+            long double q = floorl(mu[k][j] + 0.5L);
+            if (q != 0.0L) {
+                if (!lattice_row_sub(L, k, j, q)) return 0;
+                for (int c = 0; c <= j; c++) mu[k][c] -= q * (c == j ? 1.0L : mu[j][c]);
+            }
+        }
+
+        if (norm[k] >= (delta - mu[k][k - 1] * mu[k][k - 1]) * norm[k - 1]) {
+            k++;
+        } else {
+            for (int c = 0; c < n; c++) {
+                int64_t t = L->b[k][c];
+                L->b[k][c] = L->b[k - 1][c];
+                L->b[k - 1][c] = t;
+            }
+            lattice_gram_schmidt(L, mu, norm, NULL, NULL);
+            if (k > 1) k--;
+        }
+    }
+    return 1;
+}
+
+/* Turn a delta vector back into chars; returns 1 if every position is valid */
+static int lattice_reconstruct(uint32_t state, const int64_t* d, int n,
+                               const char* span, char* out) {
+    uint32_t h = state;
+    for (int i = 0; i < n; i++) {
+        if (d[i] < -127 || d[i] > 127) return 0;
+        uint32_t m = h * FNV_PRIME;
+        uint32_t next = m + (uint32_t)(int32_t)d[i];
+        uint32_t c = next ^ m;
+        if (c > 0x7F) return 0;
+        if (span[i] == '?') {
+            if (!is_wwise_char((uint8_t)c)) return 0;
+        } else if ((char)c != (char)tolower(span[i])) {
+            return 0;
+        }
+        out[i] = (char)c;
+        h = next;
+    }
+    return 1;
+}
+
+typedef struct {
+    const char* prefix;
+    int prefix_len;
+    const char* span;
+    int n;
+    const char* suffix;
+    uint32_t target;
+    uint32_t* found_hashes;
+    char (*found_names)[32];
+    int found;
+    int max_found;
+    MatchIndex seen;
+    uint64_t tested;
+} LatticeJob;
+
+static void lattice_try(LatticeJob* job, uint32_t state, const int64_t* d) {
+    char name[64];
+    job->tested++;
+    memcpy(name, job->prefix, job->prefix_len);
+    if (!lattice_reconstruct(state, d, job->n, job->span, name + job->prefix_len)) return;
+    strcpy(name + job->prefix_len + job->n, job->suffix);
+    for (char* p = name; *p; p++) *p = (char)tolower(*p);
+    if (!(name[0] >= 'a' && name[0] <= 'z') || wwise_hash(name) != job->target) return;
+    job->found = record_unique_match(job->target, name, -1, job->found_hashes, job->found_names,
+                                     NULL, job->found, job->max_found, &job->seen);
+}
+
+/*
+ * Schnorr-Euchner style enumeration of every kernel-lattice vector v with
+ * ||base + v|| <= radius.  mu/bnorm are the GS data of the kernel basis,
+ * tau the GS coordinates of -base; level runs from n-1 down to 0.
+ */
+typedef struct {
+    LatticeJob* job;
+    int n;
+    uint32_t state;
+    const int64_t* base;
+    int64_t (*kernel)[LATTICE_MAX_DIM];
+    long double (*mu)[LATTICE_MAX_DIM];
+    const long double* bnorm;
+    const long double* tau;
+    int64_t x[LATTICE_MAX_DIM];
+    uint64_t budget;
+} LatticeEnum;
+
+static void lattice_enum_level(LatticeEnum* e, int level, long double remaining) {
+    if (e->budget == 0 || e->job->found >= e->job->max_found) return;
+
+    if (level < 0) {
+        int64_t d[LATTICE_MAX_DIM];
+        for (int i = 0; i < e->n; i++) {
+            d[i] = e->base[i];
+            for (int j = 0; j < e->n; j++) d[i] += e->x[j] * e->kernel[j][i];
+        }
+        e->budget--;
+        lattice_try(e->job, e->state, d);
+        return;
+    }
+
+    long double center = e->tau[level];
+    for (int i = level + 1; i < e->n; i++) center -= (long double)e->x[i] * e->mu[i][level];
+    if (e->bnorm[level] <= 0.0L) return;
+    long double span = sqrtl(remaining / e->bnorm[level]);
+
+    /* zig-zag outward from the rounded center */
+    int64_t c0 = (int64_t)floorl(center + 0.5L);
+    for (int64_t step = 0; ; step++) {
+        int any = 0;
+        for (int side = 0; side < (step ? 2 : 1); side++) {
+            int64_t xi = side ? c0 - step : c0 + step;
+            long double diff = (long double)xi - center;
+            if (diff < -span - 1e-9 || diff > span + 1e-9) continue;
+            any = 1;
+            e->x[level] = xi;
+            lattice_enum_level(e, level - 1, remaining - diff * diff * e->bnorm[level]);
+            if (e->budget == 0) return;
+        }
+        if (!any && (long double)step > span + 1.0L) break;
+    }
+}
+
+static void lattice_enumerate(LatticeJob* job, uint32_t state, const int64_t* base,
+                              Lattice* K, double radius, uint64_t max_candidates);
+
+/* Solve one target: build, reduce, enumerate solutions inside the radius */
+static void lattice_solve_target(LatticeJob* job, double radius, uint64_t max_candidates) {
+    Lattice L;
+    int n = job->n;
+    int dim = n + 2;
+    int mid = n;            /* weighted equation column */
+    int emb = n + 1;        /* embedding column */
+
+    uint32_t state = FNV_OFFSET;
+    for (int i = 0; i < job->prefix_len; i++) state = (state * FNV_PRIME) ^ (uint8_t)tolower(job->prefix[i]);
+    uint32_t need = wwise_hash_inverse(job->target, job->suffix, (int)strlen(job->suffix));
+
+    uint32_t pn = 1;
+    for (int i = 0; i < n; i++) pn *= FNV_PRIME;
+    uint32_t rhs = need - state * pn;
+
+    memset(&L, 0, sizeof(L));
+    L.dim = dim;
+    uint32_t coeff = 1;                     /* P^(n-1-i), filled from the end */
+    for (int i = n - 1; i >= 0; i--) {
+        L.b[i][i] = 1;
+        L.b[i][mid] = LATTICE_WEIGHT * (int64_t)coeff;
+        coeff *= FNV_PRIME;
+    }
+    L.b[n][mid] = LATTICE_WEIGHT * ((int64_t)1 << 32);
+    L.b[n + 1][mid] = -LATTICE_WEIGHT * (int64_t)rhs;
+    L.b[n + 1][emb] = LATTICE_EMBED;
+
+    if (!lattice_lll(&L)) return;
+
+    /*
+     * Rows with a zero equation column span {(d, z * EMBED)}.  Euclid on the
+     * embedding column leaves one row with z = +-1 (a particular solution)
+     * and n rows with z = 0 (the kernel basis), which is then re-reduced.
+     */
+    int64_t rows[LATTICE_MAX_DIM][LATTICE_MAX_DIM];
+    int row_count = 0;
+    for (int r = 0; r < dim; r++) {
+        if (L.b[r][mid] != 0) continue;
+        for (int i = 0; i < n; i++) rows[row_count][i] = L.b[r][i];
+        rows[row_count][n] = L.b[r][emb] / LATTICE_EMBED;
+        row_count++;
+    }
+    for (;;) {
+        int pivot = -1;
+        for (int r = 0; r < row_count; r++) {
+            if (rows[r][n] != 0 && (pivot < 0 || llabs(rows[r][n]) < llabs(rows[pivot][n]))) pivot = r;
+        }
+        if (pivot < 0) return;
+        int others = 0;
+        for (int r = 0; r < row_count; r++) {
+            if (r == pivot || rows[r][n] == 0) continue;
+            int64_t q = rows[r][n] / rows[pivot][n];
+            for (int i = 0; i <= n; i++) rows[r][i] -= q * rows[pivot][i];
+            if (rows[r][n] != 0) others = 1;
+        }
+        if (others) continue;
+        if (llabs(rows[pivot][n]) != 1) return;
+
+        int64_t base[LATTICE_MAX_DIM];
+        Lattice K;
+        memset(&K, 0, sizeof(K));
+        for (int i = 0; i < n; i++) base[i] = rows[pivot][n] * rows[pivot][i];
+        for (int r = 0; r < row_count; r++) {
+            if (r == pivot || K.dim >= n) continue;
+            for (int i = 0; i < n; i++) K.b[K.dim][i] = rows[r][i];
+            K.dim++;
+        }
+        if (K.dim < n) return;
+        if (!lattice_lll(&K)) return;
+        lattice_enumerate(job, state, base, &K, radius, max_candidates);
+        return;
+    }
+}
+
+/* CVP-enumerate base + kernel lattice inside the radius */
+static void lattice_enumerate(LatticeJob* job, uint32_t state, const int64_t* base,
+                              Lattice* K, double radius, uint64_t max_candidates) {
+    int n = K->dim;
+
+    /* GS of the kernel basis and coordinates of -base */
+    long double mu[LATTICE_MAX_DIM][LATTICE_MAX_DIM];
+    long double bnorm[LATTICE_MAX_DIM];
+    long double tau[LATTICE_MAX_DIM];
+    int64_t t[LATTICE_MAX_DIM];
+    for (int i = 0; i < n; i++) t[i] = -base[i];
+    lattice_gram_schmidt(K, mu, bnorm, t, tau);
+
+    LatticeEnum e;
+    memset(&e, 0, sizeof(e));
+    e.job = job;
+    e.n = n;
+    e.state = state;
+    e.base = base;
+    e.kernel = K->b;
+    e.mu = mu;
+    e.bnorm = bnorm;
+    e.tau = tau;
+    e.budget = max_candidates;
+    lattice_enum_level(&e, n - 1, radius * radius);
+}
+
+/*
+ * Lattice preimage search for one '?' pattern against every target.
+ * Every solution d with ||d|| <= radius is tried, capped at max_candidates
+ * per target.  radius <= 0 picks the whole box (127 * sqrt(n)) for spans
+ * up to 6 chars and 75 * sqrt(n), the typical norm of a real name's
+ * deltas, beyond that.
+ */
+EXPORT int lattice_preimage_search(
+    const char* pattern,
+    const uint32_t* targets,
+    int target_count,
+    double radius,
+    uint64_t max_candidates,
+    uint32_t* found_hashes,
+    char (*found_names)[32],
+    int max_found,
+    uint64_t* tested
+) {
+    LatticeJob job;
+    int len = (int)strlen(pattern);
+    const char* first = strchr(pattern, '?');
+    const char* last = strrchr(pattern, '?');
+
+    if (tested) *tested = 0;
+    if (!first || len > 31) return 0;
+
+    memset(&job, 0, sizeof(job));
+    job.prefix = pattern;
+    job.prefix_len = (int)(first - pattern);
+    job.span = first;
+    job.n = (int)(last - first) + 1;
+    job.suffix = last + 1;
+    job.found_hashes = found_hashes;
+    job.found_names = found_names;
+    job.max_found = max_found;
+    if (job.n + 2 > LATTICE_MAX_DIM) return 0;
+    if (radius <= 0.0) radius = (job.n <= 6 ? 127.0 : 75.0) * sqrt((double)job.n);
+
+    for (int t = 0; t < target_count && job.found < max_found; t++) {
+        job.target = targets[t];
+        lattice_solve_target(&job, radius, max_candidates);
+    }
+
+    if (tested) *tested = job.tested;
+    match_index_free(&job.seen);
+    return job.found;
+}
+
+/* ============================================================================
+ * MASK KERNEL ENGINE
+ * Fixed-shape candidates (brute force, hashcat-style masks, word + mask
+ * hybrids) all run through one odometer kernel over a mixed-radix index
+ * range [start, end), last position fastest.  Masks:
+ *   ?l = [a-z]   ?d = [0-9]   ?w / ?a = [a-z_0-9]   [abc] / [a-f] = custom
+ *   anything else is a literal ('??' = literal '?')
+ * Leading literals fold into the prefix state, trailing literals are
+ * inverted out of the targets, so only the variable middle is hashed.
+ *
+ * Backends (selectable per call):
+ *   KERNEL_SCALAR    32-bit state per candidate, low-16 bitmap + exact check
+ *   KERNEL_LOWBITS16 FNV-1's low k bits depend only on the low k bits of
+ *                    every state, so the last two positions are run in
+ *                    16-bit lanes (_mm256_mullo_epi16, 16 lanes/vector) and
+ *                    matched against the low-16 target table.  Bits 7-15
+ *                    are fixed before the final XOR, so each lane only
+ *                    visits the targets sharing them (~targets/512) for the
+ *                    whole last position; survivors are recomputed in 32
+ *                    bits.  ~4x scalar at 1.5k targets, ~40x at 1 target.
+ *   KERNEL_BITSLICE  32 bit-planes, shift-add multiply network and a
+ *                    bitsliced target trie (experimental, see below)
+ * ============================================================================ */
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#define MASK_MAX_POSITIONS 24
+#define MASK_MAX_SET 64
+
+#define KERNEL_SCALAR       0
+#define KERNEL_LOWBITS16    1
+#define KERNEL_BITSLICE     2
+
+typedef struct {
+    uint32_t prefix_state;
+    int prefix_len;
+    char prefix[32];
+    int positions;                              /* positions between prefix and suffix */
+    uint8_t set_lens[MASK_MAX_POSITIONS];
+    char sets[MASK_MAX_POSITIONS][MASK_MAX_SET];
+    int suffix_len;
+    char suffix[32];
+} MaskSpec;
+
+typedef struct {
+    uint32_t* sorted;           /* exact targets (suffix-inverted), sorted */
+    int count;
+    uint64_t low16[1024];       /* bit (h & 0xFFFF) set for every target */
+    uint32_t* by_row;           /* targets bucketed by bits 7-15 */
+    uint32_t row_start[513];
+} TargetFilter;
+
+/* Caller target (value, HASH_* form) sorted for hit resolution */
+typedef struct {
+    uint64_t value;
+    int form;
+    int index;
+} TaggedIndex;
+
+typedef struct {
+    uint32_t* hashes;
+    char (*names)[32];
+    int count;
+    int max;
+    /* tagged searches: hits resolve to indices of the caller's targets */
+    const TaggedIndex* tagged;
+    int tagged_count;
+    int pass;                   /* HASH_* policy the running kernel computes */
+    int* target_index;
+    /* optional per-hit source tag (route, word index, ...) */
+    int* seeds;
+    int seed;
+    MatchIndex seen;            /* dedup of the recorded hits (match_index_free) */
+} MatchList;
+
+static int mask_add_set(MaskSpec* m, const char* chars, int n) {
+    if (m->positions >= MASK_MAX_POSITIONS) return 0;
+    int len = 0;
+    for (int i = 0; i < n && len < MASK_MAX_SET; i++) {
+        char c = (char)tolower((uint8_t)chars[i]);
+        if (!memchr(m->sets[m->positions], c, len)) m->sets[m->positions][len++] = c;
+    }
+    m->set_lens[m->positions++] = (uint8_t)len;
+    return len > 0;
+}
+
+/*
+ * Literal run of the mask being parsed.  Leading literals become the
+ * prefix, trailing ones the suffix and only literals between variable
+ * positions take a position, so MASK_MAX_POSITIONS bounds the middle.
+ */
+static int mask_flush_literals(MaskSpec* m, const char* run, int run_len) {
+    if (m->positions == 0 && m->prefix_len == 0) {
+        memcpy(m->prefix, run, run_len);
+        m->prefix_len = run_len;
+        return 1;
+    }
+    for (int i = 0; i < run_len; i++) {
+        if (!mask_add_set(m, run + i, 1)) return 0;
+    }
+    return 1;
+}
+
+/* One token (set of n chars); single-char sets extend the literal run */
+static int mask_add_token(MaskSpec* m, char* run, int* run_len, const char* chars, int n) {
+    int single = n > 0;
+    for (int i = 1; i < n && single; i++) single = tolower((uint8_t)chars[i]) == tolower((uint8_t)chars[0]);
+    if (single) {
+        if (*run_len >= 31) return 0;
+        run[(*run_len)++] = (char)tolower((uint8_t)chars[0]);
+        return 1;
+    }
+    if (!mask_flush_literals(m, run, *run_len)) return 0;
+    *run_len = 0;
+    return mask_add_set(m, chars, n);
+}
+
+/* Parse a mask; returns 0 on syntax error or overflow */
+static int mask_parse(const char* mask, MaskSpec* m) {
+    char run[32];
+    int run_len = 0;
+    memset(m, 0, sizeof(*m));
+
+    for (const char* p = mask; *p; ) {
+        int ok;
+        if (p[0] == '?' && p[1] && p[1] != '?') {
+            switch (p[1]) {
+                case 'l': ok = mask_add_token(m, run, &run_len, CHARSET_FIRST, CHARSET_FIRST_LEN); break;
+                case 'd': ok = mask_add_token(m, run, &run_len, "0123456789", 10); break;
+                case 'w':
+                case 'a': ok = mask_add_token(m, run, &run_len, CHARSET_REST, CHARSET_REST_LEN); break;
+                default: return 0;
+            }
+            p += 2;
+        } else if (p[0] == '[') {
+            char set[MASK_MAX_SET * 4];
+            int n = 0;
+            const char* q = p + 1;
+            for (; *q && *q != ']' && n < (int)sizeof(set) - 1; q++) {
+                if (q[1] == '-' && q[2] && q[2] != ']') {
+                    for (int c = (uint8_t)q[0]; c <= (uint8_t)q[2] && n < (int)sizeof(set) - 1; c++) set[n++] = (char)c;
+                    q += 2;
+                } else {
+                    set[n++] = *q;
+                }
+            }
+            if (*q != ']') return 0;
+            ok = mask_add_token(m, run, &run_len, set, n);
+            p = q + 1;
+        } else {
+            ok = mask_add_token(m, run, &run_len, p, 1);
+            p += (p[0] == '?' && p[1] == '?') ? 2 : 1;      /* a trailing lone '?' is literal */
+        }
+        if (!ok) return 0;
+    }
+
+    /* trailing literals become the suffix (inverted out of targets) */
+    if (m->positions == 0 && m->prefix_len == 0) {
+        memcpy(m->prefix, run, run_len);
+        m->prefix_len = run_len;
+    } else {
+        memcpy(m->suffix, run, run_len);
+        m->suffix_len = run_len;
+    }
+    m->prefix[m->prefix_len] = '\0';
+    m->suffix[m->suffix_len] = '\0';
+    m->prefix_state = wwise_hash_len(m->prefix, m->prefix_len);
+    return 1;
+}
+
+static uint64_t mask_spec_keyspace(const MaskSpec* m) {
+    uint64_t n = 1;
+    for (int i = 0; i < m->positions; i++) {
+        if (n > UINT64_MAX / m->set_lens[i]) return UINT64_MAX;
+        n *= m->set_lens[i];
+    }
+    return n;
+}
+
+/*
+ * Keyspace arithmetic saturating at UINT64_MAX, which stands for "does
+ * not fit 64 bits": ranged searches and jobs reject such keyspaces, since
+ * their indices could not address every candidate.
+ */
+static uint64_t keyspace_add(uint64_t a, uint64_t b) {
+    return a > UINT64_MAX - b ? UINT64_MAX : a + b;
+}
+
+static uint64_t keyspace_mul(uint64_t a, uint64_t b) {
+    return b && a > UINT64_MAX / b ? UINT64_MAX : a * b;
+}
+
+static int target_filter_build(TargetFilter* f, const uint32_t* targets, int target_count,
+                               const char* suffix, int suffix_len) {
+    memset(f, 0, sizeof(*f));
+    f->sorted = (uint32_t*)malloc(sizeof(uint32_t) * (target_count ? target_count : 1));
+    f->by_row = (uint32_t*)malloc(sizeof(uint32_t) * (target_count ? target_count : 1));
+    if (!f->sorted || !f->by_row) {
+        free(f->sorted);
+        free(f->by_row);
+        return 0;
+    }
+    for (int i = 0; i < target_count; i++) {
+        f->sorted[i] = suffix_len ? wwise_hash_inverse(targets[i], suffix, suffix_len) : targets[i];
+        f->low16[(f->sorted[i] & 0xFFFF) >> 6] |= (uint64_t)1 << (f->sorted[i] & 63);
+        f->row_start[((f->sorted[i] & 0xFFFF) >> 7) + 1]++;
+    }
+    qsort(f->sorted, target_count, sizeof(uint32_t), uint32_compare);
+    f->count = target_count;
+
+    uint32_t fill[512];
+    for (int r = 0; r < 512; r++) {
+        f->row_start[r + 1] += f->row_start[r];
+        fill[r] = f->row_start[r];
+    }
+    for (int i = 0; i < target_count; i++) {
+        f->by_row[fill[(f->sorted[i] & 0xFFFF) >> 7]++] = f->sorted[i];
+    }
+    return 1;
+}
+
+static void target_filter_free(TargetFilter* f) {
+    free(f->sorted);
+    free(f->by_row);
+    f->sorted = NULL;
+    f->by_row = NULL;
+}
+
+static inline int target_filter_hit(const TargetFilter* f, uint32_t h) {
+    if (!((f->low16[(h & 0xFFFF) >> 6] >> (h & 63)) & 1)) return 0;
+    return is_target(h, f->sorted, f->count);
+}
+
+static int tagged_index_compare(const void* a, const void* b) {
+    const TaggedIndex* x = (const TaggedIndex*)a;
+    const TaggedIndex* y = (const TaggedIndex*)b;
+    if (x->form != y->form) return x->form - y->form;
+    if (x->value != y->value) return x->value < y->value ? -1 : 1;
+    return x->index - y->index;
+}
+
+/* First entry of a sorted TaggedIndex with this (form, value); count if none */
+static int tagged_index_first(const TaggedIndex* index, int count, int form, uint64_t value) {
+    int lo = 0, hi = count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        const TaggedIndex* t = &index[mid];
+        if (t->form < form || (t->form == form && t->value < value)) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+/* Record (target index, name) once; out->seen is keyed on the target index */
+static void tagged_record(MatchList* out, uint32_t digest, int index, const char* name) {
+    MatchIndex* seen = &out->seen;
+    uint32_t slot = 0;
+    if (!seen->slots && out->count == 0) match_index_reserve(seen, out->max);
+    if (seen->slots) {
+        for (slot = match_index_slot(seen, (uint32_t)index); seen->slots[slot]; slot = (slot + 1) & seen->mask) {
+            int i = seen->slots[slot] - 1;
+            if (out->target_index[i] == index && strcmp(out->names[i], name) == 0) return;
+        }
+    } else {
+        for (int i = 0; i < out->count; i++) {
+            if (out->target_index[i] == index && strcmp(out->names[i], name) == 0) return;
+        }
+    }
+    if (out->count >= out->max) return;
+    out->hashes[out->count] = digest;
+    out->target_index[out->count] = index;
+    strcpy(out->names[out->count], name);
+    if (seen->slots) seen->slots[slot] = out->count + 1;
+    out->count++;
+}
+
+/* Record every caller target the name hits under the forms of the current pass */
+static void tagged_emit(const char* name, MatchList* out) {
+    uint64_t digests[2];
+    int forms[2], n = 0;
+
+    if (out->pass == HASH_FNV1_32) {
+        uint32_t h = wwise_hash(name);
+        digests[n] = h;                       forms[n++] = HASH_FNV1_32;
+        digests[n] = wwise_hash32_to_30(h);   forms[n++] = HASH_HASH30;
+    } else {
+        digests[n] = hash_policy_digest(out->pass, name);
+        forms[n++] = out->pass;
+    }
+
+    for (int k = 0; k < n; k++) {
+        for (int i = tagged_index_first(out->tagged, out->tagged_count, forms[k], digests[k]);
+             i < out->tagged_count && out->tagged[i].form == forms[k] && out->tagged[i].value == digests[k]; i++) {
+            tagged_record(out, (uint32_t)digests[k], out->tagged[i].index, name);
+        }
+    }
+}
+
+/* Build the candidate for a digit vector and record it against the real target */
+static void mask_emit(const MaskSpec* m, const int* digits, MatchList* out) {
+    char name[96];
+    int len = m->prefix_len;
+    memcpy(name, m->prefix, len);
+    for (int i = 0; i < m->positions; i++) name[len++] = m->sets[i][digits[i]];
+    memcpy(name + len, m->suffix, m->suffix_len + 1);
+    len += m->suffix_len;
+    if (len > 31) return;
+    if (out->tagged) {
+        tagged_emit(name, out);
+        return;
+    }
+    out->count = record_unique_match(wwise_hash(name), name, out->seed, out->hashes, out->names,
+                                     out->seeds, out->count, out->max, &out->seen);
+}
+
+/* Decode a mixed-radix index into digits and rebuild the cached states */
+static void mask_seek(const MaskSpec* m, uint64_t index, int* digits, uint32_t* states) {
+    for (int i = m->positions - 1; i >= 0; i--) {
+        digits[i] = (int)(index % m->set_lens[i]);
+        index /= m->set_lens[i];
+    }
+    states[0] = m->prefix_state;
+    for (int i = 0; i < m->positions; i++) {
+        states[i + 1] = (states[i] * FNV_PRIME) ^ (uint8_t)m->sets[i][digits[i]];
+    }
+}
+
+/* Advance digits[0..upto) by one; returns lowest changed position or -1 on wrap */
+static inline int mask_step(const MaskSpec* m, int* digits, uint32_t* states, int upto) {
+    int pos = upto - 1;
+    while (pos >= 0 && ++digits[pos] >= m->set_lens[pos]) digits[pos--] = 0;
+    if (pos < 0) return -1;
+    for (int i = pos; i < upto; i++) {
+        states[i + 1] = (states[i] * FNV_PRIME) ^ (uint8_t)m->sets[i][digits[i]];
+    }
+    return pos;
+}
+
+/*
+ * Scalar backend over [start, end).  Like every backend, returns the index
+ * the range was processed up to: end, or less once the match list filled.
+ */
+static uint64_t mask_kernel_scalar(const MaskSpec* m, const TargetFilter* f,
+                                   uint64_t start, uint64_t end, MatchList* out) {
+    int digits[MASK_MAX_POSITIONS + 1] = {0};
+    uint32_t states[MASK_MAX_POSITIONS + 1];
+    int n = m->positions;
+
+    if (start >= end) return end;
+    mask_seek(m, start, digits, states);
+    if (n == 0) {
+        if (target_filter_hit(f, states[0])) mask_emit(m, digits, out);
+        return end;
+    }
+
+    const char* last = m->sets[n - 1];
+    int last_len = m->set_lens[n - 1];
+    uint64_t index = start;
+    while (index < end && out->count < out->max) {
+        uint32_t base = states[n - 1] * FNV_PRIME;
+        int c = digits[n - 1];
+        uint64_t run = (uint64_t)(last_len - c);
+        if (run > end - index) run = end - index;
+        for (uint64_t k = 0; k < run; k++, c++) {
+            uint32_t h = base ^ (uint8_t)last[c];
+            if (target_filter_hit(f, h)) {
+                digits[n - 1] = c;
+                mask_emit(m, digits, out);
+            }
+        }
+        index += run;
+        digits[n - 1] = last_len - 1;
+        if (index >= end || mask_step(m, digits, states, n) < 0) break;
+    }
+    return index < end ? index : end;
+}
+
+/*
+ * Low-bits backend: blocks of (positions n-2, n-1) run in 16-bit lanes.
+ * Unaligned head/tail of the range falls back to the scalar kernel.  A
+ * last character of 0x80 or above flips bit 7 of the hash, so such sets
+ * also scan the row with bit 7 flipped.
+ */
+static uint64_t mask_kernel_lowbits16(const MaskSpec* m, const TargetFilter* f,
+                                      uint64_t start, uint64_t end, MatchList* out) {
+    int n = m->positions;
+    if (n < 2) return mask_kernel_scalar(m, f, start, end, out);
+
+    uint64_t block = (uint64_t)m->set_lens[n - 2] * m->set_lens[n - 1];
+    uint64_t first = (start + block - 1) / block * block;
+    uint64_t last_block = end / block * block;
+    if (first >= last_block) return mask_kernel_scalar(m, f, start, end, out);
+    uint64_t reached = mask_kernel_scalar(m, f, start, first, out);
+    if (reached < first) return reached;
+
+    const char* set1 = m->sets[n - 2];
+    const char* set2 = m->sets[n - 1];
+    int len1 = m->set_lens[n - 2], len2 = m->set_lens[n - 1];
+    uint64_t last_mask[4] = {0, 0, 0, 0};   /* membership of the last set, by byte */
+    int last_index[256];
+    uint32_t flip = 0;                      /* 1: some last character has bit 7 set */
+    for (int i = 0; i < len2; i++) {
+        uint8_t c = (uint8_t)set2[i];
+        last_mask[c >> 6] |= (uint64_t)1 << (c & 63);
+        last_index[c] = i;
+        flip |= c >> 7;
+    }
+
+    int digits[MASK_MAX_POSITIONS + 1];
+    uint32_t states[MASK_MAX_POSITIONS + 1];
+    uint16_t chars1[MASK_MAX_SET] = {0};
+    uint16_t lanes[MASK_MAX_SET];
+    for (int i = 0; i < len1; i++) chars1[i] = (uint8_t)set1[i];
+    mask_seek(m, first, digits, states);
+
+    uint64_t index = first;
+    for (; index < last_block && out->count < out->max; index += block) {
+        uint32_t sp = states[n - 2] * FNV_PRIME;    /* state before set1, times P */
+        uint16_t t = (uint16_t)sp;
+
+        /* lanes[i] = low16((t ^ c1) * P) */
+#ifdef __AVX2__
+        {
+            const __m256i p16 = _mm256_set1_epi16((short)(FNV_PRIME & 0xFFFF));
+            const __m256i tv = _mm256_set1_epi16((short)t);
+            for (int i = 0; i < len1; i += 16) {
+                __m256i v = _mm256_xor_si256(tv, _mm256_loadu_si256((const __m256i*)(chars1 + i)));
+                _mm256_storeu_si256((__m256i*)(lanes + i), _mm256_mullo_epi16(v, p16));
+            }
+        }
+#else
+        for (int i = 0; i < len1; i++) {
+            lanes[i] = (uint16_t)((uint16_t)(t ^ chars1[i]) * (uint16_t)(FNV_PRIME & 0xFFFF));
+        }
+#endif
+
+        for (int i = 0; i < len1; i++) {
+            uint16_t w = lanes[i];
+            uint32_t h1 = (sp ^ chars1[i]) * FNV_PRIME;
+
+            /* every target in row r agrees with w ^ c2 on bits 7-15 */
+            for (uint32_t r = w >> 7, rows = 0; rows <= flip; rows++, r ^= 1) {
+                for (uint32_t k = f->row_start[r]; k < f->row_start[r + 1]; k++) {
+                    uint32_t target = f->by_row[k];
+                    uint8_t c2 = (uint8_t)(target ^ w);
+                    if (!((last_mask[c2 >> 6] >> (c2 & 63)) & 1)) continue;
+                    if ((h1 ^ c2) == target) {
+                        digits[n - 2] = i;
+                        digits[n - 1] = last_index[c2];
+                        mask_emit(m, digits, out);
+                    }
+                }
+            }
+        }
+
+        digits[n - 2] = len1 - 1;
+        digits[n - 1] = len2 - 1;
+        if (mask_step(m, digits, states, n) < 0) {
+            index += block;
+            break;
+        }
+    }
+    if (index < last_block) return index;
+
+    return mask_kernel_scalar(m, f, last_block, end, out);
+}
+
+/*
+ * Bitsliced backend: 32 bit-planes, one candidate per bit lane (256 lanes
+ * per plane with AVX2, 64 otherwise).  Lanes span positions n-3 and n-2
+ * with their characters pre-transposed into planes; the multiply by
+ * 2^24 + 2^8 + 0x93 is the USE_FNV_SHIFT_ADD decomposition run as a fixed
+ * ripple-carry network, where shifts are just plane renames.  Bits 7-31
+ * of the final hash are settled before the last XOR, so targets are
+ * matched with a pruned bitsliced trie over those 25 planes (one AND per
+ * visited node) and the last character falls out of bits 0-6.  A last
+ * set with bytes of 0x80 or above also reaches bit 7, so the trie stops
+ * one plane higher and the character falls out of bits 0-7.
+ * Roughly half of KERNEL_LOWBITS16 up to a few thousand targets; pulls
+ * ahead around 20k targets, where the trie prunes better than row scans.
+ */
+#ifdef __AVX2__
+typedef __m256i bs_word;
+#define BS_LANES            256
+#define BS_AND(a, b)        _mm256_and_si256(a, b)
+#define BS_ANDNOT(a, b)     _mm256_andnot_si256(a, b)     /* ~a & b */
+#define BS_OR(a, b)         _mm256_or_si256(a, b)
+#define BS_XOR(a, b)        _mm256_xor_si256(a, b)
+#define BS_ZERO()           _mm256_setzero_si256()
+#define BS_ONES()           _mm256_set1_epi32(-1)
+#define BS_IS_ZERO(a)       _mm256_testz_si256(a, a)
+#else
+typedef uint64_t bs_word;
+#define BS_LANES            64
+#define BS_AND(a, b)        ((a) & (b))
+#define BS_ANDNOT(a, b)     (~(a) & (b))
+#define BS_OR(a, b)         ((a) | (b))
+#define BS_XOR(a, b)        ((a) ^ (b))
+#define BS_ZERO()           ((uint64_t)0)
+#define BS_ONES()           (~(uint64_t)0)
+#define BS_IS_ZERO(a)       ((a) == 0)
+#endif
+
+#define BS_MAX_WORDS ((MASK_MAX_SET * MASK_MAX_SET + BS_LANES - 1) / BS_LANES)
+
+static inline int bs_lane_bit(const bs_word* w, int lane) {
+    uint64_t q[BS_LANES / 64];
+    memcpy(q, w, sizeof(q));
+    return (int)((q[lane >> 6] >> (lane & 63)) & 1);
+}
+
+/* acc += x << shift over planes [shift, 32) */
+static inline void bs_add_shifted(bs_word* acc, const bs_word* x, int shift) {
+    bs_word carry = BS_ZERO();
+    for (int i = shift; i < 32; i++) {
+        bs_word a = acc[i], b = x[i - shift];
+        bs_word ab = BS_XOR(a, b);
+        acc[i] = BS_XOR(ab, carry);
+        carry = BS_OR(BS_AND(a, b), BS_AND(carry, ab));
+    }
+}
+
+/* h *= FNV_PRIME = h + h<<1 + h<<4 + h<<7 + h<<8 + h<<24 */
+static void bs_mul_prime(bs_word* h) {
+    bs_word x[32];
+    memcpy(x, h, sizeof(x));
+    bs_add_shifted(h, x, 1);
+    bs_add_shifted(h, x, 4);
+    bs_add_shifted(h, x, 7);
+    bs_add_shifted(h, x, 8);
+    bs_add_shifted(h, x, 24);
+}
+
+typedef struct {
+    const MaskSpec* m;
+    const TargetFilter* f;
+    MatchList* out;
+    int* digits;
+    const bs_word* planes;          /* h before the last XOR, 32 planes */
+    int word;
+    int len_b;
+    int low_bits;                   /* hash bits the last character can flip: 7 or 8 */
+    uint64_t last_mask[4];
+    const int* last_index;
+} BitsliceMatch;
+
+static void bs_emit_lanes(BitsliceMatch* bm, bs_word mask, uint32_t target) {
+    uint64_t q[BS_LANES / 64];
+    memcpy(q, &mask, sizeof(q));
+    for (int k = 0; k < BS_LANES / 64; k++) {
+        while (q[k]) {
+            int lane = k * 64 + __builtin_ctzll(q[k]);
+            q[k] &= q[k] - 1;
+
+            uint32_t low = 0;
+            for (int b = 0; b < bm->low_bits; b++) low |= (uint32_t)bs_lane_bit(&bm->planes[b], lane) << b;
+            uint8_t c = (uint8_t)((target ^ low) & ((1u << bm->low_bits) - 1));
+            if (!((bm->last_mask[c >> 6] >> (c & 63)) & 1)) continue;
+
+            int index = bm->word * BS_LANES + lane;
+            int n = bm->m->positions;
+            bm->digits[n - 3] = index / bm->len_b;
+            bm->digits[n - 2] = index % bm->len_b;
+            bm->digits[n - 1] = bm->last_index[c];
+            mask_emit(bm->m, bm->digits, bm->out);
+        }
+    }
+}
+
+/* Walk sorted targets [lo, hi) that agree on bits above `bit`, narrowing lane mask */
+static void bs_match(BitsliceMatch* bm, int lo, int hi, int bit, bs_word mask) {
+    const uint32_t* t = bm->f->sorted;
+    const int low_bits = bm->low_bits;
+
+    while (bit >= low_bits && hi - lo == 1) {
+        /* single target left: straight equality on the remaining planes */
+        for (; bit >= low_bits; bit--) {
+            mask = ((t[lo] >> bit) & 1) ? BS_AND(mask, bm->planes[bit])
+                                        : BS_ANDNOT(bm->planes[bit], mask);
+            if (BS_IS_ZERO(mask)) return;
+        }
+    }
+    if (bit < low_bits) {
+        for (int i = lo; i < hi; i++) bs_emit_lanes(bm, mask, t[i]);
+        return;
+    }
+
+    /* targets with this bit clear sort first */
+    int a = lo, b = hi;
+    while (a < b) {
+        int mid = (a + b) / 2;
+        if ((t[mid] >> bit) & 1) b = mid; else a = mid + 1;
+    }
+    if (a > lo) {
+        bs_word m0 = BS_ANDNOT(bm->planes[bit], mask);
+        if (!BS_IS_ZERO(m0)) bs_match(bm, lo, a, bit - 1, m0);
+    }
+    if (a < hi) {
+        bs_word m1 = BS_AND(mask, bm->planes[bit]);
+        if (!BS_IS_ZERO(m1)) bs_match(bm, a, hi, bit - 1, m1);
+    }
+}
+
+static uint64_t mask_kernel_bitslice(const MaskSpec* m, const TargetFilter* f,
+                                     uint64_t start, uint64_t end, MatchList* out) {
+    int n = m->positions;
+    if (n < 3 || f->count == 0) return mask_kernel_scalar(m, f, start, end, out);
+
+    int len_a = m->set_lens[n - 3], len_b = m->set_lens[n - 2], len_c = m->set_lens[n - 1];
+    uint64_t block = (uint64_t)len_a * len_b * len_c;
+    uint64_t first = (start + block - 1) / block * block;
+    uint64_t last_block = end / block * block;
+    if (first >= last_block) return mask_kernel_scalar(m, f, start, end, out);
+    uint64_t reached = mask_kernel_scalar(m, f, start, first, out);
+    if (reached < first) return reached;
+
+    /* transpose positions n-3 / n-2 into planes: lane = ia * len_b + ib */
+    int lanes = len_a * len_b;
+    int words = (lanes + BS_LANES - 1) / BS_LANES;
+    size_t plane_words = (size_t)words * 17;        /* 8 + 8 char planes, 1 valid mask */
+    void* raw = calloc(plane_words * sizeof(bs_word) + 32, 1);
+    if (!raw) return mask_kernel_scalar(m, f, first, end, out);
+    bs_word* ca = (bs_word*)(((uintptr_t)raw + 31) & ~(uintptr_t)31);
+    bs_word* cb = ca + words * 8;
+    bs_word* valid = ca + words * 16;
+    uint64_t* q_ca = (uint64_t*)ca;
+    uint64_t* q_cb = (uint64_t*)cb;
+    uint64_t* q_valid = (uint64_t*)valid;
+    const int qw = BS_LANES / 64;                   /* uint64 words per plane */
+    for (int lane = 0; lane < lanes; lane++) {
+        int w = lane / BS_LANES, q = (lane % BS_LANES) >> 6;
+        uint64_t bit = (uint64_t)1 << (lane & 63);
+        uint8_t a_char = (uint8_t)m->sets[n - 3][lane / len_b];
+        uint8_t b_char = (uint8_t)m->sets[n - 2][lane % len_b];
+        for (int k = 0; k < 8; k++) {
+            if ((a_char >> k) & 1) q_ca[(w * 8 + k) * qw + q] |= bit;
+            if ((b_char >> k) & 1) q_cb[(w * 8 + k) * qw + q] |= bit;
+        }
+        q_valid[w * qw + q] |= bit;
+    }
+
+    BitsliceMatch bm;
+    int digits[MASK_MAX_POSITIONS + 1];
+    uint32_t states[MASK_MAX_POSITIONS + 1];
+    int last_index[256];
+    bs_word h[32];
+    bm.m = m;
+    bm.f = f;
+    bm.out = out;
+    bm.digits = digits;
+    bm.planes = h;
+    bm.len_b = len_b;
+    bm.low_bits = 7;
+    memset(bm.last_mask, 0, sizeof(bm.last_mask));
+    bm.last_index = last_index;
+    for (int i = 0; i < len_c; i++) {
+        uint8_t c = (uint8_t)m->sets[n - 1][i];
+        bm.last_mask[c >> 6] |= (uint64_t)1 << (c & 63);
+        last_index[c] = i;
+        if (c & 0x80) bm.low_bits = 8;
+    }
+
+    mask_seek(m, first, digits, states);
+    uint64_t index = first;
+    for (; index < last_block && out->count < out->max; index += block) {
+        uint32_t sp = states[n - 3] * FNV_PRIME;
+
+        for (int w = 0; w < words; w++) {
+            for (int b = 0; b < 32; b++) {
+                bs_word bit = ((sp >> b) & 1) ? BS_ONES() : BS_ZERO();
+                h[b] = b < 8 ? BS_XOR(bit, ca[w * 8 + b]) : bit;
+            }
+            bs_mul_prime(h);
+            for (int b = 0; b < 8; b++) h[b] = BS_XOR(h[b], cb[w * 8 + b]);
+            bs_mul_prime(h);
+
+            bm.word = w;
+            bs_match(&bm, 0, f->count, 31, valid[w]);
+        }
+
+        digits[n - 3] = len_a - 1;
+        digits[n - 2] = len_b - 1;
+        digits[n - 1] = len_c - 1;
+        if (mask_step(m, digits, states, n) < 0) {
+            index += block;
+            break;
+        }
+    }
+    free(raw);
+    if (index < last_block) return index;
+
+    return mask_kernel_scalar(m, f, last_block, end, out);
+}
+
+/* Run [start, end) on a backend; returns the index processed up to */
+static uint64_t mask_run(const MaskSpec* m, const TargetFilter* f, int backend,
+                         uint64_t start, uint64_t end, MatchList* out) {
+    switch (backend) {
+        case KERNEL_LOWBITS16: return mask_kernel_lowbits16(m, f, start, end, out);
+        case KERNEL_BITSLICE:  return mask_kernel_bitslice(m, f, start, end, out);
+        default:               return mask_kernel_scalar(m, f, start, end, out);
+    }
+}
+
+/*
+ * m = base with `word` prepended to its prefix (word + mask hybrids).
+ * word_state is the word's FNV state when known (compiled dictionary),
+ * NULL to hash it here.  Returns 0 when word + mask is longer than 31
+ * chars, i.e. no candidate could be emitted and the word is skipped.
+ */
+static int mask_with_word(const MaskSpec* base, const char* word, const uint32_t* word_state, MaskSpec* m) {
+    int wlen = (int)strlen(word);
+    if (wlen + base->prefix_len + base->positions + base->suffix_len > 31) return 0;
+    *m = *base;
+    for (int i = 0; i < wlen; i++) m->prefix[i] = (char)tolower(word[i]);
+    memcpy(m->prefix + wlen, base->prefix, base->prefix_len + 1);
+    m->prefix_len = wlen + base->prefix_len;
+    m->prefix_state = word_state ? wwise_hash_continue(*word_state, base->prefix)
+                                 : wwise_hash_len(m->prefix, m->prefix_len);
+    return 1;
+}
+
+/* Keyspace of a mask (0 on parse error) */
+EXPORT uint64_t mask_keyspace(const char* mask) {
+    MaskSpec m;
+    if (!mask_parse(mask, &m)) return 0;
+    return mask_spec_keyspace(&m);
+}
+
+/*
+ * Shard `shard` of `shards` over a keyspace: contiguous index ranges whose
+ * sizes differ by at most one, so N hosts each take [start, end).
+ */
+EXPORT void shard_range(uint64_t keyspace, int shard, int shards, uint64_t* start, uint64_t* end) {
+    if (shards < 1) shards = 1;
+    if (shard < 0) shard = 0;
+    if (shard > shards) shard = shards;
+    uint64_t q = keyspace / (uint64_t)shards, r = keyspace % (uint64_t)shards;
+    *start = q * (uint64_t)shard + ((uint64_t)shard < r ? (uint64_t)shard : r);
+    *end = shard == shards ? keyspace
+         : q * (uint64_t)(shard + 1) + ((uint64_t)(shard + 1) < r ? (uint64_t)(shard + 1) : r);
+}
+
+/*
+ * Mask attack over the index range [start, end) of the mask keyspace
+ * (end == 0 means the whole keyspace).  backend is KERNEL_*.
+ */
+EXPORT int mask_search(
+    const char* mask,
+    uint64_t start,
+    uint64_t end,
+    int backend,
+    const uint32_t* targets,
+    int target_count,
+    uint32_t* found_hashes,
+    char (*found_names)[32],
+    int max_found,
+    uint64_t* tested
+) {
+    MaskSpec m;
+    TargetFilter f;
+    MatchList out = { found_hashes, found_names, 0, max_found, NULL, 0, HASH_FNV1_32, NULL, NULL, -1, {0} };
+
+    if (tested) *tested = 0;
+    if (!mask_parse(mask, &m)) return 0;
+    uint64_t keyspace = mask_spec_keyspace(&m);
+    if (end == 0 || end > keyspace) end = keyspace;
+    if (start >= end) return 0;
+    if (!target_filter_build(&f, targets, target_count, m.suffix, m.suffix_len)) return 0;
+
+    uint64_t reached = mask_run(&m, &f, backend, start, end, &out);
+
+    target_filter_free(&f);
+    match_index_free(&out.seen);
+    if (tested) *tested = reached - start;
+    return out.count;
+}
+
+/*
+ * Hybrid keyspace: the word is the most significant mixed-radix digit, so
+ * index = word * mask_keyspace + mask_index.
+ */
+EXPORT uint64_t hybrid_keyspace(int word_count, const char* mask) {
+    return keyspace_mul((uint64_t)(word_count > 0 ? word_count : 0), mask_keyspace(mask));
+}
+
+/*
+ * Hybrid attack (every word followed by the mask: "word?d?d", "word_?l?l")
+ * over the index range [start, end) of the hybrid keyspace (end == 0: all).
+ * word_states holds each word's FNV state when known (compiled dictionary),
+ * NULL to hash the words here.
+ */
+static int hybrid_run(
+    const char** words,
+    const uint32_t* word_states,
+    int word_count,
+    const char* mask,
+    uint64_t start,
+    uint64_t end,
+    int backend,
+    const uint32_t* targets,
+    int target_count,
+    uint32_t* found_hashes,
+    char (*found_names)[32],
+    int max_found,
+    uint64_t* tested
+) {
+    MaskSpec base, m;
+    TargetFilter f;
+    MatchList out = { found_hashes, found_names, 0, max_found, NULL, 0, HASH_FNV1_32, NULL, NULL, -1, {0} };
+    uint64_t count = 0;
+
+    if (tested) *tested = 0;
+    if (!mask_parse(mask, &base)) return 0;
+    uint64_t keyspace = mask_spec_keyspace(&base);
+    uint64_t total = keyspace_mul((uint64_t)(word_count > 0 ? word_count : 0), keyspace);
+    if (total == UINT64_MAX) return 0;
+    if (end == 0 || end > total) end = total;
+    if (start >= end) return 0;
+    if (!target_filter_build(&f, targets, target_count, base.suffix, base.suffix_len)) return 0;
+
+    for (int w = (int)(start / keyspace); w < word_count && out.count < max_found; w++) {
+        uint64_t base_index = (uint64_t)w * keyspace;
+        if (base_index >= end) break;
+        uint64_t lo = start > base_index ? start - base_index : 0;
+        uint64_t hi = end - base_index < keyspace ? end - base_index : keyspace;
+
+        if (!mask_with_word(&base, words[w], word_states ? &word_states[w] : NULL, &m)) continue;
+        count += mask_run(&m, &f, backend, lo, hi, &out) - lo;
+    }
+
+    target_filter_free(&f);
+    match_index_free(&out.seen);
+    if (tested) *tested = count;
+    return out.count;
+}
+
+/* Hybrid attack over [start, end) of the word-major keyspace */
+EXPORT int hybrid_search_range(
+    const char** words,
+    int word_count,
+    const char* mask,
+    uint64_t start,
+    uint64_t end,
+    int backend,
+    const uint32_t* targets,
+    int target_count,
+    uint32_t* found_hashes,
+    char (*found_names)[32],
+    int max_found,
+    uint64_t* tested
+) {
+    return hybrid_run(words, NULL, word_count, mask, start, end, backend, targets, target_count,
+                      found_hashes, found_names, max_found, tested);
+}
+
+/* Hybrid attack over the whole keyspace */
+EXPORT int hybrid_search(
+    const char** words,
+    int word_count,
+    const char* mask,
+    int backend,
+    const uint32_t* targets,
+    int target_count,
+    uint32_t* found_hashes,
+    char (*found_names)[32],
+    int max_found,
+    uint64_t* tested
+) {
+    return hybrid_search_range(words, word_count, mask, 0, 0, backend, targets, target_count,
+                               found_hashes, found_names, max_found, tested);
+}
+
+static void brute_kernel_mask(char* mask, int len) {
+    strcpy(mask, "?l");
+    for (int i = 1; i < len; i++) strcat(mask, "?w");
+}
+
+/* Brute-force keyspace: the per-length masks laid end to end, shortest first */
+EXPORT uint64_t brute_kernel_keyspace(int min_len, int max_len) {
+    char mask[2 * MASK_MAX_POSITIONS + 1];
+    uint64_t total = 0;
+
+    if (min_len < 1) min_len = 1;
+    if (max_len > MASK_MAX_POSITIONS) max_len = MASK_MAX_POSITIONS;
+    for (int len = min_len; len <= max_len; len++) {
+        brute_kernel_mask(mask, len);
+        total = keyspace_add(total, mask_keyspace(mask));
+    }
+    return total;
+}
+
+/*
+ * Wwise-charset brute force (first char [a-z], rest [a-z_0-9]) on the kernel
+ * engine over the index range [start, end) of brute_kernel_keyspace (end == 0: all).
+ */
+EXPORT int brute_force_kernel_range(
+    int min_len,
+    int max_len,
+    uint64_t start,
+    uint64_t end,
+    int backend,
+    const uint32_t* targets,
+    int target_count,
+    uint32_t* found_hashes,
+    char (*found_names)[32],
+    int max_found,
+    uint64_t* tested
+) {
+    char mask[2 * MASK_MAX_POSITIONS + 1];
+    int found = 0;
+    uint64_t total = 0, base_index = 0;
+
+    if (min_len < 1) min_len = 1;
+    if (max_len > MASK_MAX_POSITIONS) max_len = MASK_MAX_POSITIONS;
+    if (end == 0) end = brute_kernel_keyspace(min_len, max_len);
+    if (end == UINT64_MAX) {
+        if (tested) *tested = 0;
+        return 0;
+    }
+
+    for (int len = min_len; len <= max_len && found < max_found && base_index < end; len++) {
+        uint64_t t = 0;
+        brute_kernel_mask(mask, len);
+        uint64_t keyspace = mask_keyspace(mask);
+        if (start < keyspace_add(base_index, keyspace)) {
+            uint64_t lo = start > base_index ? start - base_index : 0;
+            uint64_t hi = end - base_index < keyspace ? end - base_index : keyspace;
+            found += mask_search(mask, lo, hi, backend, targets, target_count,
+                                 found_hashes + found, found_names + found, max_found - found, &t);
+            total += t;
+        }
+        base_index = keyspace_add(base_index, keyspace);
+    }
+
+    if (tested) *tested = total;
+    return found;
+}
+
+/* Brute force over every length in [min_len, max_len] */
+EXPORT int brute_force_kernel(
+    int min_len,
+    int max_len,
+    int backend,
+    const uint32_t* targets,
+    int target_count,
+    uint32_t* found_hashes,
+    char (*found_names)[32],
+    int max_found,
+    uint64_t* tested
+) {
+    return brute_force_kernel_range(min_len, max_len, 0, 0, backend, targets, target_count,
+                                    found_hashes, found_names, max_found, tested);
+}
+
+typedef struct {
+    const MaskSpec* m;
+    const TargetFilter* f;
+    int backend;
+    int index;                  /* worker slot (NUMA placement) */
+    uint64_t keyspace;
+    uint64_t offset;            /* where this worker starts sweeping */
+    double deadline;
+    uint64_t done;
+} BenchWorker;
+
+THREAD_FUNC(bench_worker, arg) {
+    BenchWorker* w = (BenchWorker*)arg;
+    uint32_t found_hashes[16];
+    char found_names[16][32];
+    MatchList out = { found_hashes, found_names, 0, 16, NULL, 0, HASH_FNV1_32, NULL, NULL, -1, {0} };
+    uint64_t chunk = (uint64_t)37 * 37 * 37 * 37;
+
+    numa_pin_worker(w->index);
+    do {
+        uint64_t start = (w->offset + w->done) % w->keyspace;
+        uint64_t end = start + chunk < w->keyspace ? start + chunk : w->keyspace;
+        out.count = 0;
+        match_index_free(&out.seen);
+        mask_run(w->m, w->f, w->backend, start, end, &out);
+        w->done += end - start;
+    } while (fnv_now() < w->deadline);
+    match_index_free(&out.seen);
+    THREAD_RETURN;
+}
+
+/*
+ * Throughput of a backend in candidates/second: num_threads workers
+ * (<= 0: every core) sweep disjoint parts of length-`length` brute force
+ * against `target_count` pseudo-random targets for roughly `seconds` of
+ * wall time, and the total is divided by the wall time taken.
+ */
+EXPORT double kernel_benchmark(int backend, int length, int target_count, double seconds, int num_threads) {
+    fnv_thread_t threads[MAX_THREADS];
+    BenchWorker workers[MAX_THREADS];
+    MaskSpec m;
+    TargetFilter f;
+    char mask[2 * MASK_MAX_POSITIONS + 1] = "?l";
+    uint32_t* targets = (uint32_t*)malloc(sizeof(uint32_t) * (target_count ? target_count : 1));
+    uint32_t x = 0x12345678u;
+
+    if (!targets) return 0.0;
+    for (int i = 0; i < target_count; i++) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        targets[i] = x;
+    }
+    if (length < 2) length = 2;
+    if (length > MASK_MAX_POSITIONS) length = MASK_MAX_POSITIONS;
+    for (int i = 1; i < length; i++) strcat(mask, "?w");
+    mask_parse(mask, &m);
+    target_filter_build(&f, targets, target_count, NULL, 0);
+
+    num_threads = resolve_thread_count(num_threads);
+    int slot = numa_reserve_slots(num_threads);
+    uint64_t keyspace = mask_spec_keyspace(&m);
+    double begin = fnv_now();
+    int started = 0;
+    for (; started < num_threads; started++) {
+        BenchWorker* w = &workers[started];
+        w->m = &m;
+        w->f = &f;
+        w->backend = backend;
+        w->index = slot + started;
+        w->keyspace = keyspace;
+        w->offset = keyspace / num_threads * started;
+        w->deadline = begin + seconds;
+        w->done = 0;
+        if (!fnv_thread_start(&threads[started], bench_worker, w)) break;
+    }
+    uint64_t done = 0;
+    for (int t = 0; t < started; t++) {
+        fnv_thread_join(threads[t]);
+        done += workers[t].done;
+    }
+    double elapsed = fnv_now() - begin;
+
+    target_filter_free(&f);
+    free(targets);
+    return elapsed > 0 ? (double)done / elapsed : 0.0;
+}
+
+/* ============================================================================
+ * HASH POLICIES FOR THE MASK ENGINE
+ * Tagged target sets mix forms (HASH_FNV1_32 / HASH_HASH30 / HASH_FNV1A_32
+ * / HASH_FNV1_64).  FNV-1/32 and Hash30 share one pass: each 30-bit ID is
+ * expanded into its four 32-bit preimages under the fold, so every
+ * KERNEL_* backend checks both forms of each state at no extra cost.
+ * FNV-1a/32 and FNV-1/64 evolve a different state, so they get their own
+ * pass on scalar kernels instantiated per policy from one macro body.
+ * Hits come back as indices into the caller's target arrays.
+ * ============================================================================ */
+
+typedef struct {
+    uint64_t* sorted;           /* suffix-inverted targets of one policy */
+    int count;
+    uint64_t low16[1024];
+} WideFilter;
+
+#define POLICY_STEP_FNV1A_32(h, c)  ((uint64_t)((((uint32_t)(h)) ^ (c)) * FNV_PRIME))
+#define POLICY_STEP_FNV1_64(h, c)   (((h) * FNV64_PRIME) ^ (c))
+
+static uint64_t fnv64_inverse(void) {
+    uint64_t x = FNV64_PRIME;           /* correct to 3 bits; Newton doubles that */
+    for (int i = 0; i < 5; i++) x *= 2 - FNV64_PRIME * x;
+    return x;
+}
+
+static int uint64_compare(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static int wide_filter_build(WideFilter* f, const uint64_t* values, const int* forms, int count,
+                             int policy, const char* suffix, int suffix_len) {
+    uint64_t inv64 = fnv64_inverse();
+    memset(f, 0, sizeof(*f));
+    f->sorted = (uint64_t*)malloc(sizeof(uint64_t) * (count ? count : 1));
+    if (!f->sorted) return 0;
+
+    for (int i = 0; i < count; i++) {
+        if (forms[i] != policy) continue;
+        uint64_t h = values[i];
+        for (int k = suffix_len - 1; k >= 0; k--) {
+            uint8_t c = (uint8_t)suffix[k];
+            if (policy == HASH_FNV1A_32) h = (uint32_t)((uint32_t)h * FNV_INVERSE) ^ c;
+            else h = (h ^ c) * inv64;
+        }
+        f->sorted[f->count++] = h;
+        f->low16[(h & 0xFFFF) >> 6] |= (uint64_t)1 << (h & 63);
+    }
+    qsort(f->sorted, f->count, sizeof(uint64_t), uint64_compare);
+    return 1;
+}
+
+static inline int wide_filter_hit(const WideFilter* f, uint64_t h) {
+    if (!((f->low16[(h & 0xFFFF) >> 6] >> (h & 63)) & 1)) return 0;
+    int lo = 0, hi = f->count - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (f->sorted[mid] == h) return 1;
+        if (f->sorted[mid] < h) lo = mid + 1;
+        else hi = mid - 1;
+    }
+    return 0;
+}
+
+#define DEFINE_POLICY_KERNEL(NAME, INIT, STEP)                                          \
+static uint64_t NAME(const MaskSpec* m, const WideFilter* f,                            \
+                     uint64_t start, uint64_t end, MatchList* out) {                    \
+    int digits[MASK_MAX_POSITIONS + 1] = {0};                                           \
+    uint64_t states[MASK_MAX_POSITIONS + 1];                                            \
+    int n = m->positions;                                                               \
+    uint64_t index = start;                                                             \
+    for (int i = n - 1; i >= 0; i--) {                                                  \
+        digits[i] = (int)(index % m->set_lens[i]);                                      \
+        index /= m->set_lens[i];                                                        \
+    }                                                                                   \
+    states[0] = INIT;                                                                   \
+    for (int i = 0; i < m->prefix_len; i++) states[0] = STEP(states[0], (uint8_t)m->prefix[i]); \
+    for (int i = 0; i < n; i++) {                                                       \
+        states[i + 1] = STEP(states[i], (uint8_t)m->sets[i][digits[i]]);                \
+    }                                                                                   \
+    for (index = start; index < end && out->count < out->max; index++) {                \
+        if (wide_filter_hit(f, states[n])) mask_emit(m, digits, out);                   \
+        int pos = n - 1;                                                                \
+        while (pos >= 0 && ++digits[pos] >= m->set_lens[pos]) digits[pos--] = 0;        \
+        if (pos < 0) return end;                                                        \
+        for (int i = pos; i < n; i++) {                                                 \
+            states[i + 1] = STEP(states[i], (uint8_t)m->sets[i][digits[i]]);            \
+        }                                                                               \
+    }                                                                                   \
+    return index;                                                                       \
+}
+
+DEFINE_POLICY_KERNEL(mask_kernel_fnv1a_32, FNV_OFFSET, POLICY_STEP_FNV1A_32)
+DEFINE_POLICY_KERNEL(mask_kernel_fnv1_64, FNV64_OFFSET, POLICY_STEP_FNV1_64)
+
+/*
+ * One mask (or word + mask hybrid when words != NULL) over [start, end)
+ * against tagged targets; one pass per hash family present in forms[].
+ */
+static int tagged_search(
+    const char* mask, const char** words, int word_count,
+    uint64_t start, uint64_t end, int backend,
+    const uint64_t* values, const int* forms, int count,
+    uint32_t* found_hashes, char (*found_names)[32], int* found_targets, int max_found,
+    uint64_t* tested
+) {
+    MaskSpec base;
+    MatchList out = { found_hashes, found_names, 0, max_found, NULL, count, 0, found_targets, NULL, -1, {0} };
+    uint64_t total = 0;
+    int present[HASH_POLICY_COUNT] = {0};
+
+    if (tested) *tested = 0;
+    if (!mask_parse(mask, &base) || count <= 0) return 0;
+    uint64_t keyspace = mask_spec_keyspace(&base);
+    if (words) {
+        start = 0;
+        end = keyspace;
+    } else if (end == 0 || end > keyspace) {
+        end = keyspace;
+    }
+    if (start >= end) return 0;
+
+    TaggedIndex* tagged = (TaggedIndex*)malloc(sizeof(TaggedIndex) * count);
+    uint32_t* keys32 = (uint32_t*)malloc(sizeof(uint32_t) * count * 4);
+    int* norm_forms = (int*)malloc(sizeof(int) * count);
+    if (!tagged || !keys32 || !norm_forms) {
+        free(tagged);
+        free(keys32);
+        free(norm_forms);
+        return 0;
+    }
+    int n32 = 0;
+    for (int i = 0; i < count; i++) {
+        int form = (forms[i] >= 0 && forms[i] < HASH_POLICY_COUNT) ? forms[i] : HASH_FNV1_32;
+        norm_forms[i] = form;
+        tagged[i].value = form == HASH_HASH30 ? (values[i] & HASH30_MASK) : values[i];
+        tagged[i].form = form;
+        tagged[i].index = i;
+        present[form] = 1;
+        if (form == HASH_FNV1_32) {
+            keys32[n32++] = (uint32_t)values[i];
+        } else if (form == HASH_HASH30) {
+            uint32_t id = (uint32_t)values[i];
+            n32 += hash30_expand_targets(&id, 1, keys32 + n32);
+        }
+    }
+    qsort(tagged, count, sizeof(TaggedIndex), tagged_index_compare);
+    out.tagged = tagged;
+
+    for (int pass = 0; pass < HASH_POLICY_COUNT && out.count < max_found; pass++) {
+        if (pass == HASH_HASH30) continue;                  /* rides the FNV-1/32 pass */
+        if (pass == HASH_FNV1_32 && !present[HASH_FNV1_32] && !present[HASH_HASH30]) continue;
+        if (pass != HASH_FNV1_32 && !present[pass]) continue;
+
+        TargetFilter f32;
+        WideFilter wide;
+        if (pass == HASH_FNV1_32) {
+            if (!target_filter_build(&f32, keys32, n32, base.suffix, base.suffix_len)) break;
+        } else if (!wide_filter_build(&wide, values, norm_forms, count, pass,
+                                      base.suffix, base.suffix_len)) {
+            break;
+        }
+        out.pass = pass;
+
+        for (int w = 0; w < (words ? word_count : 1) && out.count < max_found; w++) {
+            MaskSpec m = base;
+            if (words && !mask_with_word(&base, words[w], NULL, &m)) continue;
+            uint64_t reached;
+            switch (pass) {
+                case HASH_FNV1A_32: reached = mask_kernel_fnv1a_32(&m, &wide, start, end, &out); break;
+                case HASH_FNV1_64:  reached = mask_kernel_fnv1_64(&m, &wide, start, end, &out); break;
+                default:            reached = mask_run(&m, &f32, backend, start, end, &out); break;
+            }
+            total += reached - start;
+        }
+
+        if (pass == HASH_FNV1_32) target_filter_free(&f32);
+        else free(wide.sorted);
+    }
+
+    free(tagged);
+    free(keys32);
+    free(norm_forms);
+    match_index_free(&out.seen);
+    if (tested) *tested = total;
+    return out.count;
+}
+
+/*
+ * Mask attack against tagged targets: values[i] is matched under
+ * forms[i] (HASH_*).  found_targets[k] is the index of the target hit by
+ * found_names[k]; found_hashes[k] holds the low 32 bits of its digest.
+ * FNV-1/32 + Hash30 run on `backend`, other forms on scalar kernels.
+ */
+EXPORT int mask_search_tagged(
+    const char* mask,
+    uint64_t start,
+    uint64_t end,
+    int backend,
+    const uint64_t* values,
+    const int* forms,
+    int count,
+    uint32_t* found_hashes,
+    char (*found_names)[32],
+    int* found_targets,
+    int max_found,
+    uint64_t* tested
+) {
+    return tagged_search(mask, NULL, 0, start, end, backend, values, forms, count,
+                         found_hashes, found_names, found_targets, max_found, tested);
+}
+
+/* Word + mask hybrid against tagged targets (see mask_search_tagged) */
+EXPORT int hybrid_search_tagged(
+    const char** words,
+    int word_count,
+    const char* mask,
+    int backend,
+    const uint64_t* values,
+    const int* forms,
+    int count,
+    uint32_t* found_hashes,
+    char (*found_names)[32],
+    int* found_targets,
+    int max_found,
+    uint64_t* tested
+) {
+    return tagged_search(mask, words, word_count, 0, 0, backend, values, forms, count,
+                         found_hashes, found_names, found_targets, max_found, tested);
+}
+
+/* ============================================================================
+ * TAGGED TARGET SETS
+ * Events are not the only FNV-named IDs in a bank: switch groups and
+ * switches, state groups and states, RTPCs, busses and the bank IDs
+ * themselves (23438015.bnk) are hashes of names too.  A TargetSet holds
+ * tens of thousands of mixed-class IDs with class / bank / form tags,
+ * looked up through the same TaggedIndex as the tagged mask searches.
+ * Engines only ever see target_set_ids() (one sorted array, Hash30 IDs
+ * pre-expanded), so every class is tested in the same pass at no
+ * per-candidate cost; tags are attached to the rare hits afterwards.
+ * ============================================================================ */
+
+#define TARGET_CLASS_EVENT          0
+#define TARGET_CLASS_SWITCH_GROUP   1
+#define TARGET_CLASS_SWITCH         2
+#define TARGET_CLASS_STATE_GROUP    3
+#define TARGET_CLASS_STATE          4
+#define TARGET_CLASS_RTPC           5
+#define TARGET_CLASS_BUS            6
+#define TARGET_CLASS_BANK           7
+#define TARGET_CLASS_COUNT          8
+
+#define TARGET_BANK_NONE            0xFFFF
+
+typedef struct {
+    uint32_t id;                /* value as stored in the bank (30-bit for HASH_HASH30) */
+    uint8_t cls;
+    uint8_t form;
+    uint16_t bank;              /* caller's bank index, TARGET_BANK_NONE if unknown */
+} TaggedTarget;
+
+typedef struct {
+    TaggedTarget* entries;      /* one per (id, form, class, bank) */
+    TaggedIndex* index;         /* (form, value) -> entry, sorted */
+    int count;
+    uint32_t* ids;              /* unique FNV-1/32 keys (Hash30 expanded), sorted */
+    int id_count;
+} TargetSet;
+
+static int tagged_target_compare(const void* a, const void* b) {
+    const TaggedTarget* x = (const TaggedTarget*)a;
+    const TaggedTarget* y = (const TaggedTarget*)b;
+    if (x->form != y->form) return x->form - y->form;
+    if (x->id != y->id) return x->id < y->id ? -1 : 1;
+    if (x->cls != y->cls) return x->cls - y->cls;
+    return x->bank - y->bank;
+}
+
+/*
+ * Build a set.  classes / banks / forms may be NULL (event, no bank,
+ * HASH_FNV1_32).  Only FNV-1/32 and Hash30 forms are accepted; Hash30 IDs
+ * are keyed by their 30-bit value and contribute their four 32-bit
+ * preimages to the engine ids.  Returns NULL on failure.
+ */
+EXPORT TargetSet* target_set_create(
+    const uint32_t* ids,
+    const uint8_t* classes,
+    const uint16_t* banks,
+    const uint8_t* forms,
+    int count
+) {
+    TargetSet* set = (TargetSet*)calloc(1, sizeof(TargetSet));
+    if (!set) return NULL;
+    set->entries = (TaggedTarget*)malloc(sizeof(TaggedTarget) * (count > 0 ? count : 1));
+    set->index = (TaggedIndex*)malloc(sizeof(TaggedIndex) * (count > 0 ? count : 1));
+    set->ids = (uint32_t*)malloc(sizeof(uint32_t) * (count > 0 ? count * 4 : 1));
+    if (!set->entries || !set->index || !set->ids) {
+        free(set->entries);
+        free(set->index);
+        free(set->ids);
+        free(set);
+        return NULL;
+    }
+
+    int n = 0;
+    for (int i = 0; i < count; i++) {
+        uint8_t form = forms ? forms[i] : HASH_FNV1_32;
+        if (form != HASH_HASH30 && form != HASH_FNV1_32) continue;
+        TaggedTarget* t = &set->entries[n++];
+        t->id = form == HASH_HASH30 ? ids[i] & HASH30_MASK : ids[i];
+        t->cls = classes ? (uint8_t)(classes[i] < TARGET_CLASS_COUNT ? classes[i] : TARGET_CLASS_EVENT)
+                         : TARGET_CLASS_EVENT;
+        t->form = form;
+        t->bank = banks ? banks[i] : TARGET_BANK_NONE;
+    }
+    qsort(set->entries, n, sizeof(TaggedTarget), tagged_target_compare);
+
+    /* drop exact duplicates; entries are in (form, value) order, so the index is too */
+    int unique = 0;
+    for (int i = 0; i < n; i++) {
+        if (unique > 0 && tagged_target_compare(&set->entries[unique - 1], &set->entries[i]) == 0) continue;
+        set->entries[unique++] = set->entries[i];
+    }
+    set->count = unique;
+
+    int nkeys = 0;
+    for (int i = 0; i < unique; i++) {
+        const TaggedTarget* t = &set->entries[i];
+        set->index[i].value = t->id;
+        set->index[i].form = t->form;
+        set->index[i].index = i;
+        if (t->form == HASH_HASH30) nkeys += hash30_expand_targets(&t->id, 1, set->ids + nkeys);
+        else set->ids[nkeys++] = t->id;
+    }
+    qsort(set->ids, nkeys, sizeof(uint32_t), uint32_compare);
+    for (int i = 0; i < nkeys; i++) {
+        if (set->id_count == 0 || set->ids[set->id_count - 1] != set->ids[i]) {
+            set->ids[set->id_count++] = set->ids[i];
+        }
+    }
+    return set;
+}
+
+EXPORT void target_set_free(TargetSet* set) {
+    if (!set) return;
+    free(set->entries);
+    free(set->index);
+    free(set->ids);
+    free(set);
+}
+
+/* Unique sorted FNV-1/32 keys of the set, ready for any engine's targets[] */
+EXPORT int target_set_ids(const TargetSet* set, uint32_t* out, int max_out) {
+    int n = set->id_count < max_out ? set->id_count : max_out;
+    memcpy(out, set->ids, sizeof(uint32_t) * n);
+    return set->id_count;
+}
+
+/*
+ * Entries hit by an FNV-1/32 hash, as itself and folded to Hash30 (one
+ * hash can be an event in one bank and a switch in another).  Writes up
+ * to max_out entry indices and returns the total number of hits.
+ */
+EXPORT int target_set_classify(const TargetSet* set, uint32_t h, int* entries, int max_out) {
+    const int forms[2] = { HASH_FNV1_32, HASH_HASH30 };
+    const uint32_t values[2] = { h, wwise_hash32_to_30(h) };
+    int n = 0;
+    for (int k = 0; k < 2; k++) {
+        for (int i = tagged_index_first(set->index, set->count, forms[k], values[k]);
+             i < set->count && set->index[i].form == forms[k] && set->index[i].value == values[k]; i++, n++) {
+            if (n < max_out) entries[n] = set->index[i].index;
+        }
+    }
+    return n;
+}
+
+/* Tags of one entry; returns 0 if the index is out of range */
+EXPORT int target_set_entry(const TargetSet* set, int index, uint32_t* id, int* cls, int* bank, int* form) {
+    if (index < 0 || index >= set->count) return 0;
+    if (id) *id = set->entries[index].id;
+    if (cls) *cls = set->entries[index].cls;
+    if (bank) *bank = set->entries[index].bank == TARGET_BANK_NONE ? -1 : set->entries[index].bank;
+    if (form) *form = set->entries[index].form;
+    return 1;
+}
+
+/* Per-class entry counts (counts[TARGET_CLASS_COUNT]) */
+EXPORT void target_set_stats(const TargetSet* set, int* counts) {
+    memset(counts, 0, sizeof(int) * TARGET_CLASS_COUNT);
+    for (int i = 0; i < set->count; i++) counts[set->entries[i].cls]++;
+}
+
+/*
+ * Mask attack against a whole tagged set in one pass.  found_entries[k]
+ * is the set entry hit by found_names[k] (see target_set_entry); a name
+ * hitting several classes is reported once per entry.
+ */
+EXPORT int mask_search_set(
+    const char* mask,
+    uint64_t start,
+    uint64_t end,
+    int backend,
+    const TargetSet* set,
+    uint32_t* found_hashes,
+    char (*found_names)[32],
+    int* found_entries,
+    int max_found,
+    uint64_t* tested
+) {
+    uint32_t* hashes = (uint32_t*)malloc(sizeof(uint32_t) * (max_found > 0 ? max_found : 1));
+    char (*names)[32] = (char (*)[32])malloc(32 * (size_t)(max_found > 0 ? max_found : 1));
+    int found = 0;
+
+    if (tested) *tested = 0;
+    if (!hashes || !names) {
+        free(hashes);
+        free(names);
+        return 0;
+    }
+
+    int n = mask_search(mask, start, end, backend, set->ids, set->id_count,
+                        hashes, names, max_found, tested);
+    for (int k = 0; k < n && found < max_found; k++) {
+        int hit = target_set_classify(set, hashes[k], found_entries + found, max_found - found);
+        for (int i = 0; i < hit && found < max_found; i++) {
+            found_hashes[found] = hashes[k];
+            strcpy(found_names[found++], names[k]);
+        }
+    }
+
+    free(hashes);
+    free(names);
+    return found;
+}
+
+/* ============================================================================
+ * BANK-ROUTED ATTACKS
+ * Testing every candidate against every bank's targets wastes the
+ * filter on IDs the candidate cannot plausibly be, and every extra target
+ * is another chance of a collision.  A route is one attack unit:
+ * (vocabulary words, masks/grammar, bank target subset).  Each route gets
+ * its own small TargetFilter, so a catapult/crank word is only ever
+ * checked against SFXCatapult IDs.  Words and masks tagged -1 are shared
+ * and run in every route (generic verbs like play_/stop_).
+ * ============================================================================ */
+
+/*
+ * word_routes[i] / mask_routes[i] / target_routes[i] give the route of
+ * each entry (0..route_count-1, -1 = every route for words and masks).
+ * An empty mask ("") tests the bare words.  found_routes[k] is the route
+ * that produced hit k.
+ */
+EXPORT int route_search(
+    const char** words,
+    const int* word_routes,
+    int word_count,
+    const char** masks,
+    const int* mask_routes,
+    int mask_count,
+    const uint32_t* targets,
+    const int* target_routes,
+    int target_count,
+    int route_count,
+    int backend,
+    uint32_t* found_hashes,
+    char (*found_names)[32],
+    int* found_routes,
+    int max_found,
+    uint64_t* tested
+) {
+    MatchList out = { found_hashes, found_names, 0, max_found, NULL, 0, HASH_FNV1_32, NULL, found_routes, -1, {0} };
+    uint32_t* subset = (uint32_t*)malloc(sizeof(uint32_t) * (target_count > 0 ? target_count : 1));
+    uint64_t total = 0;
+
+    if (tested) *tested = 0;
+    if (!subset) return 0;
+
+    for (int r = 0; r < route_count && out.count < max_found; r++) {
+        int n = 0;
+        for (int i = 0; i < target_count; i++) {
+            if (target_routes[i] == r) subset[n++] = targets[i];
+        }
+        if (n == 0) continue;
+        out.seed = r;
+
+        for (int k = 0; k < mask_count && out.count < max_found; k++) {
+            MaskSpec base;
+            TargetFilter f;
+            if (mask_routes[k] != r && mask_routes[k] != -1) continue;
+            if (!mask_parse(masks[k], &base)) continue;
+            if (!target_filter_build(&f, subset, n, base.suffix, base.suffix_len)) break;
+            uint64_t keyspace = mask_spec_keyspace(&base);
+
+            for (int w = 0; w < word_count && out.count < max_found; w++) {
+                MaskSpec m;
+                if (word_routes[w] != r && word_routes[w] != -1) continue;
+                if (!mask_with_word(&base, words[w], NULL, &m)) continue;
+                total += mask_run(&m, &f, backend, 0, keyspace, &out);
+            }
+            target_filter_free(&f);
+        }
+    }
+
+    free(subset);
+    match_index_free(&out.seen);
+    if (tested) *tested = total;
+    return out.count;
+}
+
+/* ============================================================================
+ * COLLISION PLAUSIBILITY SCORER
+ * Long sweeps mostly find collisions (7-char brute force: 444 hits, none
+ * real).  Every hit is rated 0-1000 from four components:
+ *   ngram      character trigram log-likelihood under a model trained on
+ *              known names / dictionary terms ('^' and '$' boundaries,
+ *              digits share one symbol, add-one smoothing)
+ *   coverage   share of the name's letters covered by vocabulary words
+ *              (tokens split on '_' / digits, glued words segmented)
+ *   bank       a vocabulary word of the hit's own bank appears (1000),
+ *              no bank evidence (500), only other banks' words (0)
+ *   structure  Wwise naming rules: leading letter, no '__', no trailing
+ *              '_', short digit groups, no long consonant / repeat runs
+ * score_triage() drops duplicate names, ranks the rest and moves hits
+ * below min_score (or far below the best name of the same hash) into a
+ * suppressed bucket, so a collision flood shrinks to a shortlist.
+ * ============================================================================ */
+
+#define SCORE_SYMBOLS       29      /* a-z, '_', digit, boundary */
+#define SCORE_BOUNDARY      28
+#define SCORE_NGRAM         0
+#define SCORE_COVERAGE      1
+#define SCORE_BANK          2
+#define SCORE_STRUCTURE     3
+#define SCORE_COMPONENTS    4
+
+typedef struct {
+    uint32_t hash;              /* FNV-1/32 of the word */
+    int bank;                   /* caller's bank index, -1 = any bank */
+} ScoreWord;
+
+typedef struct {
+    uint32_t trigrams[SCORE_SYMBOLS * SCORE_SYMBOLS * SCORE_SYMBOLS];
+    uint32_t contexts[SCORE_SYMBOLS * SCORE_SYMBOLS];
+    int trained;
+    ScoreWord* words;           /* sorted by (hash, bank) */
+    int word_count;
+} ScoreModel;
+
+static int score_symbol(char c) {
+    c = (char)tolower(c);
+    if (c >= 'a' && c <= 'z') return c - 'a';
+    if (c >= '0' && c <= '9') return 27;
+    if (c == '_') return 26;
+    return -1;
+}
+
+static int score_word_compare(const void* a, const void* b) {
+    const ScoreWord* x = (const ScoreWord*)a;
+    const ScoreWord* y = (const ScoreWord*)b;
+    if (x->hash != y->hash) return x->hash < y->hash ? -1 : 1;
+    return x->bank - y->bank;
+}
+
+/*
+ * Vocabulary lookup.  Returns 0 if the word is unknown, else a bit set:
+ * 1 = known, 2 = tagged with `bank`, 4 = tagged only with other banks.
+ */
+static int score_lookup(const ScoreModel* model, uint32_t h, int bank) {
+    int lo = 0, hi = model->word_count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (model->words[mid].hash < h) lo = mid + 1;
+        else hi = mid;
+    }
+    int flags = 0, shared = 0;
+    for (; lo < model->word_count && model->words[lo].hash == h; lo++) {
+        flags |= 1;
+        if (model->words[lo].bank == -1) shared = 1;
+        else if (bank >= 0 && model->words[lo].bank == bank) flags |= 2;
+        else flags |= 4;
+    }
+    if ((flags & 2) || shared) flags &= ~4;
+    return flags;
+}
+
+/* Mean log2 P(c | two previous chars) over the name, mapped to 0..1000 */
+static int score_ngram(const ScoreModel* model, const char* name) {
+    if (!model->trained) return 500;
+    int a = SCORE_BOUNDARY, b = SCORE_BOUNDARY, n = 0;
+    double lp = 0.0;
+    for (const char* p = name;; p++) {
+        int c = *p ? score_symbol(*p) : SCORE_BOUNDARY;
+        if (c < 0) return 0;
+        uint32_t tri = model->trigrams[(a * SCORE_SYMBOLS + b) * SCORE_SYMBOLS + c];
+        uint32_t ctx = model->contexts[a * SCORE_SYMBOLS + b];
+        lp += log2((tri + 1.0) / (ctx + SCORE_SYMBOLS));
+        n++;
+        if (!*p) break;
+        a = b;
+        b = c;
+    }
+    /* uniform over 29 symbols is ~-4.9 bits/char, real names sit near -2.5 */
+    double s = (lp / n + 4.5) / 2.5;
+    if (s < 0.0) s = 0.0;
+    if (s > 1.0) s = 1.0;
+    return (int)(s * 1000.0);
+}
+
+/*
+ * Letters covered by vocabulary words plus bank evidence.  Each letter
+ * run is segmented into known words of 2+ chars (keepfighting -> keep +
+ * fighting); single-letter runs (_a, _b variants) count as covered and
+ * runs over SCORE_MAX_RUN letters as uncovered.
+ */
+#define SCORE_MAX_RUN 63         /* longest letter run segmented into words */
+
+static void score_tokens(const ScoreModel* model, const char* name, int bank,
+                         int* coverage, int* bank_score) {
+    int letters = 0, covered = 0, own = 0, foreign = 0;
+    int len = (int)strlen(name);
+
+    for (int i = 0; i < len;) {
+        if (!isalpha((unsigned char)name[i])) {
+            i++;
+            continue;
+        }
+        int start = i;
+        while (i < len && isalpha((unsigned char)name[i])) i++;
+        int run = i - start;
+        letters += run;
+        if (run == 1) {
+            /* only a whole '_' token (_a, _b variants) is a plausible lone letter */
+            if ((start == 0 || name[start - 1] == '_') && (i == len || name[i] == '_')) covered++;
+            continue;
+        }
+
+        if (run > SCORE_MAX_RUN) continue;
+
+        int best[SCORE_MAX_RUN + 1] = {0};
+        int own_at[SCORE_MAX_RUN + 1] = {0}, foreign_at[SCORE_MAX_RUN + 1] = {0};
+        for (int e = 1; e <= run; e++) {
+            best[e] = best[e - 1];
+            own_at[e] = own_at[e - 1];
+            foreign_at[e] = foreign_at[e - 1];
+            for (int s = e - 2; s >= 0; s--) {
+                int flags = score_lookup(model, wwise_hash_len(name + start + s, e - s), bank);
+                if (flags && best[s] + (e - s) > best[e]) {
+                    best[e] = best[s] + (e - s);
+                    own_at[e] = own_at[s] | ((flags & 2) != 0);
+                    foreign_at[e] = foreign_at[s] | ((flags & 4) != 0);
+                }
+            }
+        }
+        covered += best[run];
+        own |= own_at[run];
+        foreign |= foreign_at[run];
+    }
+
+    *coverage = letters ? covered * 1000 / letters : 500;
+    *bank_score = own ? 1000 : (foreign ? 0 : 500);
+}
+
+/* Structural rules; every violation costs a share of the 1000 points */
+static int score_structure(const char* name) {
+    int len = (int)strlen(name), score = 1000;
+    int consonants = 0, repeat = 1, digits = 0, switches = 0;
+
+    if (len == 0) return 0;
+    if (!isalpha((unsigned char)name[0])) score -= 400;
+    if (name[len - 1] == '_') score -= 300;
+    for (int i = 0; i < len; i++) {
+        char c = (char)tolower(name[i]);
+        if (score_symbol(c) < 0) return 0;
+        repeat = (i > 0 && c == tolower(name[i - 1])) ? repeat + 1 : 1;
+        if (repeat == 3 && c != '0') score -= 250;
+        if (c == '_' && i > 0 && name[i - 1] == '_') score -= 300;
+
+        digits = isdigit((unsigned char)c) ? digits + 1 : 0;
+        if (digits == 5) score -= 250;
+        /* one letter/digit switch per token (uruk1, obj011) is normal, more is noise */
+        if (c == '_') switches = 0;
+        else if (i > 0 && name[i - 1] != '_' &&
+                 !isdigit((unsigned char)c) != !isdigit((unsigned char)name[i - 1]) && ++switches > 1) {
+            score -= 200;
+        }
+
+        if (isalpha((unsigned char)c) && !is_vowel(c) && c != 'y') consonants++;
+        else consonants = 0;
+        if (consonants == 5) score -= 300;
+    }
+    return score > 0 ? score : 0;
+}
+
+/*
+ * Build a model.  corpus trains the trigram model (known names, dictionary
+ * terms); words / word_banks is the token vocabulary (word_banks may be
+ * NULL, -1 = shared by every bank).  Returns NULL on failure.
+ */
+EXPORT ScoreModel* score_model_create(
+    const char** corpus,
+    int corpus_count,
+    const char** words,
+    const int* word_banks,
+    int word_count
+) {
+    ScoreModel* model = (ScoreModel*)calloc(1, sizeof(ScoreModel));
+    if (!model) return NULL;
+    model->words = (ScoreWord*)malloc(sizeof(ScoreWord) * (word_count > 0 ? word_count : 1));
+    if (!model->words) {
+        free(model);
+        return NULL;
+    }
+
+    for (int i = 0; i < corpus_count; i++) {
+        int a = SCORE_BOUNDARY, b = SCORE_BOUNDARY;
+        for (const char* p = corpus[i];; p++) {
+            int c = *p ? score_symbol(*p) : SCORE_BOUNDARY;
+            if (c < 0) break;
+            model->trigrams[(a * SCORE_SYMBOLS + b) * SCORE_SYMBOLS + c]++;
+            model->contexts[a * SCORE_SYMBOLS + b]++;
+            model->trained = 1;
+            if (!*p) break;
+            a = b;
+            b = c;
+        }
+    }
+
+    for (int i = 0; i < word_count; i++) {
+        if (strlen(words[i]) < 2) continue;
+        model->words[model->word_count].hash = wwise_hash(words[i]);
+        model->words[model->word_count++].bank = word_banks ? word_banks[i] : -1;
+    }
+    qsort(model->words, model->word_count, sizeof(ScoreWord), score_word_compare);
+    return model;
+}
+
+EXPORT void score_model_free(ScoreModel* model) {
+    if (!model) return;
+    free(model->words);
+    free(model);
+}
+
+/*
+ * Plausibility of one name (0-1000) for a hit in `bank` (-1 = unknown).
+ * components[SCORE_COMPONENTS] may be NULL.
+ */
+EXPORT int score_name(const ScoreModel* model, const char* name, int bank, int* components) {
+    int c[SCORE_COMPONENTS];
+    c[SCORE_NGRAM] = score_ngram(model, name);
+    score_tokens(model, name, bank, &c[SCORE_COVERAGE], &c[SCORE_BANK]);
+    c[SCORE_STRUCTURE] = score_structure(name);
+    if (components) memcpy(components, c, sizeof(c));
+
+    int total = (35 * c[SCORE_NGRAM] + 35 * c[SCORE_COVERAGE] +
+                 10 * c[SCORE_BANK] + 20 * c[SCORE_STRUCTURE]) / 100;
+    /* a name that breaks the naming rules outright never makes the shortlist */
+    return c[SCORE_STRUCTURE] < 500 ? total / 2 : total;
+}
+
+typedef struct {
+    int index;
+    int score;
+    int best;                   /* best score among names of the same hash */
+    uint32_t hash;
+    const char* name;           /* names[index], so the sorts need no shared context */
+} ScoredHit;
+
+static int scored_hash_compare(const void* a, const void* b) {
+    const ScoredHit* x = (const ScoredHit*)a;
+    const ScoredHit* y = (const ScoredHit*)b;
+    if (x->hash != y->hash) return x->hash < y->hash ? -1 : 1;
+    int c = strcmp(x->name, y->name);
+    return c ? c : x->index - y->index;
+}
+
+static int scored_rank_compare(const void* a, const void* b) {
+    const ScoredHit* x = (const ScoredHit*)a;
+    const ScoredHit* y = (const ScoredHit*)b;
+    if (x->score != y->score) return y->score - x->score;
+    return strcmp(x->name, y->name);
+}
+
+static int scored_hit_kept(const ScoredHit* h, int min_score, int margin) {
+    return h->score >= min_score && (margin < 0 || h->score >= h->best - margin);
+}
+
+/*
+ * Triage a result stream.  banks[i] is the hit's bank index (banks may be
+ * NULL).  scores[i] receives every hit's score (-1 for dropped duplicate
+ * names).  order[] receives the kept hits best first, followed by the
+ * suppressed bucket (also best first): hits under min_score, or more than
+ * `margin` below the best name found for the same hash (margin < 0
+ * disables that rule).  Returns the kept count; *suppressed gets the size
+ * of the bucket.
+ */
+EXPORT int score_triage(
+    const ScoreModel* model,
+    const uint32_t* hashes,
+    const char (*names)[32],
+    const int* banks,
+    int count,
+    int min_score,
+    int margin,
+    int* scores,
+    int* order,
+    int* suppressed
+) {
+    ScoredHit* hits = (ScoredHit*)malloc(sizeof(ScoredHit) * (count > 0 ? count : 1));
+    int n = 0, kept = 0, dropped = 0;
+
+    if (suppressed) *suppressed = 0;
+    if (!hits) return 0;
+
+    for (int i = 0; i < count; i++) {
+        hits[i].index = i;
+        hits[i].hash = hashes[i];
+        hits[i].name = names[i];
+        hits[i].score = scores[i] = score_name(model, names[i], banks ? banks[i] : -1, NULL);
+    }
+
+    /* group by hash: drop repeated names, note each hash's best score */
+    qsort(hits, count, sizeof(ScoredHit), scored_hash_compare);
+    for (int k = 0; k < count; k++) {
+        if (n > 0 && hits[n - 1].hash == hits[k].hash && strcmp(hits[n - 1].name, hits[k].name) == 0) {
+            scores[hits[k].index] = -1;
+            continue;
+        }
+        hits[n++] = hits[k];
+    }
+    for (int k = 0, g = 0; k <= n; k++) {
+        if (k < n && hits[k].hash == hits[g].hash) continue;
+        int best = 0;
+        for (int j = g; j < k; j++) best = hits[j].score > best ? hits[j].score : best;
+        for (int j = g; j < k; j++) hits[j].best = best;
+        g = k;
+    }
+
+    qsort(hits, n, sizeof(ScoredHit), scored_rank_compare);
+    for (int k = 0; k < n; k++) {
+        if (scored_hit_kept(&hits[k], min_score, margin)) order[kept++] = hits[k].index;
+    }
+    for (int k = 0; k < n; k++) {
+        if (!scored_hit_kept(&hits[k], min_score, margin)) order[kept + dropped++] = hits[k].index;
+    }
+
+    free(hits);
+    if (suppressed) *suppressed = dropped;
+    return kept;
+}
+
+/* ============================================================================
+ * PRIORITY-WEIGHTED ATTACK SCHEDULER
+ * Targets carry weights (play counts from gameplay logs), attacks in the
+ * portfolio carry an expected yield.  Mask / hybrid attacks are cut into
+ * slices of their index range and handed to workers by stride scheduling:
+ * an attack's pass advances by slice / (yield * live weight of its
+ * targets), the lowest pass runs next, so CPU time follows
+ * yield x weight.  A cracked target is pruned from every attack at once:
+ * the live weights drop and each attack covering it rebuilds its
+ * TargetFilter at its next slice boundary (workers still on the old filter
+ * keep it alive by reference count).  A slice that fills its match buffer
+ * is re-run with a bigger one, so no hit is lost short of
+ * SCHED_MAX_FOUND.  With a ScoreModel, only hits scoring >= prune_score
+ * prune their target, so a collision cannot retire a real one.
+ * ============================================================================ */
+
+#define SCHED_DEFAULT_SLICE ((uint64_t)1 << 22)
+#define SCHED_MAX_FOUND     (1 << 20)       /* per-slice match buffer cap */
+
+typedef struct {
+    TargetFilter f;
+    int refs;
+    int version;
+} SchedFilter;
+
+typedef struct {
+    MaskSpec base;
+    uint64_t mask_keyspace;
+    int* words;                 /* hybrid word indices (NULL = plain mask) */
+    int word_count;
+    uint64_t keyspace;
+    uint64_t next;
+    int route;                  /* -1 = every target */
+    double yield;
+    double live_weight;
+    double pass;
+    uint64_t tested;
+    int version;                /* bumped when one of its targets is pruned */
+    SchedFilter* filter;
+} SchedAttack;
+
+typedef struct {
+    fnv_mutex_t lock;
+    SchedAttack* attacks;
+    int attack_count;
+    const char** words;
+    const uint32_t* targets;
+    const double* weights;
+    const int* target_routes;
+    int target_count;
+    uint8_t* live;
+    int live_count;
+    int backend;
+    uint64_t slice;
+    double deadline;            /* fnv_now() limit, 0 = none */
+    const ScoreModel* model;
+    int prune_score;
+
+    uint32_t* found_hashes;
+    char (*found_names)[32];
+    int* found_attacks;
+    int found;
+    int max_found;
+    MatchIndex seen;
+    int overflow;               /* slices whose hits did not fit SCHED_MAX_FOUND */
+    int slot;                   /* first worker slot (NUMA placement) */
+    volatile long next_worker;
+} Scheduler;
+
+static int sched_covers(const Scheduler* s, const SchedAttack* a, int t) {
+    return a->route == -1 || (s->target_routes && s->target_routes[t] == a->route);
+}
+
+/* Fresh filter over the attack's live targets (called with the lock held) */
+static SchedFilter* sched_filter_build(Scheduler* s, const SchedAttack* a) {
+    SchedFilter* sf = (SchedFilter*)calloc(1, sizeof(SchedFilter));
+    uint32_t* subset = (uint32_t*)malloc(sizeof(uint32_t) * (s->target_count > 0 ? s->target_count : 1));
+    int n = 0;
+
+    if (!sf || !subset) {
+        free(sf);
+        free(subset);
+        return NULL;
+    }
+    for (int t = 0; t < s->target_count; t++) {
+        if (s->live[t] && sched_covers(s, a, t)) subset[n++] = s->targets[t];
+    }
+    if (!target_filter_build(&sf->f, subset, n, a->base.suffix, a->base.suffix_len)) {
+        free(sf);
+        sf = NULL;
+    } else {
+        sf->version = a->version;
+    }
+    free(subset);
+    return sf;
+}
+
+static void sched_filter_release(SchedAttack* a, SchedFilter* sf) {
+    if (sf && --sf->refs == 0 && sf != a->filter) {
+        target_filter_free(&sf->f);
+        free(sf);
+    }
+}
+
+/* Record a slice's hits and prune the targets they crack (lock held) */
+static void sched_commit(Scheduler* s, int attack, const MatchList* hits) {
+    for (int k = 0; k < hits->count; k++) {
+        s->found = record_unique_match(hits->hashes[k], hits->names[k], attack, s->found_hashes,
+                                       s->found_names, s->found_attacks, s->found, s->max_found,
+                                       &s->seen);
+        if (s->model && score_name(s->model, hits->names[k], -1, NULL) < s->prune_score) continue;
+
+        for (int t = 0; t < s->target_count; t++) {
+            if (!s->live[t] || s->targets[t] != hits->hashes[k]) continue;
+            s->live[t] = 0;
+            s->live_count--;
+            for (int i = 0; i < s->attack_count; i++) {
+                if (!sched_covers(s, &s->attacks[i], t)) continue;
+                s->attacks[i].live_weight -= s->weights[t];
+                s->attacks[i].version++;
+            }
+        }
+    }
+}
+
+/* Runnable attack with the lowest pass, or -1 */
+static int sched_pick(const Scheduler* s) {
+    int best = -1;
+    for (int i = 0; i < s->attack_count; i++) {
+        const SchedAttack* a = &s->attacks[i];
+        if (a->next >= a->keyspace || a->live_weight <= 1e-9) continue;
+        if (best < 0 || a->pass < s->attacks[best].pass) best = i;
+    }
+    return best;
+}
+
+THREAD_FUNC(sched_worker, arg) {
+    Scheduler* s = (Scheduler*)arg;
+    int cap = 64;
+    uint32_t* hashes = (uint32_t*)malloc(sizeof(uint32_t) * cap);
+    char (*names)[32] = (char (*)[32])malloc(32 * (size_t)cap);
+
+    numa_pin_worker(s->slot + (int)ATOMIC_FETCH_ADD(&s->next_worker, 1));
+    for (;;) {
+        fnv_mutex_lock(&s->lock);
+        int i = (s->found < s->max_found && s->live_count > 0 &&
+                 (s->deadline == 0 || fnv_now() < s->deadline)) ? sched_pick(s) : -1;
+        if (i < 0) {
+            fnv_mutex_unlock(&s->lock);
+            break;
+        }
+        SchedAttack* a = &s->attacks[i];
+        if (!a->filter || a->filter->version != a->version) {
+            SchedFilter* fresh = sched_filter_build(s, a);
+            if (!fresh) {
+                a->next = a->keyspace;
+                fnv_mutex_unlock(&s->lock);
+                continue;
+            }
+            SchedFilter* old = a->filter;
+            a->filter = fresh;
+            fresh->refs = 1;
+            sched_filter_release(a, old);
+        }
+        SchedFilter* sf = a->filter;
+        sf->refs++;
+
+        /* a slice never crosses a hybrid word boundary */
+        uint64_t start = a->next;
+        uint64_t word_end = (start / a->mask_keyspace + 1) * a->mask_keyspace;
+        uint64_t end = start + s->slice;
+        if (end > word_end) end = word_end;
+        if (end > a->keyspace) end = a->keyspace;
+        a->next = end;
+        a->pass += (double)(end - start) / (a->yield * a->live_weight);
+        fnv_mutex_unlock(&s->lock);
+
+        /* a slice that fills the match buffer is re-run with a bigger one */
+        MaskSpec m = a->base;
+        int runnable = !a->words ||
+                       mask_with_word(&a->base, s->words[a->words[start / a->mask_keyspace]], NULL, &m);
+        uint64_t lo = start % a->mask_keyspace, hi = (end - 1) % a->mask_keyspace + 1;
+        MatchList out = { hashes, names, 0, hashes && names ? cap : 0, NULL, 0, HASH_FNV1_32, NULL, NULL, -1, {0} };
+        while (runnable) {
+            uint64_t reached = mask_run(&m, &sf->f, s->backend, lo, hi, &out);
+            if (reached == hi && out.count < out.max) break;
+            uint32_t* grown_hashes = cap < SCHED_MAX_FOUND ? (uint32_t*)realloc(hashes, sizeof(uint32_t) * cap * 2) : NULL;
+            if (grown_hashes) hashes = grown_hashes;
+            char (*grown_names)[32] = grown_hashes ? (char (*)[32])realloc(names, 64 * (size_t)cap) : NULL;
+            if (!grown_names) break;
+            names = grown_names;
+            cap *= 2;
+            match_index_free(&out.seen);
+            MatchList fresh = { hashes, names, 0, cap, NULL, 0, HASH_FNV1_32, NULL, NULL, -1, {0} };
+            out = fresh;
+        }
+
+        fnv_mutex_lock(&s->lock);
+        a->tested += end - start;
+        if (out.count == out.max && runnable) s->overflow++;
+        sched_commit(s, i, &out);
+        sched_filter_release(a, sf);
+        fnv_mutex_unlock(&s->lock);
+        match_index_free(&out.seen);
+    }
+    free(hashes);
+    free(names);
+    THREAD_RETURN;
+}
+
+/*
+ * Run a weighted attack portfolio.  Attack k is masks[k], optionally
+ * hybridised with every words[i] whose word_attacks[i] == k; it sees the
+ * targets whose target_routes[t] == attack_routes[k] (attack_routes NULL or
+ * -1 = all targets).  yields[k] (NULL = 1.0) and weights[t] (NULL = 1.0)
+ * set the CPU shares.  Stops when every attack is exhausted or pruned,
+ * every target is cracked, max_found hits are recorded or max_seconds of
+ * wall time pass (0 = no limit).  model may be NULL (every hit prunes).
+ * found_attacks[k] is the attack of hit k; attack_tested[k] (optional) is
+ * the candidates attack k ran; cracked[t] (optional) is 1 for pruned
+ * targets; overflow (optional) counts slices whose hits outgrew
+ * SCHED_MAX_FOUND, so some matches were dropped.  slice 0 uses the
+ * default, num_threads <= 0 every core.
+ */
+EXPORT int schedule_search(
+    const char** masks,
+    const int* attack_routes,
+    const double* yields,
+    int attack_count,
+    const char** words,
+    const int* word_attacks,
+    int word_count,
+    const uint32_t* targets,
+    const double* weights,
+    const int* target_routes,
+    int target_count,
+    int backend,
+    int num_threads,
+    uint64_t slice,
+    double max_seconds,
+    const ScoreModel* model,
+    int prune_score,
+    uint32_t* found_hashes,
+    char (*found_names)[32],
+    int* found_attacks,
+    int max_found,
+    uint64_t* attack_tested,
+    uint8_t* cracked,
+    uint64_t* tested,
+    int* overflow
+) {
+    fnv_thread_t threads[MAX_THREADS];
+    Scheduler s;
+    double* unit = NULL;
+
+    memset(&s, 0, sizeof(s));
+    if (tested) *tested = 0;
+    if (overflow) *overflow = 0;
+    s.attacks = (SchedAttack*)calloc(attack_count > 0 ? attack_count : 1, sizeof(SchedAttack));
+    s.live = (uint8_t*)malloc(target_count > 0 ? target_count : 1);
+    if (!weights) {
+        unit = (double*)malloc(sizeof(double) * (target_count > 0 ? target_count : 1));
+        for (int t = 0; unit && t < target_count; t++) unit[t] = 1.0;
+    }
+    if (!s.attacks || !s.live || (!weights && !unit)) {
+        free(s.attacks);
+        free(s.live);
+        free(unit);
+        return 0;
+    }
+
+    s.words = words;
+    s.targets = targets;
+    s.weights = weights ? weights : unit;
+    s.target_routes = target_routes;
+    s.target_count = target_count;
+    memset(s.live, 1, target_count);
+    s.live_count = target_count;
+    s.backend = backend;
+    s.slice = slice ? slice : SCHED_DEFAULT_SLICE;
+    s.deadline = max_seconds > 0 ? fnv_now() + max_seconds : 0;
+    s.model = model;
+    s.prune_score = prune_score;
+    s.found_hashes = found_hashes;
+    s.found_names = found_names;
+    s.found_attacks = found_attacks;
+    s.max_found = max_found;
+    s.attack_count = attack_count;
+
+    for (int k = 0; k < attack_count; k++) {
+        SchedAttack* a = &s.attacks[k];
+        a->route = attack_routes ? attack_routes[k] : -1;
+        a->yield = yields && yields[k] > 0 ? yields[k] : 1.0;
+        if (!mask_parse(masks[k], &a->base)) continue;
+        a->mask_keyspace = mask_spec_keyspace(&a->base);
+        for (int i = 0; i < word_count; i++) {
+            if (word_attacks[i] != k) continue;
+            if (!a->words) a->words = (int*)malloc(sizeof(int) * word_count);
+            if (a->words) a->words[a->word_count++] = i;
+        }
+        a->keyspace = a->words ? keyspace_mul(a->mask_keyspace, (uint64_t)a->word_count) : a->mask_keyspace;
+        for (int t = 0; t < target_count; t++) {
+            if (sched_covers(&s, a, t)) a->live_weight += s.weights[t];
+        }
+    }
+
+    fnv_mutex_init(&s.lock);
+    num_threads = resolve_thread_count(num_threads);
+    s.slot = numa_reserve_slots(num_threads);
+    int started = 0;
+    for (; started < num_threads; started++) {
+        if (!fnv_thread_start(&threads[started], sched_worker, &s)) break;
+    }
+    for (int t = 0; t < started; t++) fnv_thread_join(threads[t]);
+    fnv_mutex_destroy(&s.lock);
+
+    for (int k = 0; k < attack_count; k++) {
+        SchedAttack* a = &s.attacks[k];
+        if (attack_tested) attack_tested[k] = a->tested;
+        if (tested) *tested += a->tested;
+        if (a->filter) {
+            target_filter_free(&a->filter->f);
+            free(a->filter);
+        }
+        free(a->words);
+    }
+    if (cracked) {
+        for (int t = 0; t < target_count; t++) cracked[t] = !s.live[t];
+    }
+    if (overflow) *overflow = s.overflow;
+
+    match_index_free(&s.seen);
+    free(s.attacks);
+    free(s.live);
+    free(unit);
+    return s.found;
+}
+
+/* ============================================================================
+ * ATTACK PLANNER
+ * Every mask / hybrid attack in a catalog gets an exact keyspace, a
+ * runtime from measured kernel throughput on this machine, the expected
+ * false positives (keyspace x targets / 2^32) and the expected real
+ * cracks: the share of known names the attack would have produced
+ * (its empirical coverage) x the targets it runs against.  Attacks are
+ * ranked by real cracks per second and filled into the budget greedily;
+ * yield is uniform over a keyspace, so the attack that overflows the
+ * budget runs for the remaining fraction (fractional knapsack, optimal).
+ * ============================================================================ */
+
+typedef struct {
+    uint64_t keyspace;
+    double seconds;             /* predicted runtime of the whole keyspace */
+    double false_positives;
+    double expected_real;
+    double real_per_second;
+    double fraction;            /* share of the keyspace the budget covers */
+} AttackPlan;
+
+/* Does a (lowercased) name lie in the mask keyspace? */
+static int mask_spec_covers(const MaskSpec* m, const char* name, int len) {
+    if (len != m->prefix_len + m->positions + m->suffix_len) return 0;
+    if (memcmp(name, m->prefix, m->prefix_len) != 0) return 0;
+    for (int i = 0; i < m->positions; i++) {
+        if (!memchr(m->sets[i], name[m->prefix_len + i], m->set_lens[i])) return 0;
+    }
+    return memcmp(name + m->prefix_len + m->positions, m->suffix, m->suffix_len) == 0;
+}
+
+static int attack_plan_compare_index(const AttackPlan* plans, int a, int b) {
+    if (plans[a].real_per_second != plans[b].real_per_second) {
+        return plans[a].real_per_second > plans[b].real_per_second ? -1 : 1;
+    }
+    return a - b;
+}
+
+/*
+ * Plan a catalog.  Attack k is masks[k], hybridised with every words[i]
+ * whose word_attacks[i] == k; it runs against attack_targets[k] targets
+ * (NULL = target_count each).  known[] are cracked names for coverage.
+ * throughput is candidates/second for the whole machine; <= 0 measures
+ * `backend` with kernel_benchmark on every core (wall time).  plans[k] receives the
+ * estimates, order[] the attacks best first.  Returns how many attacks
+ * (a prefix of order[]) the budget reaches; budget_seconds <= 0 takes all.
+ */
+EXPORT int plan_attacks(
+    const char** masks,
+    int attack_count,
+    const char** words,
+    const int* word_attacks,
+    int word_count,
+    const int* attack_targets,
+    int target_count,
+    const char** known,
+    int known_count,
+    int backend,
+    double throughput,
+    double budget_seconds,
+    AttackPlan* plans,
+    int* order
+) {
+    char (*lowered)[32] = (char (*)[32])malloc(32 * (size_t)(known_count > 0 ? known_count : 1));
+    int* lens = (int*)malloc(sizeof(int) * (known_count > 0 ? known_count : 1));
+    uint32_t* word_hashes = (uint32_t*)malloc(sizeof(uint32_t) * (word_count > 0 ? word_count : 1));
+    if (!lowered || !lens || !word_hashes) {
+        free(lowered);
+        free(lens);
+        free(word_hashes);
+        return 0;
+    }
+    for (int i = 0; i < known_count; i++) {
+        int n = 0;
+        for (const char* p = known[i]; *p && n < 31; p++) lowered[i][n++] = (char)tolower(*p);
+        lowered[i][n] = '\0';
+        lens[i] = n;
+    }
+    if (throughput <= 0) {
+        throughput = kernel_benchmark(backend, 6, target_count > 0 ? target_count : 1, 0.25, 0);
+    }
+
+    for (int k = 0; k < attack_count; k++) {
+        AttackPlan* p = &plans[k];
+        MaskSpec m;
+        int targets = attack_targets ? attack_targets[k] : target_count;
+        int words_used = 0, covered = 0;
+
+        memset(p, 0, sizeof(*p));
+        order[k] = k;
+        if (!mask_parse(masks[k], &m)) continue;
+        uint64_t mask_keyspace = mask_spec_keyspace(&m);
+
+        for (int i = 0; i < word_count; i++) {
+            if (word_attacks[i] == k) word_hashes[words_used++] = wwise_hash(words[i]);
+        }
+        qsort(word_hashes, words_used, sizeof(uint32_t), uint32_compare);
+        p->keyspace = words_used ? keyspace_mul(mask_keyspace, (uint64_t)words_used) : mask_keyspace;
+
+        /* the mask part has a fixed length, so a hybrid's word is the name's head */
+        int tail = m.prefix_len + m.positions + m.suffix_len;
+        for (int n = 0; n < known_count; n++) {
+            int head = lens[n] - tail;
+            if (head < 0 || (words_used ? head == 0 : head != 0)) continue;
+            if (!mask_spec_covers(&m, lowered[n] + head, tail)) continue;
+            covered += !words_used || is_target(wwise_hash_len(lowered[n], head), word_hashes, words_used);
+        }
+
+        p->seconds = throughput > 0 ? (double)p->keyspace / throughput : 0.0;
+        p->false_positives = (double)p->keyspace * targets / 4294967296.0;
+        p->expected_real = known_count ? (double)covered / known_count * targets : 0.0;
+        p->real_per_second = p->expected_real / (p->seconds > 1e-9 ? p->seconds : 1e-9);
+    }
+
+    /* rank by expected real cracks per second (insertion sort, catalogs are small) */
+    for (int i = 1; i < attack_count; i++) {
+        int x = order[i], j = i - 1;
+        while (j >= 0 && attack_plan_compare_index(plans, x, order[j]) < 0) {
+            order[j + 1] = order[j];
+            j--;
+        }
+        order[j + 1] = x;
+    }
+
+    int selected = 0;
+    double left = budget_seconds;
+    for (int i = 0; i < attack_count; i++) {
+        AttackPlan* p = &plans[order[i]];
+        if (p->keyspace == 0) continue;
+        if (budget_seconds <= 0 || p->seconds <= left) {
+            p->fraction = 1.0;
+            left -= p->seconds;
+            selected = i + 1;
+        } else if (left > 0) {
+            p->fraction = left / p->seconds;
+            left = 0;
+            selected = i + 1;
+        }
+        if (budget_seconds > 0 && left <= 0) break;
+    }
+
+    free(lowered);
+    free(lens);
+    free(word_hashes);
+    return selected;
+}
+
+/* ============================================================================
+ * SEARCH-SPACE LEDGER
+ * Persistent record of completed keyspace units, so finished sweeps are
+ * never re-run from scratch when new targets arrive.  Targets are
+ * registered with the ledger version they first appeared in; a unit
+ * (descriptor, [start, end), version) says every index in the range was
+ * checked against all targets of that version or older.  ledger_record()
+ * is given the IDs a pass actually searched and only claims the highest
+ * version all of whose newer targets were among them, so runs over a
+ * subset (one bank, new targets only) never vouch for the rest.  Targets
+ * left out of a later registration (cracked ones) are retired: they no
+ * longer hold coverage back, and one that returns rejoins at a new
+ * version, since units recorded meanwhile never checked it.  ledger_plan()
+ * cuts a request into passes: uncovered ranges need every target, ranges
+ * covered at an older version only the targets added since (a small set,
+ * so the pass is far cheaper), ranges covered at the current version are
+ * skipped.  Overlapping requests and records collapse onto the same
+ * coverage.  The descriptor names the attack and its rules ("mask:?l?w?w",
+ * "hybrid:<wordlist digest>:_?d?d"); it is keyed by its FNV-1/64 digest.
+ *
+ * File: "FNVLEDG1" then append-only records (a torn tail is ignored):
+ *   'T' uint32 id, uint32 version                      target registration
+ *   'R' uint32 id, uint32 version                      target retired at version
+ *   'U' uint64 key, uint64 start, uint64 end, uint32 version   unit
+ * Loading sorts and merges the records; when most of them were redundant
+ * the file is rewritten in compacted form.
+ * ============================================================================ */
+
+#define LEDGER_MAGIC "FNVLEDG1"
+#define LEDGER_COMPACT_SLACK 1024   /* redundant records tolerated before a rewrite */
+
+typedef struct {
+    uint32_t id;
+    uint32_t version;           /* registration version, or the one it was retired at */
+    int retired;
+} LedgerTarget;
+
+typedef struct {
+    uint64_t key;
+    uint64_t start;
+    uint64_t end;
+    uint32_t version;
+} LedgerUnit;
+
+typedef struct {
+    uint64_t start;
+    uint64_t end;
+    uint32_t since;             /* 0 = all targets, else only those added after */
+} LedgerPass;
+
+typedef struct {
+    FILE* file;
+    LedgerTarget* targets;      /* sorted by id */
+    int target_count;
+    int target_max;
+    LedgerUnit* units;
+    int unit_count;
+    int unit_max;
+    uint32_t version;
+} Ledger;
+
+static int ledger_target_find(const Ledger* l, uint32_t id) {
+    int lo = 0, hi = l->target_count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (l->targets[mid].id < id) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+static int ledger_target_append(Ledger* l, uint32_t id, uint32_t version, int retired) {
+    if (l->target_count == l->target_max) {
+        int max = l->target_max ? l->target_max * 2 : 1024;
+        LedgerTarget* grown = (LedgerTarget*)realloc(l->targets, sizeof(LedgerTarget) * max);
+        if (!grown) return 0;
+        l->targets = grown;
+        l->target_max = max;
+    }
+    l->targets[l->target_count].id = id;
+    l->targets[l->target_count].retired = retired;
+    l->targets[l->target_count++].version = version;
+    if (version > l->version) l->version = version;
+    return 1;
+}
+
+static int ledger_unit_append(Ledger* l, uint64_t key, uint64_t start, uint64_t end, uint32_t version) {
+    if (l->unit_count == l->unit_max) {
+        int max = l->unit_max ? l->unit_max * 2 : 256;
+        LedgerUnit* grown = (LedgerUnit*)realloc(l->units, sizeof(LedgerUnit) * max);
+        if (!grown) return 0;
+        l->units = grown;
+        l->unit_max = max;
+    }
+    LedgerUnit* u = &l->units[l->unit_count++];
+    u->key = key;
+    u->start = start;
+    u->end = end;
+    u->version = version;
+    return 1;
+}
+
+static int ledger_target_compare(const void* a, const void* b) {
+    const LedgerTarget* x = (const LedgerTarget*)a;
+    const LedgerTarget* y = (const LedgerTarget*)b;
+    if (x->id != y->id) return x->id < y->id ? -1 : 1;
+    if (x->version != y->version) return x->version < y->version ? -1 : 1;
+    return x->retired - y->retired;
+}
+
+static int ledger_unit_compare(const void* a, const void* b) {
+    const LedgerUnit* x = (const LedgerUnit*)a;
+    const LedgerUnit* y = (const LedgerUnit*)b;
+    if (x->key != y->key) return x->key < y->key ? -1 : 1;
+    if (x->version != y->version) return x->version < y->version ? -1 : 1;
+    return (x->start > y->start) - (x->start < y->start);
+}
+
+/*
+ * Sort targets by id keeping each one's latest record (a retirement sorts
+ * after the registration of its version); merge touching units of a key
+ * and version.
+ */
+static void ledger_compact(Ledger* l) {
+    qsort(l->targets, l->target_count, sizeof(LedgerTarget), ledger_target_compare);
+    int n = 0;
+    for (int i = 0; i < l->target_count; i++) {
+        if (n > 0 && l->targets[n - 1].id == l->targets[i].id) {
+            l->targets[n - 1] = l->targets[i];
+            continue;
+        }
+        l->targets[n++] = l->targets[i];
+    }
+    l->target_count = n;
+
+    qsort(l->units, l->unit_count, sizeof(LedgerUnit), ledger_unit_compare);
+    n = 0;
+    for (int i = 0; i < l->unit_count; i++) {
+        LedgerUnit* last = n > 0 ? &l->units[n - 1] : NULL;
+        const LedgerUnit* u = &l->units[i];
+        if (last && last->key == u->key && last->version == u->version && u->start <= last->end) {
+            if (u->end > last->end) last->end = u->end;
+            continue;
+        }
+        l->units[n++] = *u;
+    }
+    l->unit_count = n;
+}
+
+static int ledger_unit_touches(const LedgerUnit* u, uint64_t key, uint64_t start, uint64_t end, uint32_t version) {
+    return u->key == key && u->version == version && end >= u->start && start <= u->end;
+}
+
+/* Add a unit, merging every overlapping / adjacent unit of the same key and version into it */
+static int ledger_unit_add(Ledger* l, uint64_t key, uint64_t start, uint64_t end, uint32_t version) {
+    for (int i = 0; i < l->unit_count; ) {
+        LedgerUnit* u = &l->units[i];
+        if (!ledger_unit_touches(u, key, start, end, version)) {
+            i++;
+            continue;
+        }
+        if (u->start < start) start = u->start;
+        if (u->end > end) end = u->end;
+        *u = l->units[--l->unit_count];
+    }
+    return ledger_unit_append(l, key, start, end, version);
+}
+
+static void ledger_write_target(FILE* f, uint32_t id, uint32_t version, int retired) {
+    fputc(retired ? 'R' : 'T', f);
+    fwrite(&id, sizeof(uint32_t), 1, f);
+    fwrite(&version, sizeof(uint32_t), 1, f);
+}
+
+static void ledger_write_unit(FILE* f, const LedgerUnit* u) {
+    uint64_t rec[3] = { u->key, u->start, u->end };
+    fputc('U', f);
+    fwrite(rec, sizeof(uint64_t), 3, f);
+    fwrite(&u->version, sizeof(uint32_t), 1, f);
+}
+
+/* Rewrite the file from the compacted state (temp file + rename); returns 1 on success */
+static int ledger_rewrite(const Ledger* l, const char* path) {
+    size_t len = strlen(path);
+    char* tmp = (char*)malloc(len + 5);
+    if (!tmp) return 0;
+    memcpy(tmp, path, len);
+    memcpy(tmp + len, ".tmp", 5);
+
+    FILE* out = fopen(tmp, "wb");
+    int ok = out != NULL;
+    if (ok) {
+        fwrite(LEDGER_MAGIC, 1, 8, out);
+        for (int i = 0; i < l->target_count; i++) {
+            ledger_write_target(out, l->targets[i].id, l->targets[i].version, l->targets[i].retired);
+        }
+        for (int i = 0; i < l->unit_count; i++) ledger_write_unit(out, &l->units[i]);
+        ok = fflush(out) == 0 && !ferror(out);
+        ok = (fclose(out) == 0) && ok;
+    }
+#ifdef _WIN32
+    ok = ok && MoveFileExA(tmp, path, MOVEFILE_REPLACE_EXISTING);
+#else
+    ok = ok && rename(tmp, path) == 0;
+#endif
+    if (!ok) remove(tmp);
+    free(tmp);
+    return ok;
+}
+
+EXPORT void ledger_close(Ledger* l) {
+    if (!l) return;
+    if (l->file) fclose(l->file);
+    free(l->targets);
+    free(l->units);
+    free(l);
+}
+
+/* Open (or create) a ledger file; returns NULL if it cannot be read or written */
+EXPORT Ledger* ledger_open(const char* path) {
+    Ledger* l = (Ledger*)calloc(1, sizeof(Ledger));
+    char magic[8];
+    if (!l) return NULL;
+
+    FILE* in = fopen(path, "rb");
+    if (in) {
+        int records = 0;
+        if (fread(magic, 1, 8, in) != 8 || memcmp(magic, LEDGER_MAGIC, 8) != 0) {
+            fclose(in);
+            free(l);
+            return NULL;
+        }
+        int type;
+        while ((type = fgetc(in)) != EOF) {
+            if (type == 'T' || type == 'R') {
+                uint32_t rec[2];
+                if (fread(rec, sizeof(uint32_t), 2, in) != 2) break;
+                if (!ledger_target_append(l, rec[0], rec[1], type == 'R')) break;
+            } else if (type == 'U') {
+                uint64_t rec[3];
+                uint32_t version;
+                if (fread(rec, sizeof(uint64_t), 3, in) != 3 || fread(&version, sizeof(uint32_t), 1, in) != 1) break;
+                if (!ledger_unit_append(l, rec[0], rec[1], rec[2], version)) break;
+            } else {
+                break;
+            }
+            records++;
+        }
+        fclose(in);
+        ledger_compact(l);
+        if (records > l->target_count + l->unit_count + LEDGER_COMPACT_SLACK) ledger_rewrite(l, path);
+        l->file = fopen(path, "ab");
+    } else {
+        l->file = fopen(path, "wb");
+        if (l->file) fwrite(LEDGER_MAGIC, 1, 8, l->file);
+    }
+    if (!l->file) {
+        ledger_close(l);
+        return NULL;
+    }
+    fflush(l->file);
+    return l;
+}
+
+/*
+ * Register the current target set.  IDs the ledger has not seen, or had
+ * retired, join a new version; registered IDs missing from ids[] are
+ * retired.  Returns the version the whole set is now at.
+ */
+EXPORT uint32_t ledger_register_targets(Ledger* l, const uint32_t* ids, int count) {
+    uint32_t version = l->version + 1;
+    uint32_t* sorted = (uint32_t*)malloc(sizeof(uint32_t) * (count > 0 ? count : 1));
+    int known = l->target_count, added = 0;
+    if (!sorted) return l->version;
+
+    memcpy(sorted, ids, sizeof(uint32_t) * count);
+    qsort(sorted, count, sizeof(uint32_t), uint32_compare);
+    for (int i = 0; i < known; i++) {
+        LedgerTarget* t = &l->targets[i];
+        if (t->retired || is_target(t->id, sorted, count)) continue;
+        t->retired = 1;
+        t->version = l->version;
+        ledger_write_target(l->file, t->id, t->version, 1);
+    }
+    for (int i = 0; i < count; i++) {
+        if (i > 0 && sorted[i] == sorted[i - 1]) continue;
+        int at = ledger_target_find(l, sorted[i]);
+        if (at < known && l->targets[at].id == sorted[i]) {
+            if (!l->targets[at].retired) continue;
+            l->targets[at].retired = 0;
+            l->targets[at].version = version;
+        } else if (!ledger_target_append(l, sorted[i], version, 0)) {
+            break;
+        }
+        ledger_write_target(l->file, sorted[i], version, 0);
+        added++;
+    }
+    free(sorted);
+    if (added) {
+        if (version > l->version) l->version = version;
+        qsort(l->targets, l->target_count, sizeof(LedgerTarget), ledger_target_compare);
+    }
+    fflush(l->file);
+    return added ? version : l->version;
+}
+
+/*
+ * Targets of ids[] that a unit covered at `since` has not been checked
+ * against: added after that version, retired or never registered.
+ * Returns count.
+ */
+EXPORT int ledger_targets_since(const Ledger* l, uint32_t since, const uint32_t* ids, int count, uint32_t* out) {
+    int n = 0;
+    for (int i = 0; i < count; i++) {
+        int at = ledger_target_find(l, ids[i]);
+        if (at >= l->target_count || l->targets[at].id != ids[i] || l->targets[at].retired ||
+            l->targets[at].version > since) {
+            out[n++] = ids[i];
+        }
+    }
+    return n;
+}
+
+/*
+ * Record a finished pass over [start, end) of `descriptor`: the range was
+ * covered at version `since` (0 = never) and has now been checked against
+ * ids[].  The unit is recorded at the highest version v such that every
+ * live (not retired) target added after `since`, up to v, is in ids[].  Returns
+ * the version the range is now covered at (since when ids[] completes no
+ * newer version), 0 on failure.
+ */
+EXPORT uint32_t ledger_record(Ledger* l, const char* descriptor, uint64_t start, uint64_t end,
+                              uint32_t since, const uint32_t* ids, int count) {
+    uint32_t* sorted = (uint32_t*)malloc(sizeof(uint32_t) * (count > 0 ? count : 1));
+    uint32_t version = l->version;
+    if (!sorted) return 0;
+
+    memcpy(sorted, ids, sizeof(uint32_t) * count);
+    qsort(sorted, count, sizeof(uint32_t), uint32_compare);
+    for (int i = 0; i < l->target_count; i++) {
+        const LedgerTarget* t = &l->targets[i];
+        if (t->retired || t->version <= since || t->version > version) continue;
+        if (!is_target(t->id, sorted, count)) version = t->version - 1;
+    }
+    free(sorted);
+    if (start >= end || version <= since) return since;
+
+    uint64_t key = hash_policy_digest(HASH_FNV1_64, descriptor);
+    if (!ledger_unit_add(l, key, start, end, version)) return 0;
+    ledger_write_unit(l->file, &l->units[l->unit_count - 1]);
+    fflush(l->file);
+    return version;
+}
+
+/*
+ * Passes still needed to cover [start, end) of `descriptor` at the
+ * ledger's current version, in index order.  passes[k].since is the
+ * version the range is already covered at (0 = never).  Returns the pass
+ * count (may exceed max_passes; only max_passes are written).
+ */
+EXPORT int ledger_plan(const Ledger* l, const char* descriptor, uint64_t start, uint64_t end,
+                       LedgerPass* passes, int max_passes) {
+    uint64_t key = hash_policy_digest(HASH_FNV1_64, descriptor);
+    int relevant = 0, n = 0;
+
+    for (int i = 0; i < l->unit_count; i++) {
+        relevant += l->units[i].key == key && l->units[i].end > start && l->units[i].start < end;
+    }
+    uint64_t* cuts = (uint64_t*)malloc(sizeof(uint64_t) * (2 * relevant + 2));
+    if (!cuts) return 0;
+
+    int c = 0;
+    cuts[c++] = start;
+    cuts[c++] = end;
+    for (int i = 0; i < l->unit_count; i++) {
+        const LedgerUnit* u = &l->units[i];
+        if (u->key != key || u->end <= start || u->start >= end) continue;
+        if (u->start > start) cuts[c++] = u->start;
+        if (u->end < end) cuts[c++] = u->end;
+    }
+    qsort(cuts, c, sizeof(uint64_t), uint64_compare);
+
+    for (int k = 0; k + 1 < c; k++) {
+        if (cuts[k] == cuts[k + 1]) continue;
+        uint32_t since = 0;
+        for (int i = 0; i < l->unit_count; i++) {
+            const LedgerUnit* u = &l->units[i];
+            if (u->key == key && u->start <= cuts[k] && u->end >= cuts[k + 1] && u->version > since) {
+                since = u->version;
+            }
+        }
+        if (since >= l->version && l->version > 0) continue;
+        if (n > 0 && n <= max_passes && passes[n - 1].end == cuts[k] && passes[n - 1].since == since) {
+            passes[n - 1].end = cuts[k + 1];
+            continue;
+        }
+        if (n < max_passes) {
+            passes[n].start = cuts[k];
+            passes[n].end = cuts[k + 1];
+            passes[n].since = since;
+        }
+        n++;
+    }
+
+    free(cuts);
+    return n;
+}
+
+/* Current version, live (registered, not retired) targets and stored units */
+EXPORT void ledger_stats(const Ledger* l, uint32_t* version, int* targets, int* units) {
+    int live = 0;
+    for (int i = 0; i < l->target_count; i++) live += !l->targets[i].retired;
+    if (version) *version = l->version;
+    if (targets) *targets = live;
+    if (units) *units = l->unit_count;
+}
+
+/* ============================================================================
+ * ASYNCHRONOUS JOBS
+ * job_start() returns at once with native threads sweeping a kernel-engine
+ * keyspace; the caller polls counters and newly found matches, cancels, or
+ * waits.  The keyspace is a list of segments laid end to end (one per mask,
+ * brute-force length or hybrid word) and threads claim chunks that never
+ * cross a segment, so cancellation lands within one chunk per thread.  The
+ * job copies everything it needs from the config: the caller's buffers may
+ * be freed as soon as job_start returns.
+ *
+ * Targets live in read-copy-update snapshots: job_update_targets() builds a
+ * new filter beside the live one and publishes it; each thread takes a
+ * reference when it claims a chunk, so a chunk runs entirely on one
+ * snapshot and the kernels never touch a lock.  A retired snapshot is freed
+ * by the last thread still using it.  Hits on targets removed while their
+ * chunk was in flight are dropped at commit.
+ * ============================================================================ */
+
+#define JOB_MASK    0           /* config mask */
+#define JOB_HYBRID  1           /* every word followed by the config mask */
+#define JOB_BRUTE   2           /* Wwise charset, lengths [min_len, max_len] */
+#define JOB_PREFIX  3           /* literal prefix (config mask) + [a-z_0-9]{0..max_len - prefix} */
+
+#define JOB_RUNNING   0
+#define JOB_DONE      1
+#define JOB_CANCELLED 2
+#define JOB_FAILED    3
+
+#define JOB_DEFAULT_CHUNK ((uint64_t)1 << 22)
+#define JOB_MAX_FOUND     (1 << 20)
+
+typedef struct {
+    int kind;                   /* JOB_* */
+    const char* mask;           /* mask (MASK/HYBRID) or literal prefix (PREFIX) */
+    const char** words;         /* HYBRID */
+    int word_count;
+    int min_len;                /* BRUTE */
+    int max_len;                /* BRUTE / PREFIX */
+    uint64_t start;             /* index range of the job keyspace, end 0 = all */
+    uint64_t end;
+    int backend;                /* KERNEL_* */
+    int num_threads;            /* <= 0: every core */
+    uint64_t chunk;             /* indices per claim, 0 = default */
+    const uint32_t* targets;
+    int target_count;
+} JobConfig;
+
+typedef struct {
+    int state;                  /* JOB_* */
+    int threads;                /* worker threads still running */
+    uint64_t tested;
+    uint64_t total;
+    double elapsed;
+    double rate;                /* candidates/second */
+    int found;                  /* matches so far (polled or not) */
+    int targets;                /* live target count */
+    uint32_t target_version;    /* bumped by every job_update_targets */
+    int overflow;               /* nonzero: matches were dropped past JOB_MAX_FOUND (or out of memory) */
+} JobStatus;
+
+typedef struct {
+    TargetFilter filter;
+    TargetFilter* replicas[NUMA_MAX_NODES];    /* per-node copies, made on first use */
+    uint32_t* ids;              /* raw target IDs, sorted, unique */
+    int count;
+    uint32_t version;
+    int refs;                   /* job lock; the job's own reference included */
+} JobTargets;
+
+typedef struct {
+    uint64_t offset;
+    uint64_t keyspace;
+    int spec;
+    char* word;                 /* hybrid word, NULL otherwise */
+} JobSegment;
+
+typedef struct Job Job;
+
+typedef struct {
+    Job* job;
+    int index;                  /* pool position (NUMA placement) */
+} JobThread;
+
+struct Job {
+    MaskSpec* specs;
+    int spec_count;
+    JobSegment* segments;
+    int segment_count;
+    JobTargets* targets;        /* live snapshot (job lock) */
+    fnv_mutex_t update_lock;    /* serialises writers */
+    fnv_mutex_t join_lock;      /* serialises job_wait callers */
+    int backend;
+    uint64_t start;
+    uint64_t end;
+    uint64_t chunk;
+
+    fnv_mutex_t lock;
+    uint64_t next;
+    uint64_t tested;
+    int cancel;                 /* job lock */
+    int state;
+    int running;
+    int joined;
+    double started;
+    double finished;
+
+    uint32_t* found_hashes;
+    char (*found_names)[32];
+    int found;
+    int found_max;
+    int polled;
+    int overflow;               /* matches dropped, see JobStatus */
+
+    fnv_thread_t threads[MAX_THREADS];
+    JobThread thread_args[MAX_THREADS];
+    int thread_count;
+    int nodes;                  /* NUMA nodes the pool spans */
+};
+
+/* Snapshot over ids (any order, duplicates allowed) */
+static JobTargets* job_targets_build(const uint32_t* ids, int count, const MaskSpec* spec, uint32_t version) {
+    JobTargets* t = (JobTargets*)calloc(1, sizeof(JobTargets));
+    if (!t) return NULL;
+    t->ids = (uint32_t*)malloc(sizeof(uint32_t) * (count > 0 ? count : 1));
+    if (!t->ids) {
+        free(t);
+        return NULL;
+    }
+    memcpy(t->ids, ids, sizeof(uint32_t) * (count > 0 ? count : 0));
+    qsort(t->ids, count, sizeof(uint32_t), uint32_compare);
+    for (int i = 0; i < count; i++) {
+        if (t->count == 0 || t->ids[t->count - 1] != t->ids[i]) t->ids[t->count++] = t->ids[i];
+    }
+    if (!target_filter_build(&t->filter, t->ids, t->count, spec->suffix, spec->suffix_len)) {
+        free(t->ids);
+        free(t);
+        return NULL;
+    }
+    t->version = version;
+    t->refs = 1;
+    return t;
+}
+
+/* Node-local copy of a filter: the calling (pinned) thread touches every page first */
+static TargetFilter* target_filter_clone(const TargetFilter* src) {
+    TargetFilter* f = (TargetFilter*)malloc(sizeof(TargetFilter));
+    if (!f) return NULL;
+    memcpy(f, src, sizeof(*f));
+    f->sorted = (uint32_t*)malloc(sizeof(uint32_t) * (src->count ? src->count : 1));
+    f->by_row = (uint32_t*)malloc(sizeof(uint32_t) * (src->count ? src->count : 1));
+    if (!f->sorted || !f->by_row) {
+        target_filter_free(f);
+        free(f);
+        return NULL;
+    }
+    memcpy(f->sorted, src->sorted, sizeof(uint32_t) * src->count);
+    memcpy(f->by_row, src->by_row, sizeof(uint32_t) * src->count);
+    return f;
+}
+
+/* Drop a reference (job lock held, or the job is being torn down) */
+static void job_targets_release(JobTargets* t) {
+    if (t && --t->refs == 0) {
+        for (int n = 0; n < NUMA_MAX_NODES; n++) {
+            if (!t->replicas[n]) continue;
+            target_filter_free(t->replicas[n]);
+            free(t->replicas[n]);
+        }
+        target_filter_free(&t->filter);
+        free(t->ids);
+        free(t);
+    }
+}
+
+static int job_segment_find(const Job* job, uint64_t index) {
+    int lo = 0, hi = job->segment_count - 1;
+    while (lo < hi) {
+        int mid = (lo + hi + 1) / 2;
+        if (job->segments[mid].offset <= index) lo = mid;
+        else hi = mid - 1;
+    }
+    return lo;
+}
+
+/* Append matches still aimed at a live target, counting any that do not fit (lock held) */
+static void job_commit(Job* job, const MatchList* hits) {
+    for (int k = 0; k < hits->count; k++) {
+        if (!is_target(hits->hashes[k], job->targets->ids, job->targets->count)) continue;
+        if (job->found == job->found_max) {
+            int max = job->found_max ? job->found_max * 2 : 256;
+            uint32_t* hashes = max <= JOB_MAX_FOUND
+                ? (uint32_t*)realloc(job->found_hashes, sizeof(uint32_t) * max) : NULL;
+            if (hashes) job->found_hashes = hashes;
+            char (*names)[32] = hashes ? (char (*)[32])realloc(job->found_names, 32 * (size_t)max) : NULL;
+            if (!names) {
+                job->overflow++;
+                continue;
+            }
+            job->found_names = names;
+            job->found_max = max;
+        }
+        job->found_hashes[job->found] = hits->hashes[k];
+        strcpy(job->found_names[job->found], hits->names[k]);
+        job->found++;
+    }
+}
+
+THREAD_FUNC(job_worker, arg) {
+    Job* job = ((JobThread*)arg)->job;
+    int index = ((JobThread*)arg)->index;
+    int node = job->nodes > 1 ? numa_worker_node(index) : 0;
+    int cap = 256;
+    uint32_t* hashes = (uint32_t*)malloc(sizeof(uint32_t) * cap);
+    char (*names)[32] = (char (*)[32])malloc(32 * (size_t)cap);
+
+    numa_pin_worker(index);
+    for (;;) {
+        fnv_mutex_lock(&job->lock);
+        if (job->cancel || job->next >= job->end) {
+            if (--job->running == 0) {
+                job->state = job->cancel ? JOB_CANCELLED : JOB_DONE;
+                job->finished = fnv_now();
+            }
+            fnv_mutex_unlock(&job->lock);
+            break;
+        }
+        const JobSegment* seg = &job->segments[job_segment_find(job, job->next)];
+        uint64_t start = job->next;
+        uint64_t end = start + job->chunk;
+        if (end > seg->offset + seg->keyspace) end = seg->offset + seg->keyspace;
+        if (end > job->end) end = job->end;
+        job->next = end;
+        JobTargets* targets = job->targets;
+        const TargetFilter* filter = &targets->filter;
+        const TargetFilter* replica = job->nodes > 1 ? targets->replicas[node] : NULL;
+        targets->refs++;
+        fnv_mutex_unlock(&job->lock);
+
+        /* first worker on a node copies the snapshot's filter (outside the lock; the ref keeps it alive) */
+        if (job->nodes > 1 && !replica) {
+            TargetFilter* fresh = target_filter_clone(&targets->filter);
+            fnv_mutex_lock(&job->lock);
+            if (!targets->replicas[node]) {
+                targets->replicas[node] = fresh;
+                fresh = NULL;
+            }
+            replica = targets->replicas[node];
+            fnv_mutex_unlock(&job->lock);
+            if (fresh) {
+                target_filter_free(fresh);
+                free(fresh);
+            }
+        }
+        if (replica) filter = replica;
+
+        /* a chunk that fills the match buffer is re-run with a bigger one, so no hit is lost */
+        MaskSpec m = job->specs[seg->spec];
+        int runnable = !seg->word || mask_with_word(&job->specs[seg->spec], seg->word, NULL, &m);
+        MatchList out = { hashes, names, 0, hashes && names ? cap : 0, NULL, 0, HASH_FNV1_32, NULL, NULL, -1, {0} };
+        while (runnable && targets->count > 0) {
+            uint64_t reached = mask_run(&m, filter, job->backend, start - seg->offset, end - seg->offset, &out);
+            if (reached == end - seg->offset && out.count < out.max) break;
+            uint32_t* grown_hashes = cap < JOB_MAX_FOUND ? (uint32_t*)realloc(hashes, sizeof(uint32_t) * cap * 2) : NULL;
+            if (grown_hashes) hashes = grown_hashes;
+            char (*grown_names)[32] = grown_hashes ? (char (*)[32])realloc(names, 64 * (size_t)cap) : NULL;
+            if (!grown_names) break;
+            names = grown_names;
+            cap *= 2;
+            match_index_free(&out.seen);
+            MatchList fresh = { hashes, names, 0, cap, NULL, 0, HASH_FNV1_32, NULL, NULL, -1, {0} };
+            out = fresh;
+        }
+
+        fnv_mutex_lock(&job->lock);
+        job->tested += end - start;
+        if (out.count == out.max && runnable && targets->count > 0) job->overflow++;
+        job_commit(job, &out);
+        job_targets_release(targets);
+        fnv_mutex_unlock(&job->lock);
+        match_index_free(&out.seen);
+    }
+    free(hashes);
+    free(names);
+    THREAD_RETURN;
+}
+
+/* Append a segment; returns 0 when the job keyspace would not fit 64 bits */
+static int job_add_segment(Job* job, int spec, const char* word) {
+    JobSegment* seg = &job->segments[job->segment_count];
+    const JobSegment* prev = job->segment_count ? seg - 1 : NULL;
+    seg->offset = prev ? keyspace_add(prev->offset, prev->keyspace) : 0;
+    seg->keyspace = mask_spec_keyspace(&job->specs[spec]);
+    if (keyspace_add(seg->offset, seg->keyspace) == UINT64_MAX) return 0;
+    seg->spec = spec;
+    seg->word = NULL;
+    if (word) {
+        size_t n = strlen(word) + 1;
+        if (!(seg->word = (char*)malloc(n))) return 0;
+        memcpy(seg->word, word, n);
+    }
+    job->segment_count++;
+    return 1;
+}
+
+static void job_release(Job* job) {
+    for (int i = 0; i < job->segment_count; i++) free(job->segments[i].word);
+    free(job->segments);
+    free(job->specs);
+    job_targets_release(job->targets);
+    free(job->found_hashes);
+    free(job->found_names);
+    fnv_mutex_destroy(&job->join_lock);
+    fnv_mutex_destroy(&job->update_lock);
+    fnv_mutex_destroy(&job->lock);
+    free(job);
+}
+
+/*
+ * Start a job; returns NULL on a bad config or allocation failure.  The
+ * job keyspace is the kind's keyspace as in the blocking calls
+ * (mask_keyspace, hybrid_keyspace, brute_kernel_keyspace; PREFIX lays its
+ * lengths end to end like BRUTE), restricted to [start, end).
+ */
+EXPORT Job* job_start(const JobConfig* config) {
+    char mask[2 * MASK_MAX_POSITIONS + 40];
+    Job* job = (Job*)calloc(1, sizeof(Job));
+    int segments = 1, specs = 1, ok = 1;
+
+    if (!job) return NULL;
+    fnv_mutex_init(&job->lock);
+    fnv_mutex_init(&job->update_lock);
+    fnv_mutex_init(&job->join_lock);
+
+    if (config->kind == JOB_HYBRID) {
+        segments = config->word_count > 0 ? config->word_count : 0;
+    } else if (config->kind == JOB_BRUTE || config->kind == JOB_PREFIX) {
+        segments = specs = MASK_MAX_POSITIONS;
+    }
+    job->specs = (MaskSpec*)calloc(specs, sizeof(MaskSpec));
+    job->segments = (JobSegment*)calloc(segments > 0 ? segments : 1, sizeof(JobSegment));
+    if (!job->specs || !job->segments) {
+        job_release(job);
+        return NULL;
+    }
+
+    switch (config->kind) {
+        case JOB_MASK:
+            ok = config->mask && mask_parse(config->mask, &job->specs[0]) && job_add_segment(job, 0, NULL);
+            job->spec_count = 1;
+            break;
+        case JOB_HYBRID:
+            ok = config->mask && mask_parse(config->mask, &job->specs[0]);
+            job->spec_count = 1;
+            for (int w = 0; ok && w < segments; w++) ok = job_add_segment(job, 0, config->words[w]);
+            break;
+        case JOB_BRUTE: {
+            int lo = config->min_len < 1 ? 1 : config->min_len;
+            int hi = config->max_len > MASK_MAX_POSITIONS ? MASK_MAX_POSITIONS : config->max_len;
+            for (int len = lo; ok && len <= hi; len++) {
+                brute_kernel_mask(mask, len);
+                ok = mask_parse(mask, &job->specs[job->spec_count]) &&
+                     job_add_segment(job, job->spec_count, NULL);
+                job->spec_count++;
+            }
+            break;
+        }
+        case JOB_PREFIX: {
+            int plen = config->mask ? (int)strlen(config->mask) : 32;
+            ok = plen < 32;
+            for (int extra = 1; ok && plen + extra <= config->max_len && extra <= MASK_MAX_POSITIONS; extra++) {
+                strcpy(mask, config->mask);
+                for (int i = 0; i < extra; i++) strcat(mask, "?w");
+                ok = mask_parse(mask, &job->specs[job->spec_count]) &&
+                     job_add_segment(job, job->spec_count, NULL);
+                job->spec_count++;
+            }
+            break;
+        }
+        default:
+            ok = 0;
+    }
+    if (!ok || !(job->targets = job_targets_build(config->targets, config->target_count, &job->specs[0], 1))) {
+        job_release(job);
+        return NULL;
+    }
+
+    /* the bare prefix itself (length 0 extension) is a single candidate */
+    if (config->kind == JOB_PREFIX && (int)strlen(config->mask) <= config->max_len &&
+        config->start == 0) {
+        uint32_t h = wwise_hash(config->mask);
+        if (is_target(h, job->targets->ids, job->targets->count)) {
+            uint32_t hashes[1] = { h };
+            char names[1][32];
+            MatchList hit = { hashes, names, 1, 1, NULL, 0, HASH_FNV1_32, NULL, NULL, -1, {0} };
+            strcpy(names[0], config->mask);
+            job_commit(job, &hit);
+        }
+    }
+
+    uint64_t total = job->segment_count
+        ? job->segments[job->segment_count - 1].offset + job->segments[job->segment_count - 1].keyspace : 0;
+    job->backend = config->backend;
+    job->chunk = config->chunk ? config->chunk : JOB_DEFAULT_CHUNK;
+    job->start = job->next = config->start < total ? config->start : total;
+    job->end = (config->end == 0 || config->end > total) ? total : config->end;
+    if (job->end < job->start) job->end = job->start;
+    job->started = fnv_now();
+
+    /* workers block on the lock until every thread is accounted for */
+    fnv_mutex_lock(&job->lock);
+    int n = resolve_thread_count(config->num_threads);
+    int first = numa_reserve_slots(n);
+    job->nodes = numa_pool_nodes(first, n);
+    for (int i = 0; i < n; i++) {
+        job->thread_args[i].job = job;
+        job->thread_args[i].index = first + i;
+        if (!fnv_thread_start(&job->threads[i], job_worker, &job->thread_args[i])) break;
+        job->thread_count++;
+    }
+    job->running = job->thread_count;
+    if (job->thread_count == 0) {
+        job->state = JOB_FAILED;
+        job->finished = fnv_now();
+    }
+    fnv_mutex_unlock(&job->lock);
+    return job;
+}
+
+/*
+ * Snapshot of a job's counters; copies up to max_new matches found since
+ * the previous poll into new_hashes/new_names and returns how many.
+ */
+EXPORT int job_poll(Job* job, JobStatus* status, uint32_t* new_hashes, char (*new_names)[32], int max_new) {
+    int n = 0;
+
+    fnv_mutex_lock(&job->lock);
+    if (status) {
+        double now = job->state == JOB_RUNNING ? fnv_now() : job->finished;
+        status->state = job->state;
+        status->threads = job->running;
+        status->tested = job->tested;
+        status->total = job->end - job->start;
+        status->elapsed = now - job->started;
+        status->rate = status->elapsed > 0 ? (double)job->tested / status->elapsed : 0.0;
+        status->found = job->found;
+        status->targets = job->targets->count;
+        status->target_version = job->targets->version;
+        status->overflow = job->overflow;
+    }
+    while (job->polled < job->found && n < max_new) {
+        new_hashes[n] = job->found_hashes[job->polled];
+        strcpy(new_names[n], job->found_names[job->polled]);
+        job->polled++;
+        n++;
+    }
+    fnv_mutex_unlock(&job->lock);
+    return n;
+}
+
+/*
+ * Publish a new target snapshot: the live IDs plus add[] minus remove[].
+ * Running threads switch at their next chunk.  Returns the new version,
+ * or 0 if the snapshot could not be built (the old one stays live).
+ */
+EXPORT uint32_t job_update_targets(Job* job, const uint32_t* add, int add_count,
+                                   const uint32_t* remove, int remove_count) {
+    uint32_t version = 0;
+
+    if (add_count < 0 || !add) add_count = 0;
+    if (remove_count < 0 || !remove) remove_count = 0;
+    fnv_mutex_lock(&job->update_lock);
+    /* only writers replace job->targets, so the live snapshot is stable here */
+    const JobTargets* live = job->targets;
+    uint32_t* ids = (uint32_t*)malloc(sizeof(uint32_t) * (live->count + add_count + 1));
+    uint32_t* gone = (uint32_t*)malloc(sizeof(uint32_t) * (remove_count + 1));
+    if (ids && gone) {
+        int n = 0;
+        if (remove_count) memcpy(gone, remove, sizeof(uint32_t) * remove_count);
+        qsort(gone, remove_count, sizeof(uint32_t), uint32_compare);
+        for (int i = 0; i < live->count; i++) {
+            if (!is_target(live->ids[i], gone, remove_count)) ids[n++] = live->ids[i];
+        }
+        for (int i = 0; i < add_count; i++) {
+            if (!is_target(add[i], gone, remove_count)) ids[n++] = add[i];
+        }
+
+        JobTargets* fresh = job_targets_build(ids, n, &job->specs[0], live->version + 1);
+        if (fresh) {
+            fnv_mutex_lock(&job->lock);
+            JobTargets* old = job->targets;
+            job->targets = fresh;
+            job_targets_release(old);
+            fnv_mutex_unlock(&job->lock);
+            version = fresh->version;
+        }
+    }
+    free(ids);
+    free(gone);
+    fnv_mutex_unlock(&job->update_lock);
+    return version;
+}
+
+/* Ask the job to stop; threads finish their current chunk and exit */
+EXPORT void job_cancel(Job* job) {
+    fnv_mutex_lock(&job->lock);
+    job->cancel = 1;
+    fnv_mutex_unlock(&job->lock);
+}
+
+/*
+ * Block until every thread has exited; returns the final JOB_* state.
+ * Any number of threads may wait: the first joins, the rest block on
+ * join_lock until it has.  job_free must still come after every wait.
+ */
+EXPORT int job_wait(Job* job) {
+    fnv_mutex_lock(&job->join_lock);
+    if (!job->joined) {
+        for (int i = 0; i < job->thread_count; i++) fnv_thread_join(job->threads[i]);
+        job->joined = 1;
+    }
+    fnv_mutex_unlock(&job->join_lock);
+    return job->state;
+}
+
+/* Cancel, wait and release a job (unpolled matches are dropped) */
+EXPORT void job_free(Job* job) {
+    if (!job) return;
+    job_cancel(job);
+    job_wait(job);
+    job_release(job);
+}
+
+/* ============================================================================
+ * PACKED BATCH HASHING
+ * wwise_hash_batch() chases one pointer per string and runs one serial
+ * multiply chain per string.  The packed API takes a single buffer plus
+ * offset/length arrays instead.  Strings are bucketed by length (counting
+ * sort over indices), PACK_GROUP strings of one length are transposed four
+ * characters at a time into a lane-major block, and the block is hashed
+ * one character position per step: two vectors of 16 lanes with AVX-512F
+ * or 8 with AVX2, so two independent multiply chains hide the vpmulld
+ * latency (~1.5x scalar with AVX2, ~2x with AVX-512).  Batches are
+ * bucketed PACK_CHUNK strings at a time so the transposing loads stay in
+ * cache; the layout assumes a little-endian host (x86).  Strings longer
+ * than PACK_MAX_LEN, and every string without AVX2, are hashed one by one.
+ * ============================================================================ */
+
+#define PACK_MAX_LEN 64
+#define PACK_MAX_WORDS (PACK_MAX_LEN / 4)
+#ifdef __AVX512F__
+#define PACK_LANES 16
+#else
+#define PACK_LANES 8
+#endif
+#define PACK_GROUP (2 * PACK_LANES)
+#define PACK_CHUNK 4096             /* strings bucketed (and matched) per pass */
+
+/*
+ * Lanes hold four characters (little-endian 32-bit words), lowercased four
+ * at a time: a byte is 'A'..'Z' iff its low 7 bits + 0x3F carry into bit 7,
+ * + 0x25 does not, and bit 7 was clear; that bit, shifted down two, is 0x20.
+ */
+#if defined(__AVX512F__) || defined(__AVX2__)
+#ifdef __AVX512F__
+typedef __m512i pack_vec;
+#define PV_SET1(x)          _mm512_set1_epi32((int)(x))
+#define PV_LOAD(p)          _mm512_loadu_si512((const void*)(p))
+#define PV_STORE(p, v)      _mm512_storeu_si512((void*)(p), v)
+#define PV_AND(a, b)        _mm512_and_si512(a, b)
+#define PV_ANDNOT(a, b)     _mm512_andnot_si512(a, b)     /* ~a & b */
+#define PV_OR(a, b)         _mm512_or_si512(a, b)
+#define PV_XOR(a, b)        _mm512_xor_si512(a, b)
+#define PV_ADD(a, b)        _mm512_add_epi32(a, b)
+#define PV_MUL(a, b)        _mm512_mullo_epi32(a, b)
+#define PV_SRLI(a, n)       _mm512_srli_epi32(a, n)
+#else
+typedef __m256i pack_vec;
+#define PV_SET1(x)          _mm256_set1_epi32((int)(x))
+#define PV_LOAD(p)          _mm256_loadu_si256((const __m256i*)(p))
+#define PV_STORE(p, v)      _mm256_storeu_si256((__m256i*)(p), v)
+#define PV_AND(a, b)        _mm256_and_si256(a, b)
+#define PV_ANDNOT(a, b)     _mm256_andnot_si256(a, b)     /* ~a & b */
+#define PV_OR(a, b)         _mm256_or_si256(a, b)
+#define PV_XOR(a, b)        _mm256_xor_si256(a, b)
+#define PV_ADD(a, b)        _mm256_add_epi32(a, b)
+#define PV_MUL(a, b)        _mm256_mullo_epi32(a, b)
+#define PV_SRLI(a, n)       _mm256_srli_epi32(a, n)
+#endif
+
+static inline pack_vec pack_lower4(pack_vec w) {
+    pack_vec low7 = PV_AND(w, PV_SET1(0x7F7F7F7Fu));
+    pack_vec upper = PV_ANDNOT(PV_ADD(low7, PV_SET1(0x25252525u)), PV_ADD(low7, PV_SET1(0x3F3F3F3Fu)));
+    upper = PV_AND(PV_ANDNOT(w, upper), PV_SET1(0x80808080u));
+    return PV_OR(w, PV_SRLI(upper, 2));
+}
+
+#define PACK_STEP(shift) \
+    a = PV_XOR(PV_MUL(a, prime), PV_AND(PV_SRLI(wa, shift), byte)); \
+    b = PV_XOR(PV_MUL(b, prime), PV_AND(PV_SRLI(wb, shift), byte))
+
+/* FNV-1 of PACK_GROUP strings of length len; block is [(len + 3) / 4][PACK_GROUP] words */
+static void pack_hash_block(const uint32_t* block, int len, uint32_t* out) {
+    const pack_vec prime = PV_SET1(FNV_PRIME), byte = PV_SET1(0xFF);
+    pack_vec a = PV_SET1(FNV_OFFSET), b = a;
+    int tail = len & 3;
+
+    for (int q = 0; q < len / 4; q++, block += PACK_GROUP) {
+        pack_vec wa = pack_lower4(PV_LOAD(block)), wb = pack_lower4(PV_LOAD(block + PACK_LANES));
+        PACK_STEP(0);
+        PACK_STEP(8);
+        PACK_STEP(16);
+        PACK_STEP(24);
+    }
+    if (tail) {
+        pack_vec wa = pack_lower4(PV_LOAD(block)), wb = pack_lower4(PV_LOAD(block + PACK_LANES));
+        PACK_STEP(0);
+        if (tail > 1) { PACK_STEP(8); }
+        if (tail > 2) { PACK_STEP(16); }
+    }
+    PV_STORE(out, a);
+    PV_STORE(out + PACK_LANES, b);
+}
+
+/* hash_packed() over at most PACK_CHUNK strings, so the bucketed order stays cache-local */
+static void hash_packed_window(const char* buf, const uint32_t* offsets, const uint32_t* lengths,
+                               int count, uint32_t* results) {
+    int start[PACK_MAX_LEN + 2] = {0};
+    int fill[PACK_MAX_LEN + 1];
+    int order[PACK_CHUNK];
+    uint32_t block[PACK_MAX_WORDS * PACK_GROUP];
+    uint32_t h[PACK_GROUP];
+
+    for (int i = 0; i < count; i++) {
+        if (lengths[i] <= PACK_MAX_LEN) start[lengths[i] + 1]++;
+        else results[i] = wwise_hash_len(buf + offsets[i], (int)lengths[i]);
+    }
+    for (int len = 0; len <= PACK_MAX_LEN; len++) start[len + 1] += start[len];
+    memcpy(fill, start, sizeof(fill));
+    for (int i = 0; i < count; i++) {
+        if (lengths[i] <= PACK_MAX_LEN) order[fill[lengths[i]]++] = i;
+    }
+
+    for (int len = 0; len <= PACK_MAX_LEN; len++) {
+        int full = len / 4, tail = len & 3;
+        for (int g = start[len]; g < start[len + 1]; g += PACK_GROUP) {
+            int n = start[len + 1] - g < PACK_GROUP ? start[len + 1] - g : PACK_GROUP;
+            for (int k = 0; k < PACK_GROUP; k++) {
+                const char* s = buf + offsets[order[g + (k < n ? k : 0)]];
+                for (int q = 0; q < full; q++) memcpy(&block[q * PACK_GROUP + k], s + 4 * q, 4);
+                if (tail) {
+                    /* last word ends at the string's end: never reads past it */
+                    uint32_t w = 0;
+                    if (full) {
+                        memcpy(&w, s + len - 4, 4);
+                        w >>= 8 * (4 - tail);
+                    } else {
+                        for (int j = 0; j < tail; j++) w |= (uint32_t)(uint8_t)s[j] << (8 * j);
+                    }
+                    block[full * PACK_GROUP + k] = w;
+                }
+            }
+            pack_hash_block(block, len, h);
+            for (int k = 0; k < n; k++) results[order[g + k]] = h[k];
+        }
+    }
+}
+#endif
+
+/* results[i] = wwise_hash of buf[offsets[i] .. offsets[i] + lengths[i]) */
+static void hash_packed(const char* buf, const uint32_t* offsets, const uint32_t* lengths,
+                        int count, uint32_t* results) {
+#if defined(__AVX512F__) || defined(__AVX2__)
+    for (int base = 0; base < count; base += PACK_CHUNK) {
+        int chunk = count - base < PACK_CHUNK ? count - base : PACK_CHUNK;
+        hash_packed_window(buf, offsets + base, lengths + base, chunk, results + base);
+    }
+#else
+    for (int i = 0; i < count; i++) results[i] = wwise_hash_len(buf + offsets[i], (int)lengths[i]);
+#endif
+}
+
+/*
+ * Hash count strings packed in one buffer: string i is lengths[i] bytes at
+ * buf + offsets[i] (no terminator needed).  Same result as wwise_hash().
+ */
+EXPORT void wwise_hash_packed(
+    const char* buf,
+    const uint32_t* offsets,
+    const uint32_t* lengths,
+    int count,
+    uint32_t* results
+) {
+    hash_packed(buf, offsets, lengths, count, results);
+}
+
+/*
+ * Packed hashing straight into a target set: writes the indices of the
+ * strings whose hash is one of the set's IDs (up to max_hits) and returns
+ * the total number of such strings.
+ */
+EXPORT int wwise_hash_packed_match(
+    const char* buf,
+    const uint32_t* offsets,
+    const uint32_t* lengths,
+    int count,
+    const TargetSet* set,
+    int* hits,
+    int max_hits
+) {
+    uint64_t low16[1024] = {0};
+    uint32_t hashes[PACK_CHUNK];
+    int n = 0;
+
+    for (int i = 0; i < set->id_count; i++) {
+        low16[(set->ids[i] & 0xFFFF) >> 6] |= (uint64_t)1 << (set->ids[i] & 63);
+    }
+    for (int base = 0; base < count; base += PACK_CHUNK) {
+        int chunk = count - base < PACK_CHUNK ? count - base : PACK_CHUNK;
+        hash_packed(buf, offsets + base, lengths + base, chunk, hashes);
+        for (int i = 0; i < chunk; i++) {
+            uint32_t h = hashes[i];
+            if (!((low16[(h & 0xFFFF) >> 6] >> (h & 63)) & 1)) continue;
+            if (!is_target(h, set->ids, set->id_count)) continue;
+            if (n < max_hits) hits[n] = base + i;
+            n++;
+        }
+    }
+    return n;
+}
+
+/* ============================================================================
+ * CANDIDATE PIPELINE
+ * Variable-length candidates (word lists, template expansions, word
+ * permutations) flow through three stages: generate -> hash -> match.
+ * Generator threads append length-prefixed strings to arena-backed
+ * batches.  A full batch travels over a lock-free single-producer /
+ * single-consumer ring to a hashing thread, which fills the batch's hash
+ * column with the packed batch hasher and forwards it over its own ring
+ * to the match stage (the calling thread).  The matcher looks every hash
+ * up in the target filter and hands the batch back to its generator over
+ * that generator's free ring.
+ *
+ * Every generator owns PIPE_POOL batches and blocks on an empty free ring,
+ * so memory stays at generators * PIPE_POOL batches however large the
+ * candidate space, and no ring can overflow.  Generators are plugins: a
+ * PipeSourceFn walks its share of the space and calls pipe_emit() per
+ * candidate; add a PIPE_* kind and an entry in pipe_sources[] for more.
+ * Candidates longer than 31 bytes (the found_names width) are skipped and
+ * not counted; callers hash those themselves.
+ * ============================================================================ */
+
+#define PIPE_LIST       0       /* words as given */
+#define PIPE_TEMPLATES  1       /* every word through every template, "%s" = the word */
+#define PIPE_PERMUTE    2       /* `depth` distinct words in order, joined by separator */
+
+#define PIPE_BATCH_BYTES  (1 << 16)
+#define PIPE_BATCH_MAX    8192      /* candidates per batch */
+#define PIPE_POOL         8         /* batches per generator = ring capacity (power of two) */
+#define PIPE_MAX_STAGE    64        /* threads per stage */
+
+#ifdef _WIN32
+#define RING_LOAD(p)      ((uint32_t)InterlockedCompareExchange((volatile LONG*)(p), 0, 0))
+#define RING_STORE(p, v)  InterlockedExchange((volatile LONG*)(p), (LONG)(v))
+
+static void pipe_backoff(int* idle) {
+    if (++*idle < 64) SwitchToThread();
+    else Sleep(1);
+}
+#else
+#define RING_LOAD(p)      __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define RING_STORE(p, v)  __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
+static void pipe_backoff(int* idle) {
+    if (++*idle < 64) {
+        sched_yield();
+    } else {
+        struct timespec t = { 0, 50000 };
+        nanosleep(&t, NULL);
+    }
+}
+#endif
+
+typedef struct {
+    const char** words;
+    int word_count;
+    const char** templates;     /* TEMPLATES */
+    int template_count;
+    const char* separator;      /* PERMUTE, NULL = "_" */
+    int depth;                  /* PERMUTE */
+    int kind;                   /* PIPE_* */
+    int generators;             /* <= 0: a quarter of the cores */
+    int hashers;                /* <= 0: the remaining cores */
+    const uint32_t* targets;
+    int target_count;
+} PipeConfig;
+
+typedef struct {
+    int owner;                  /* generator the batch returns to */
+    int count;
+    int bytes;
+    uint32_t hashes[PIPE_BATCH_MAX];
+    uint8_t arena[PIPE_BATCH_BYTES];    /* count x [len][chars] */
+} PipeBatch;
+
+typedef struct {
+    PipeBatch* slots[PIPE_POOL];
+    volatile uint32_t head;     /* written by the producer only */
+    char pad[64 - sizeof(uint32_t)];    /* keep head and tail on separate lines */
+    volatile uint32_t tail;     /* written by the consumer only */
+    volatile uint32_t closed;   /* producer finished, set after its last push */
+} PipeRing;
+
+typedef struct {
+    const PipeConfig* cfg;
+    TargetFilter filter;
+    int generators;
+    int hashers;
+    int slot;                   /* first NUMA worker slot */
+    PipeBatch* batches;         /* generators * PIPE_POOL */
+    PipeRing* feed;             /* [generator * hashers + hasher] */
+    PipeRing* hashed;           /* [hasher] -> matcher */
+    PipeRing* spare;            /* [generator] <- matcher */
+} Pipeline;
+
+typedef struct {
+    Pipeline* pipe;
+    int index;
+    PipeBatch* batch;           /* being filled */
+} PipeWriter;
+
+typedef void (*PipeSourceFn)(const PipeConfig* cfg, PipeWriter* w, int share, int shares);
+
+static int pipe_ring_push(PipeRing* r, PipeBatch* b) {
+    uint32_t head = r->head;
+    if (head - RING_LOAD(&r->tail) == PIPE_POOL) return 0;
+    r->slots[head & (PIPE_POOL - 1)] = b;
+    RING_STORE(&r->head, head + 1);
+    return 1;
+}
+
+static PipeBatch* pipe_ring_pop(PipeRing* r) {
+    uint32_t tail = r->tail;
+    if (RING_LOAD(&r->head) == tail) return NULL;
+    PipeBatch* b = r->slots[tail & (PIPE_POOL - 1)];
+    RING_STORE(&r->tail, tail + 1);
+    return b;
+}
+
+/* Batches queued on a ring (approximate from the producer's side) */
+static uint32_t pipe_ring_depth(PipeRing* r) {
+    return r->head - RING_LOAD(&r->tail);
+}
+
+/* Hand the current batch to the least loaded hasher and take a free one */
+static void pipe_flush(PipeWriter* w) {
+    Pipeline* p = w->pipe;
+    PipeRing* feed = &p->feed[w->index * p->hashers];
+    int idle = 0;
+
+    if (w->batch && w->batch->count) {
+        for (;;) {
+            int best = 0;
+            for (int h = 1; h < p->hashers; h++) {
+                if (pipe_ring_depth(&feed[h]) < pipe_ring_depth(&feed[best])) best = h;
+            }
+            if (pipe_ring_push(&feed[best], w->batch)) break;
+            pipe_backoff(&idle);
+        }
+        w->batch = NULL;
+    }
+}
+
+static void pipe_emit(PipeWriter* w, const char* s, int len) {
+    if (len <= 0 || len > 31) return;
+    PipeBatch* b = w->batch;
+    if (b && (b->count == PIPE_BATCH_MAX || b->bytes + 1 + len > PIPE_BATCH_BYTES)) {
+        pipe_flush(w);
+        b = NULL;
+    }
+    if (!b) {
+        int idle = 0;
+        while (!(b = pipe_ring_pop(&w->pipe->spare[w->index]))) pipe_backoff(&idle);
+        b->count = 0;
+        b->bytes = 0;
+        w->batch = b;
+    }
+    b->arena[b->bytes] = (uint8_t)len;
+    memcpy(b->arena + b->bytes + 1, s, len);
+    b->bytes += 1 + len;
+    b->count++;
+}
+
+static void pipe_source_list(const PipeConfig* cfg, PipeWriter* w, int share, int shares) {
+    for (int i = share; i < cfg->word_count; i += shares) {
+        pipe_emit(w, cfg->words[i], (int)strlen(cfg->words[i]));
+    }
+}
+
+static void pipe_source_templates(const PipeConfig* cfg, PipeWriter* w, int share, int shares) {
+    char out[64];
+    for (int i = share; i < cfg->word_count; i += shares) {
+        const char* word = cfg->words[i];
+        int word_len = (int)strlen(word);
+        if (word_len > 31) continue;
+        for (int t = 0; t < cfg->template_count; t++) {
+            int len = 0;
+            for (const char* c = cfg->templates[t]; *c && len <= 31; c++) {
+                if (c[0] == '%' && c[1] == 's') {
+                    if (len + word_len > 31) { len = 32; break; }
+                    memcpy(out + len, word, word_len);
+                    len += word_len;
+                    c++;
+                } else {
+                    out[len++] = *c;
+                }
+            }
+            pipe_emit(w, out, len);
+        }
+    }
+}
+
+static void pipe_permute(const PipeConfig* cfg, PipeWriter* w, char* out, int len, int sep_len,
+                         int* used, int level) {
+    if (level == cfg->depth) {
+        pipe_emit(w, out, len);
+        return;
+    }
+    for (int i = 0; i < cfg->word_count; i++) {
+        if (used[i]) continue;
+        int word_len = (int)strlen(cfg->words[i]);
+        if (len + sep_len + word_len > 31) continue;
+        memcpy(out + len, cfg->separator ? cfg->separator : "_", sep_len);
+        memcpy(out + len + sep_len, cfg->words[i], word_len);
+        used[i] = 1;
+        pipe_permute(cfg, w, out, len + sep_len + word_len, sep_len, used, level + 1);
+        used[i] = 0;
+    }
+}
+
+static void pipe_source_permute(const PipeConfig* cfg, PipeWriter* w, int share, int shares) {
+    int sep_len = cfg->separator ? (int)strlen(cfg->separator) : 1;
+    int* used = (int*)calloc(cfg->word_count ? cfg->word_count : 1, sizeof(int));
+    char out[32];
+    if (!used || cfg->depth < 1) {
+        free(used);
+        return;
+    }
+    for (int i = share; i < cfg->word_count; i += shares) {
+        int len = (int)strlen(cfg->words[i]);
+        if (len > 31) continue;
+        memcpy(out, cfg->words[i], len);
+        used[i] = 1;
+        pipe_permute(cfg, w, out, len, sep_len, used, 1);
+        used[i] = 0;
+    }
+    free(used);
+}
+
+static const PipeSourceFn pipe_sources[] = {
+    pipe_source_list,           /* PIPE_LIST */
+    pipe_source_templates,      /* PIPE_TEMPLATES */
+    pipe_source_permute,        /* PIPE_PERMUTE */
+};
+
+typedef struct {
+    Pipeline* pipe;
+    int index;
+} PipeStage;
+
+THREAD_FUNC(pipe_generator, arg) {
+    PipeStage* s = (PipeStage*)arg;
+    Pipeline* p = s->pipe;
+    PipeWriter w = { p, s->index, NULL };
+
+    numa_pin_worker(p->slot + p->hashers + s->index);
+    pipe_sources[p->cfg->kind](p->cfg, &w, s->index, p->generators);
+    pipe_flush(&w);
+    for (int h = 0; h < p->hashers; h++) RING_STORE(&p->feed[s->index * p->hashers + h].closed, 1);
+    THREAD_RETURN;
+}
+
+THREAD_FUNC(pipe_hasher, arg) {
+    PipeStage* s = (PipeStage*)arg;
+    Pipeline* p = s->pipe;
+    PipeRing* out = &p->hashed[s->index];
+    uint32_t offsets[PIPE_BATCH_MAX], lengths[PIPE_BATCH_MAX];
+    int idle = 0;
+
+    numa_pin_worker(p->slot + s->index);
+    for (;;) {
+        int open = 0, busy = 0;
+        for (int g = 0; g < p->generators; g++) {
+            PipeRing* in = &p->feed[g * p->hashers + s->index];
+            uint32_t closed = RING_LOAD(&in->closed);   /* before the pop: no push can follow */
+            PipeBatch* b = pipe_ring_pop(in);
+            if (!b) {
+                open |= !closed;
+                continue;
+            }
+            uint32_t at = 0;
+            for (int i = 0; i < b->count; i++) {
+                lengths[i] = b->arena[at];
+                offsets[i] = at + 1;
+                at += 1 + lengths[i];
+            }
+            hash_packed((const char*)b->arena, offsets, lengths, b->count, b->hashes);
+            while (!pipe_ring_push(out, b)) pipe_backoff(&idle);
+            busy = open = 1;
+        }
+        if (!open) break;
+        if (busy) idle = 0;
+        else pipe_backoff(&idle);
+    }
+    RING_STORE(&out->closed, 1);
+    THREAD_RETURN;
+}
+
+/*
+ * Run one pipeline to completion on the calling thread (the match stage).
+ * Returns the number of unique matches; *tested receives the candidates
+ * hashed.  Returns 0 with *tested = 0 if the pipeline could not be set up.
+ */
+EXPORT int pipeline_search(
+    const PipeConfig* cfg,
+    uint32_t* found_hashes,
+    char (*found_names)[32],
+    int max_found,
+    uint64_t* tested
+) {
+    Pipeline p;
+    fnv_thread_t threads[2 * PIPE_MAX_STAGE];
+    PipeStage stages[2 * PIPE_MAX_STAGE];
+    int started = 0, found = 0;
+    uint64_t count = 0;
+    MatchIndex seen = {0};
+
+    if (tested) *tested = 0;
+    if (cfg->kind < 0 || cfg->kind > PIPE_PERMUTE || cfg->word_count <= 0) return 0;
+
+    memset(&p, 0, sizeof(p));
+    p.cfg = cfg;
+    int cores = fnv_cpu_count();
+    p.generators = cfg->generators > 0 ? cfg->generators : (cores / 4 > 0 ? cores / 4 : 1);
+    p.hashers = cfg->hashers > 0 ? cfg->hashers : (cores - p.generators > 0 ? cores - p.generators : 1);
+    if (p.generators > PIPE_MAX_STAGE) p.generators = PIPE_MAX_STAGE;
+    if (p.generators > cfg->word_count) p.generators = cfg->word_count;
+    if (p.hashers > PIPE_MAX_STAGE) p.hashers = PIPE_MAX_STAGE;
+
+    p.batches = (PipeBatch*)malloc(sizeof(PipeBatch) * p.generators * PIPE_POOL);
+    p.feed = (PipeRing*)calloc((size_t)p.generators * p.hashers, sizeof(PipeRing));
+    p.hashed = (PipeRing*)calloc(p.hashers, sizeof(PipeRing));
+    p.spare = (PipeRing*)calloc(p.generators, sizeof(PipeRing));
+    if (!p.batches || !p.feed || !p.hashed || !p.spare ||
+        !target_filter_build(&p.filter, cfg->targets, cfg->target_count, NULL, 0)) {
+        free(p.batches);
+        free(p.feed);
+        free(p.hashed);
+        free(p.spare);
+        return 0;
+    }
+    for (int g = 0; g < p.generators; g++) {
+        for (int i = 0; i < PIPE_POOL; i++) {
+            PipeBatch* b = &p.batches[g * PIPE_POOL + i];
+            b->owner = g;
+            pipe_ring_push(&p.spare[g], b);
+        }
+    }
+    p.slot = numa_reserve_slots(p.generators + p.hashers);
+
+    /* Hashers first: a generator may only ever feed a hasher that runs */
+    for (int h = 0; h < p.hashers; h++) {
+        stages[started].pipe = &p;
+        stages[started].index = h;
+        if (!fnv_thread_start(&threads[started], pipe_hasher, &stages[started])) break;
+        started++;
+    }
+    if (started < p.hashers) {
+        /* Too few threads: close every feed so the running hashers exit */
+        for (int i = 0; i < p.generators * p.hashers; i++) RING_STORE(&p.feed[i].closed, 1);
+        for (int h = started; h < p.hashers; h++) RING_STORE(&p.hashed[h].closed, 1);
+    } else {
+        for (int g = 0; g < p.generators; g++) {
+            stages[started].pipe = &p;
+            stages[started].index = g;
+            if (!fnv_thread_start(&threads[started], pipe_generator, &stages[started])) {
+                for (int h = 0; h < p.hashers; h++) RING_STORE(&p.feed[g * p.hashers + h].closed, 1);
+                continue;
+            }
+            started++;
+        }
+    }
+
+    /* Match stage */
+    int idle = 0;
+    for (;;) {
+        int open = 0, busy = 0;
+        for (int h = 0; h < p.hashers; h++) {
+            uint32_t closed = RING_LOAD(&p.hashed[h].closed);
+            PipeBatch* b = pipe_ring_pop(&p.hashed[h]);
+            if (!b) {
+                open |= !closed;
+                continue;
+            }
+            const uint8_t* rec = b->arena;
+            for (int i = 0; i < b->count; i++) {
+                if (target_filter_hit(&p.filter, b->hashes[i])) {
+                    char name[32];
+                    memcpy(name, rec + 1, rec[0]);
+                    name[rec[0]] = '\0';
+                    found = record_unique_match(b->hashes[i], name, 0,
+                                                found_hashes, found_names, NULL, found, max_found, &seen);
+                }
+                rec += 1 + rec[0];
+            }
+            count += b->count;
+            pipe_ring_push(&p.spare[b->owner], b);
+            busy = open = 1;
+        }
+        if (!open) break;
+        if (busy) idle = 0;
+        else pipe_backoff(&idle);
+    }
+
+    for (int i = 0; i < started; i++) fnv_thread_join(threads[i]);
+    target_filter_free(&p.filter);
+    match_index_free(&seen);
+    free(p.batches);
+    free(p.feed);
+    free(p.hashed);
+    free(p.spare);
+    if (tested) *tested = count;
+    return found;
+}
+
+/* ============================================================================
+ * COMPILED DICTIONARY
+ * Word lists are compiled once into a sorted, deduplicated, lowercased
+ * file that is memory-mapped on open (no parsing, near-instant even for
+ * merged multi-million-word lists).  Each word records its longest common
+ * prefix (LCP) with the previous word, so the compiler hashes only the
+ * non-shared characters, and stores its final FNV state plus the states
+ * after each of those characters (one per sorted-trie node).  Engines
+ * reuse them: plain lookups and the hybrid engine hash nothing per word,
+ * and template / combinator sweeps walk the words in order carrying a
+ * state stack, so each word costs only the characters it does not share
+ * with its predecessor.
+ *
+ * Layout: DictHeader, DictEntry[count], uint32 hashes[count],
+ * uint32 states[state_count], NUL-terminated text.
+ * ============================================================================ */
+
+#define DICT_MAGIC "FNVDICT1"
+#define DICT_MAX_WORD 31
+
+typedef struct {
+    char magic[8];
+    uint32_t count;
+    uint32_t state_count;
+    uint32_t text_bytes;
+    uint32_t reserved;
+} DictHeader;
+
+typedef struct {
+    uint32_t text;              /* offset of the word in the text block */
+    uint32_t state;             /* index of the state after character lcp + 1 */
+    uint8_t len;
+    uint8_t lcp;                /* characters shared with the previous word */
+    uint16_t reserved;
+} DictEntry;
+
+/* A read-only file mapping (mmap / CreateFileMapping) */
+typedef struct {
+    const uint8_t* base;
+    size_t size;
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#endif
+} MappedFile;
+
+typedef struct {
+    MappedFile map;
+    const DictEntry* entries;
+    const uint32_t* hashes;     /* final state of every word */
+    const uint32_t* states;
+    const char* text;
+    int count;
+    const char** words;         /* word pointers into the mapping, for const char** engines */
+} Dictionary;
+
+static int dict_string_compare(const void* a, const void* b) {
+    return strcmp(*(const char* const*)a, *(const char* const*)b);
+}
+
+/*
+ * Read word lists (one word per line, surrounding whitespace ignored, words
+ * over DICT_MAX_WORD characters dropped) into a lowercased, NUL-separated
+ * arena.  Returns 0 on I/O or allocation failure; the caller frees both
+ * buffers either way.
+ */
+static int dict_read_words(const char** paths, int path_count, char** arena_out, size_t* arena_bytes,
+                           uint32_t** offsets_out, int* word_count) {
+    char* arena = NULL;
+    size_t arena_size = 0, arena_max = 0;
+    uint32_t* offsets = NULL;
+    int count = 0, max = 0, ok = 0;
+    char line[4096];
+
+    for (int p = 0; p < path_count; p++) {
+        FILE* in = fopen(paths[p], "rb");
+        if (!in) goto done;
+        while (fgets(line, sizeof(line), in)) {
+            char* s = line;
+            int len = (int)strlen(s);
+            while (len > 0 && isspace((unsigned char)s[len - 1])) len--;
+            while (len > 0 && isspace((unsigned char)*s)) { s++; len--; }
+            if (len == 0 || len > DICT_MAX_WORD) continue;
+
+            if (arena_size + len + 1 > arena_max) {
+                size_t grown_max = arena_max ? arena_max * 2 : (1 << 20);
+                char* grown = (char*)realloc(arena, grown_max);
+                if (!grown) { fclose(in); goto done; }
+                arena = grown;
+                arena_max = grown_max;
+            }
+            if (count == max) {
+                int grown_max = max ? max * 2 : 65536;
+                uint32_t* grown = (uint32_t*)realloc(offsets, sizeof(uint32_t) * grown_max);
+                if (!grown) { fclose(in); goto done; }
+                offsets = grown;
+                max = grown_max;
+            }
+            offsets[count++] = (uint32_t)arena_size;
+            for (int i = 0; i < len; i++) arena[arena_size++] = (char)tolower((unsigned char)s[i]);
+            arena[arena_size++] = '\0';
+        }
+        fclose(in);
+    }
+    ok = 1;
+
+done:
+    *arena_out = arena;
+    *arena_bytes = arena_size;
+    *offsets_out = offsets;
+    *word_count = count;
+    return ok;
+}
+
+/*
+ * Compile word lists into out_path.  Returns the number of unique words,
+ * or -1 on I/O or allocation failure.
+ */
+EXPORT int dict_compile(const char** paths, int path_count, const char* out_path) {
+    char* arena = NULL;
+    size_t arena_size = 0;
+    uint32_t* offsets = NULL;
+    int count = 0, result = -1;
+
+    if (!dict_read_words(paths, path_count, &arena, &arena_size, &offsets, &count)) goto done;
+
+    const char** sorted = (const char**)malloc(sizeof(char*) * (count ? count : 1));
+    DictEntry* entries = (DictEntry*)calloc(count ? count : 1, sizeof(DictEntry));
+    uint32_t* hashes = (uint32_t*)malloc(sizeof(uint32_t) * (count ? count : 1));
+    uint32_t* states = (uint32_t*)malloc(sizeof(uint32_t) * (arena_size ? arena_size : 1));
+    char* text = (char*)malloc(arena_size ? arena_size : 1);
+    FILE* out = NULL;
+    if (!sorted || !entries || !hashes || !states || !text) goto cleanup;
+
+    for (int i = 0; i < count; i++) sorted[i] = arena + offsets[i];
+    qsort(sorted, count, sizeof(char*), dict_string_compare);
+
+    /* dedupe; hash only what each word does not share with the previous one */
+    uint32_t stack[DICT_MAX_WORD + 1];
+    uint32_t state_count = 0, text_bytes = 0;
+    const char* prev = "";
+    int unique = 0;
+    stack[0] = FNV_OFFSET;
+    for (int i = 0; i < count; i++) {
+        const char* w = sorted[i];
+        if (unique > 0 && strcmp(w, prev) == 0) continue;
+        int len = (int)strlen(w), lcp = 0;
+        while (prev[lcp] && prev[lcp] == w[lcp]) lcp++;
+
+        DictEntry* e = &entries[unique];
+        e->text = text_bytes;
+        e->state = state_count;
+        e->len = (uint8_t)len;
+        e->lcp = (uint8_t)lcp;
+        for (int k = lcp; k < len; k++) {
+            stack[k + 1] = (stack[k] * FNV_PRIME) ^ (uint8_t)w[k];
+            states[state_count++] = stack[k + 1];
+        }
+        hashes[unique] = stack[len];
+        memcpy(text + text_bytes, w, len + 1);
+        text_bytes += len + 1;
+        prev = w;
+        unique++;
+    }
+
+    DictHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, DICT_MAGIC, 8);
+    header.count = (uint32_t)unique;
+    header.state_count = state_count;
+    header.text_bytes = text_bytes;
+
+    out = fopen(out_path, "wb");
+    if (!out) goto cleanup;
+    if (fwrite(&header, sizeof(header), 1, out) == 1 &&
+        fwrite(entries, sizeof(DictEntry), unique, out) == (size_t)unique &&
+        fwrite(hashes, sizeof(uint32_t), unique, out) == (size_t)unique &&
+        fwrite(states, sizeof(uint32_t), state_count, out) == state_count &&
+        fwrite(text, 1, text_bytes, out) == text_bytes) {
+        result = unique;
+    }
+    if (fclose(out) != 0) result = -1;
+
+cleanup:
+    free(sorted);
+    free(entries);
+    free(hashes);
+    free(states);
+    free(text);
+done:
+    free(arena);
+    free(offsets);
+    return result;
+}
+
+static void unmap_file(MappedFile* m) {
+#ifdef _WIN32
+    if (m->base) UnmapViewOfFile(m->base);
+    if (m->mapping) CloseHandle(m->mapping);
+    if (m->file && m->file != INVALID_HANDLE_VALUE) CloseHandle(m->file);
+#else
+    if (m->base) munmap((void*)m->base, m->size);
+#endif
+    memset(m, 0, sizeof(*m));
+}
+
+/* Map a whole file read-only; returns 0 (nothing left mapped) if missing or empty */
+static int map_file(MappedFile* m, const char* path) {
+    memset(m, 0, sizeof(*m));
+#ifdef _WIN32
+    LARGE_INTEGER size;
+    m->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                          FILE_ATTRIBUTE_NORMAL, NULL);
+    if (m->file != INVALID_HANDLE_VALUE && GetFileSizeEx(m->file, &size) && size.QuadPart > 0) {
+        m->size = (size_t)size.QuadPart;
+        m->mapping = CreateFileMappingA(m->file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (m->mapping) m->base = (const uint8_t*)MapViewOfFile(m->mapping, FILE_MAP_READ, 0, 0, 0);
+    }
+#else
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+    if (fd >= 0 && fstat(fd, &st) == 0 && st.st_size > 0) {
+        m->size = (size_t)st.st_size;
+        void* base = mmap(NULL, m->size, PROT_READ, MAP_SHARED, fd, 0);
+        if (base != MAP_FAILED) m->base = (const uint8_t*)base;
+    }
+    if (fd >= 0) close(fd);
+#endif
+    if (!m->base) unmap_file(m);
+    return m->base != NULL;
+}
+
+/*
+ * Every entry's word must be NUL-terminated inside the text block, its
+ * states inside the state array, and its LCP no longer than the word or
+ * its predecessor (dict_prefix_state walks back through those).
+ */
+static int dict_entries_valid(const Dictionary* d, uint32_t state_count, uint32_t text_bytes) {
+    for (int i = 0; i < d->count; i++) {
+        const DictEntry* e = &d->entries[i];
+        if (e->len == 0 || e->len > DICT_MAX_WORD || e->lcp > e->len ||
+            e->lcp > (i ? d->entries[i - 1].len : 0) ||
+            (uint64_t)e->text + e->len >= text_bytes || d->text[e->text + e->len] != '\0' ||
+            memchr(d->text + e->text, '\0', e->len) ||
+            (uint64_t)e->state + (e->len - e->lcp) > state_count) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Map a compiled dictionary; returns NULL if missing, truncated, corrupt or not a dictionary */
+EXPORT Dictionary* dict_open(const char* path) {
+    Dictionary* d = (Dictionary*)calloc(1, sizeof(Dictionary));
+    if (!d) return NULL;
+
+    const DictHeader* h = map_file(&d->map, path) ? (const DictHeader*)d->map.base : NULL;
+    if (!h || d->map.size < sizeof(DictHeader) || memcmp(h->magic, DICT_MAGIC, 8) != 0 ||
+        h->count > INT32_MAX ||
+        d->map.size < sizeof(DictHeader) + (uint64_t)h->count * (sizeof(DictEntry) + sizeof(uint32_t)) +
+                      (uint64_t)h->state_count * sizeof(uint32_t) + h->text_bytes) {
+        unmap_file(&d->map);
+        free(d);
+        return NULL;
+    }
+    d->count = (int)h->count;
+    d->entries = (const DictEntry*)(d->map.base + sizeof(DictHeader));
+    d->hashes = (const uint32_t*)(d->entries + d->count);
+    d->states = d->hashes + d->count;
+    d->text = (const char*)(d->states + h->state_count);
+
+    d->words = dict_entries_valid(d, h->state_count, h->text_bytes)
+                   ? (const char**)malloc(sizeof(char*) * (d->count ? d->count : 1)) : NULL;
+    if (!d->words) {
+        unmap_file(&d->map);
+        free(d);
+        return NULL;
+    }
+    for (int i = 0; i < d->count; i++) d->words[i] = d->text + d->entries[i].text;
+    return d;
+}
+
+EXPORT void dict_close(Dictionary* d) {
+    if (!d) return;
+    unmap_file(&d->map);
+    free(d->words);
+    free(d);
+}
+
+EXPORT int dict_count(const Dictionary* d) {
+    return d->count;
+}
+
+/* The NUL-separated word block (sorted order); *bytes receives its size */
+EXPORT const char* dict_text(const Dictionary* d, uint32_t* bytes) {
+    if (bytes) *bytes = ((const DictHeader*)d->map.base)->text_bytes;
+    return d->text;
+}
+
+EXPORT uint32_t dict_hash(const Dictionary* d, int index) {
+    return d->hashes[index];
+}
+
+/* FNV state after the first k characters of word index (k <= its length) */
+EXPORT uint32_t dict_prefix_state(const Dictionary* d, int index, int k) {
+    if (k <= 0) return FNV_OFFSET;
+    while (index > 0 && k <= d->entries[index].lcp) index--;
+    return d->states[d->entries[index].state + k - d->entries[index].lcp - 1];
+}
+
+/* One sweep: every word between a fixed prefix and suffix */
+typedef struct {
+    char prefix[32];
+    int prefix_len;
+    uint32_t prefix_state;
+    const char* suffix;
+    int suffix_len;
+} DictAffix;
+
+typedef struct {
+    const Dictionary* d;
+    const char** templates;     /* template sweeps ("%s" = the word) */
+    const int* order;           /* template indices grouped by suffix */
+    const int* group_start;     /* item i = order[group_start[i] .. group_start[i + 1]) */
+    const int* first;           /* combinator: first-word indices */
+    const char* separator;
+    int item_count;
+    volatile long next_item;
+    const TargetFilter* shared; /* combinator filter (no suffix) */
+    const uint32_t* targets;
+    int target_count;
+    fnv_mutex_t lock;
+    MatchList out;
+    uint64_t tested;
+    int slot;
+} DictRun;
+
+typedef struct {
+    DictRun* run;
+    int index;
+} DictWorker;
+
+/*
+ * prefix + word + suffix for every word against a filter built with the
+ * suffix inverted out.  Words are visited in sorted order with a state
+ * stack, so only characters past the LCP are hashed; with an empty prefix
+ * the stored final states are used and nothing is hashed.
+ */
+static uint64_t dict_sweep(DictRun* run, const DictAffix* a, const TargetFilter* f) {
+    const Dictionary* d = run->d;
+    uint32_t stack[DICT_MAX_WORD + 1];
+    int fit = DICT_MAX_WORD - a->prefix_len - a->suffix_len;
+    int valid = 0;
+    uint64_t swept = 0;
+
+    stack[0] = a->prefix_state;
+    for (int i = 0; i < d->count; i++) {
+        const DictEntry* e = &d->entries[i];
+        if (e->lcp < valid) valid = e->lcp;
+        if (e->len > fit) continue;
+
+        uint32_t h;
+        if (a->prefix_len == 0) {
+            h = d->hashes[i];
+        } else {
+            const char* w = d->text + e->text;
+            for (int k = valid; k < e->len; k++) stack[k + 1] = (stack[k] * FNV_PRIME) ^ (uint8_t)w[k];
+            valid = e->len;
+            h = stack[e->len];
+        }
+        swept++;
+        if (!target_filter_hit(f, h)) continue;
+
+        char name[32];
+        memcpy(name, a->prefix, a->prefix_len);
+        memcpy(name + a->prefix_len, d->text + e->text, e->len);
+        memcpy(name + a->prefix_len + e->len, a->suffix, a->suffix_len);
+        name[a->prefix_len + e->len + a->suffix_len] = '\0';
+        uint32_t full = wwise_hash_len(name, a->prefix_len + e->len + a->suffix_len);
+        fnv_mutex_lock(&run->lock);
+        run->out.count = record_unique_match(full, name, 0, run->out.hashes, run->out.names, NULL,
+                                             run->out.count, run->out.max, &run->out.seen);
+        fnv_mutex_unlock(&run->lock);
+    }
+    return swept;
+}
+
+THREAD_FUNC(dict_worker, arg) {
+    DictWorker* w = (DictWorker*)arg;
+    DictRun* run = w->run;
+    const Dictionary* d = run->d;
+    uint64_t swept = 0;
+
+    numa_pin_worker(run->slot + w->index);
+    for (;;) {
+        int item = (int)ATOMIC_FETCH_ADD(&run->next_item, 1);
+        if (item >= run->item_count) break;
+
+        DictAffix a;
+        memset(&a, 0, sizeof(a));
+        a.suffix = "";
+        if (run->templates) {
+            /* "pre%ssuf" sharing one suffix: that suffix inverted out of the targets once, each prefix hashed once */
+            const char* first = run->templates[run->order[run->group_start[item]]];
+            TargetFilter f;
+            a.suffix = strstr(first, "%s") + 2;
+            a.suffix_len = (int)strlen(a.suffix);
+            if (a.suffix_len > DICT_MAX_WORD ||
+                !target_filter_build(&f, run->targets, run->target_count, a.suffix, a.suffix_len)) continue;
+            for (int g = run->group_start[item]; g < run->group_start[item + 1]; g++) {
+                const char* t = run->templates[run->order[g]];
+                a.prefix_len = (int)(strstr(t, "%s") - t);
+                if (a.prefix_len > DICT_MAX_WORD) continue;
+                for (int i = 0; i < a.prefix_len; i++) a.prefix[i] = (char)tolower((unsigned char)t[i]);
+                a.prefix_state = wwise_hash_len(a.prefix, a.prefix_len);
+                swept += dict_sweep(run, &a, &f);
+            }
+            target_filter_free(&f);
+        } else {
+            /* "first<sep>": the first word's stored state continued through the separator */
+            int first = run->first ? run->first[item] : item;
+            int sep_len = (int)strlen(run->separator);
+            if (first < 0 || first >= d->count || d->entries[first].len + sep_len > DICT_MAX_WORD) continue;
+            a.prefix_len = d->entries[first].len + sep_len;
+            memcpy(a.prefix, d->words[first], d->entries[first].len);
+            memcpy(a.prefix + d->entries[first].len, run->separator, sep_len);
+            a.prefix_state = wwise_hash_continue(d->hashes[first], run->separator);
+            swept += dict_sweep(run, &a, run->shared);
+        }
+    }
+    fnv_mutex_lock(&run->lock);
+    run->tested += swept;
+    fnv_mutex_unlock(&run->lock);
+    THREAD_RETURN;
+}
+
+static int dict_run(DictRun* run, int num_threads, uint64_t* tested) {
+    fnv_thread_t threads[MAX_THREADS];
+    DictWorker workers[MAX_THREADS];
+    int started = 0;
+
+    num_threads = resolve_thread_count(num_threads);
+    if (num_threads > run->item_count) num_threads = run->item_count > 0 ? run->item_count : 1;
+    fnv_mutex_init(&run->lock);
+    run->slot = numa_reserve_slots(num_threads);
+    for (; started < num_threads; started++) {
+        workers[started].run = run;
+        workers[started].index = started;
+        if (!fnv_thread_start(&threads[started], dict_worker, &workers[started])) break;
+    }
+    for (int t = 0; t < started; t++) fnv_thread_join(threads[t]);
+    fnv_mutex_destroy(&run->lock);
+    match_index_free(&run->out.seen);
+    if (tested) *tested = run->tested;
+    return run->out.count;
+}
+
+/*
+ * Every word through every template ("play_%s", "%s_loop", "%s": plain
+ * lookup); templates without "%s" are skipped.  Returns unique matches.
+ */
+EXPORT int dict_template_search(
+    const Dictionary* d,
+    const char** templates,
+    int template_count,
+    const uint32_t* targets,
+    int target_count,
+    int num_threads,
+    uint32_t* found_hashes,
+    char (*found_names)[32],
+    int max_found,
+    uint64_t* tested
+) {
+    DictRun run;
+    int* order = (int*)malloc(sizeof(int) * (template_count > 0 ? template_count : 1));
+    int* group_start = (int*)malloc(sizeof(int) * (template_count + 1 > 0 ? template_count + 1 : 1));
+    int n = 0, groups = 0;
+
+    if (tested) *tested = 0;
+    if (!order || !group_start) {
+        free(order);
+        free(group_start);
+        return 0;
+    }
+    for (int i = 0; i < template_count; i++) {
+        if (strstr(templates[i], "%s")) order[n++] = i;
+    }
+    /* group by suffix (insertion sort: template lists are short) */
+    for (int i = 1; i < n; i++) {
+        int t = order[i], j = i;
+        for (; j > 0 && strcmp(strstr(templates[order[j - 1]], "%s"), strstr(templates[t], "%s")) > 0; j--) {
+            order[j] = order[j - 1];
+        }
+        order[j] = t;
+    }
+    for (int i = 0; i < n; i++) {
+        if (i == 0 || strcmp(strstr(templates[order[i - 1]], "%s"), strstr(templates[order[i]], "%s")) != 0) {
+            group_start[groups++] = i;
+        }
+    }
+    group_start[groups] = n;
+
+    memset(&run, 0, sizeof(run));
+    run.d = d;
+    run.templates = templates;
+    run.order = order;
+    run.group_start = group_start;
+    run.item_count = groups;
+    run.targets = targets;
+    run.target_count = target_count;
+    run.out.hashes = found_hashes;
+    run.out.names = found_names;
+    run.out.max = max_found;
+    int found = groups ? dict_run(&run, num_threads, tested) : 0;
+    free(order);
+    free(group_start);
+    return found;
+}
+
+/*
+ * Two-word combinator: first word + separator + every word.  first lists
+ * the first-word indices (NULL: every word).  Returns unique matches.
+ */
+EXPORT int dict_combine_search(
+    const Dictionary* d,
+    const char* separator,
+    const int* first,
+    int first_count,
+    const uint32_t* targets,
+    int target_count,
+    int num_threads,
+    uint32_t* found_hashes,
+    char (*found_names)[32],
+    int max_found,
+    uint64_t* tested
+) {
+    DictRun run;
+    TargetFilter f;
+    if (tested) *tested = 0;
+    if (!target_filter_build(&f, targets, target_count, NULL, 0)) return 0;
+
+    memset(&run, 0, sizeof(run));
+    run.d = d;
+    run.first = first;
+    run.separator = separator ? separator : "";
+    run.item_count = first ? first_count : d->count;
+    run.shared = &f;
+    run.out.hashes = found_hashes;
+    run.out.names = found_names;
+    run.out.max = max_found;
+    int found = dict_run(&run, num_threads, tested);
+    target_filter_free(&f);
+    return found;
+}
+
+/* Hybrid attack (word + mask) over the dictionary, seeded with the stored word states */
+EXPORT int dict_hybrid_search(
+    const Dictionary* d,
+    const char* mask,
+    uint64_t start,
+    uint64_t end,
+    int backend,
+    const uint32_t* targets,
+    int target_count,
+    uint32_t* found_hashes,
+    char (*found_names)[32],
+    int max_found,
+    uint64_t* tested
+) {
+    return hybrid_run(d->words, d->hashes, d->count, mask, start, end, backend, targets, target_count,
+                      found_hashes, found_names, max_found, tested);
+}
+
+/* ============================================================================
+ * DAWG VOCABULARY
+ * For merged multi-million-word vocabularies a flat list wastes memory and
+ * re-hashes every shared prefix.  The vocabulary is compiled into a minimal
+ * directed acyclic word graph (Daciuk's incremental construction over the
+ * sorted words: shared prefixes and shared suffixes become shared nodes)
+ * and memory-mapped on open.  Sweeps walk it depth-first carrying the FNV
+ * state along the edges, so an edge costs one multiply-xor per visit no
+ * matter how many words pass through it.  At a word end the walk can
+ * continue through a separator back into the root, which emits multi-word
+ * concatenations without ever materialising the combinations.
+ *
+ * Layout: DawgHeader, DawgNode[node_count], uint32 edges[edge_count]
+ * (target node << 8 | character, sorted by character within a node).
+ * ============================================================================ */
+
+#define DAWG_MAGIC "FNVDAWG1"
+#define DAWG_MAX_NODES (1u << 24)   /* edge targets are 24-bit */
+#define DAWG_MAX_WORDS 8
+
+typedef struct {
+    char magic[8];
+    uint32_t word_count;
+    uint32_t node_count;
+    uint32_t edge_count;
+    uint32_t root;
+} DawgHeader;
+
+typedef struct {
+    uint32_t first_edge;
+    uint16_t edge_count;
+    uint8_t final;              /* a word ends here */
+    uint8_t shortest;           /* fewest characters to a word end (length pruning) */
+} DawgNode;
+
+typedef struct {
+    MappedFile map;
+    const DawgNode* nodes;
+    const uint32_t* edges;
+    uint32_t root;
+    uint32_t word_count;
+    uint32_t node_count;
+} Dawg;
+
+/* A node on the current word's path: edges still open until it is frozen */
+typedef struct {
+    uint32_t edges[256];
+    int count;
+    int final;
+} DawgPending;
+
+typedef struct {
+    DawgNode* nodes;
+    uint32_t node_count, node_max;
+    uint32_t* edges;
+    uint32_t edge_count, edge_max;
+    uint32_t* table;            /* register of frozen nodes: id + 1, 0 = empty */
+    uint32_t table_mask;
+} DawgBuilder;
+
+static uint32_t dawg_node_hash(int final, const uint32_t* edges, int count) {
+    uint32_t h = (FNV_OFFSET ^ (uint32_t)final) * FNV_PRIME;
+    for (int i = 0; i < count; i++) h = (h ^ edges[i]) * FNV_PRIME;
+    return h ^ (h >> 15);
+}
+
+static void dawg_register(DawgBuilder* b, uint32_t id, uint32_t h) {
+    uint32_t i = h & b->table_mask;
+    while (b->table[i]) i = (i + 1) & b->table_mask;
+    b->table[i] = id + 1;
+}
+
+/* Replace a pending node by its frozen equivalent, adding it if it is new; UINT32_MAX on failure */
+static uint32_t dawg_freeze(DawgBuilder* b, const DawgPending* p) {
+    uint32_t h = dawg_node_hash(p->final, p->edges, p->count);
+    for (uint32_t i = h & b->table_mask; b->table[i]; i = (i + 1) & b->table_mask) {
+        const DawgNode* n = &b->nodes[b->table[i] - 1];
+        if (n->final == p->final && n->edge_count == p->count &&
+            memcmp(b->edges + n->first_edge, p->edges, sizeof(uint32_t) * p->count) == 0) {
+            return b->table[i] - 1;
+        }
+    }
+
+    if (b->node_count >= DAWG_MAX_NODES) return UINT32_MAX;
+    if (b->node_count == b->node_max) {
+        uint32_t grown_max = b->node_max * 2;
+        DawgNode* grown = (DawgNode*)realloc(b->nodes, sizeof(DawgNode) * grown_max);
+        if (!grown) return UINT32_MAX;
+        b->nodes = grown;
+        b->node_max = grown_max;
+    }
+    while (b->edge_count + p->count > b->edge_max) {
+        uint32_t grown_max = b->edge_max * 2;
+        uint32_t* grown = (uint32_t*)realloc(b->edges, sizeof(uint32_t) * grown_max);
+        if (!grown) return UINT32_MAX;
+        b->edges = grown;
+        b->edge_max = grown_max;
+    }
+    if ((b->node_count + 1) * 2 > b->table_mask + 1) {
+        /* keep the register at most half full */
+        uint32_t size = (b->table_mask + 1) * 2;
+        uint32_t* grown = (uint32_t*)calloc(size, sizeof(uint32_t));
+        if (!grown) return UINT32_MAX;
+        free(b->table);
+        b->table = grown;
+        b->table_mask = size - 1;
+        for (uint32_t id = 0; id < b->node_count; id++) {
+            const DawgNode* n = &b->nodes[id];
+            dawg_register(b, id, dawg_node_hash(n->final, b->edges + n->first_edge, n->edge_count));
+        }
+    }
+
+    uint32_t id = b->node_count++;
+    DawgNode* n = &b->nodes[id];
+    n->first_edge = b->edge_count;
+    n->edge_count = (uint16_t)p->count;
+    n->final = (uint8_t)p->final;
+    n->shortest = p->final ? 0 : DICT_MAX_WORD;
+    for (int i = 0; i < p->count; i++) {
+        int through = 1 + b->nodes[p->edges[i] >> 8].shortest;
+        if (through < n->shortest) n->shortest = (uint8_t)through;
+    }
+    memcpy(b->edges + b->edge_count, p->edges, sizeof(uint32_t) * p->count);
+    b->edge_count += p->count;
+    dawg_register(b, id, h);
+    return id;
+}
+
+/*
+ * Compile word lists (same input rules as dict_compile) into a DAWG at
+ * out_path.  Returns the number of unique words, or -1 on I/O or
+ * allocation failure or more than DAWG_MAX_NODES nodes.
+ */
+EXPORT int dawg_compile(const char** paths, int path_count, const char* out_path) {
+    char* arena = NULL;
+    size_t arena_size = 0;
+    uint32_t* offsets = NULL;
+    const char** sorted = NULL;
+    DawgPending* path = NULL;
+    DawgBuilder b;
+    int count = 0, unique = 0, result = -1;
+
+    memset(&b, 0, sizeof(b));
+    if (!dict_read_words(paths, path_count, &arena, &arena_size, &offsets, &count)) goto done;
+    sorted = (const char**)malloc(sizeof(char*) * (count ? count : 1));
+    path = (DawgPending*)calloc(DICT_MAX_WORD + 1, sizeof(DawgPending));
+    b.node_max = 1 << 16;
+    b.edge_max = 1 << 16;
+    b.table_mask = (1 << 17) - 1;
+    b.nodes = (DawgNode*)malloc(sizeof(DawgNode) * b.node_max);
+    b.edges = (uint32_t*)malloc(sizeof(uint32_t) * b.edge_max);
+    b.table = (uint32_t*)calloc(b.table_mask + 1, sizeof(uint32_t));
+    if (!sorted || !path || !b.nodes || !b.edges || !b.table) goto done;
+
+    for (int i = 0; i < count; i++) sorted[i] = arena + offsets[i];
+    qsort(sorted, count, sizeof(char*), dict_string_compare);
+
+    /* path[k] is the node after k characters of the previous word; everything past the LCP is final */
+    const char* prev = "";
+    int prev_len = 0;
+    for (int i = 0; i < count; i++) {
+        const char* w = sorted[i];
+        if (unique > 0 && strcmp(w, prev) == 0) continue;
+        int len = (int)strlen(w), lcp = 0;
+        while (prev[lcp] && prev[lcp] == w[lcp]) lcp++;
+
+        for (int k = prev_len; k > lcp; k--) {
+            uint32_t id = dawg_freeze(&b, &path[k]);
+            if (id == UINT32_MAX) goto done;
+            path[k - 1].edges[path[k - 1].count++] = (id << 8) | (uint8_t)prev[k - 1];
+        }
+        for (int k = lcp + 1; k <= len; k++) {
+            path[k].count = 0;
+            path[k].final = 0;
+        }
+        path[len].final = 1;
+        prev = w;
+        prev_len = len;
+        unique++;
+    }
+    for (int k = prev_len; k > 0; k--) {
+        uint32_t id = dawg_freeze(&b, &path[k]);
+        if (id == UINT32_MAX) goto done;
+        path[k - 1].edges[path[k - 1].count++] = (id << 8) | (uint8_t)prev[k - 1];
+    }
+    uint32_t root = dawg_freeze(&b, &path[0]);
+    if (root == UINT32_MAX) goto done;
+
+    DawgHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, DAWG_MAGIC, 8);
+    header.word_count = (uint32_t)unique;
+    header.node_count = b.node_count;
+    header.edge_count = b.edge_count;
+    header.root = root;
+
+    FILE* out = fopen(out_path, "wb");
+    if (!out) goto done;
+    if (fwrite(&header, sizeof(header), 1, out) == 1 &&
+        fwrite(b.nodes, sizeof(DawgNode), b.node_count, out) == b.node_count &&
+        fwrite(b.edges, sizeof(uint32_t), b.edge_count, out) == b.edge_count) {
+        result = unique;
+    }
+    if (fclose(out) != 0) result = -1;
+
+done:
+    free(arena);
+    free(offsets);
+    free(sorted);
+    free(path);
+    free(b.nodes);
+    free(b.edges);
+    free(b.table);
+    return result;
+}
+
+/* Map a compiled DAWG; returns NULL if missing, truncated or not a DAWG */
+EXPORT Dawg* dawg_open(const char* path) {
+    Dawg* g = (Dawg*)calloc(1, sizeof(Dawg));
+    if (!g) return NULL;
+
+    const DawgHeader* h = map_file(&g->map, path) ? (const DawgHeader*)g->map.base : NULL;
+    if (!h || g->map.size < sizeof(DawgHeader) || memcmp(h->magic, DAWG_MAGIC, 8) != 0 ||
+        h->root >= h->node_count ||
+        g->map.size < sizeof(DawgHeader) + (uint64_t)h->node_count * sizeof(DawgNode) +
+                      (uint64_t)h->edge_count * sizeof(uint32_t)) {
+        unmap_file(&g->map);
+        free(g);
+        return NULL;
+    }
+    g->nodes = (const DawgNode*)(g->map.base + sizeof(DawgHeader));
+    g->edges = (const uint32_t*)(g->nodes + h->node_count);
+    g->root = h->root;
+    g->word_count = h->word_count;
+    g->node_count = h->node_count;
+    return g;
+}
+
+EXPORT void dawg_close(Dawg* g) {
+    if (!g) return;
+    unmap_file(&g->map);
+    free(g);
+}
+
+EXPORT int dawg_word_count(const Dawg* g) {
+    return (int)g->word_count;
+}
+
+EXPORT int dawg_node_count(const Dawg* g) {
+    return (int)g->node_count;
+}
+
+/* A unit of work: a root edge and one edge below it, or the root edge's own word end */
+#define DAWG_ITEM_END 0xFFFFFFFFu
+
+typedef struct {
+    uint32_t first;             /* edge indices into Dawg.edges */
+    uint32_t second;            /* DAWG_ITEM_END: the one-character word (and what follows it) */
+} DawgItem;
+
+typedef struct {
+    const Dawg* g;
+    char prefix[32];
+    int prefix_len;
+    uint32_t prefix_state;
+    char separator[32];
+    int separator_len;
+    const char* suffix;
+    int suffix_len;
+    int max_words;
+    int fit;                    /* longest name before the suffix */
+    TargetFilter filter;        /* suffix inverted out of the targets */
+    const DawgItem* items;
+    int item_count;
+    volatile long next_item;
+    fnv_mutex_t lock;
+    MatchList out;
+    uint64_t tested;
+    int slot;
+} DawgRun;
+
+typedef struct {
+    DawgRun* run;
+    int index;
+    char name[32];
+    uint64_t tested;
+} DawgWalker;
+
+static void dawg_record(DawgWalker* w, int len) {
+    DawgRun* run = w->run;
+    memcpy(w->name + len, run->suffix, run->suffix_len);
+    w->name[len + run->suffix_len] = '\0';
+    uint32_t full = wwise_hash_len(w->name, len + run->suffix_len);
+    fnv_mutex_lock(&run->lock);
+    run->out.count = record_unique_match(full, w->name, 0, run->out.hashes, run->out.names, NULL,
+                                         run->out.count, run->out.max, &run->out.seen);
+    fnv_mutex_unlock(&run->lock);
+}
+
+static void dawg_walk(DawgWalker* w, uint32_t node, uint32_t state, int len, int words);
+
+/* A word ends at name[0..len) with state h: test it, then go on through the separator */
+static void dawg_word_end(DawgWalker* w, uint32_t h, int len, int words) {
+    DawgRun* run = w->run;
+    w->tested++;
+    if (target_filter_hit(&run->filter, h)) dawg_record(w, len);
+    if (words < run->max_words && len + run->separator_len < run->fit) {
+        /* back into the root for the next word */
+        uint32_t s = h;
+        for (int i = 0; i < run->separator_len; i++) {
+            s = (s * FNV_PRIME) ^ (uint8_t)run->separator[i];
+            w->name[len + i] = run->separator[i];
+        }
+        dawg_walk(w, run->g->root, s, len + run->separator_len, words + 1);
+    }
+}
+
+/* Follow one edge: its character is hashed once for every word below it */
+static void dawg_edge(DawgWalker* w, uint32_t edge, uint32_t state, int len, int words) {
+    DawgRun* run = w->run;
+    uint32_t target = edge >> 8;
+    uint32_t h = (state * FNV_PRIME) ^ (edge & 0xFF);
+
+    if (len + 1 + run->g->nodes[target].shortest > run->fit) return;   /* no word end fits below */
+    w->name[len++] = (char)(edge & 0xFF);
+    if (run->g->nodes[target].final) dawg_word_end(w, h, len, words);
+    dawg_walk(w, target, h, len, words);
+}
+
+static void dawg_walk(DawgWalker* w, uint32_t node, uint32_t state, int len, int words) {
+    const Dawg* g = w->run->g;
+    if (len >= w->run->fit) return;
+    const DawgNode* n = &g->nodes[node];
+    for (uint32_t e = n->first_edge; e < n->first_edge + n->edge_count; e++) {
+        dawg_edge(w, g->edges[e], state, len, words);
+    }
+}
+
+THREAD_FUNC(dawg_worker, arg) {
+    DawgWalker* w = (DawgWalker*)arg;
+    DawgRun* run = w->run;
+    const Dawg* g = run->g;
+    int len = run->prefix_len + 1;
+
+    numa_pin_worker(run->slot + w->index);
+    memcpy(w->name, run->prefix, run->prefix_len);
+    for (;;) {
+        long item = ATOMIC_FETCH_ADD(&run->next_item, 1);
+        if (item >= run->item_count) break;
+        uint32_t first = g->edges[run->items[item].first], second = run->items[item].second;
+        uint32_t target = first >> 8;
+        uint32_t h = (run->prefix_state * FNV_PRIME) ^ (first & 0xFF);
+
+        if (len + g->nodes[target].shortest > run->fit) continue;
+        w->name[run->prefix_len] = (char)(first & 0xFF);
+        if (second == DAWG_ITEM_END) {
+            if (g->nodes[target].final) dawg_word_end(w, h, len, 1);
+        } else if (len < run->fit) {
+            dawg_edge(w, g->edges[second], h, len, 1);
+        }
+    }
+    fnv_mutex_lock(&run->lock);
+    run->tested += w->tested;
+    fnv_mutex_unlock(&run->lock);
+    THREAD_RETURN;
+}
+
+/*
+ * prefix + word (+ separator + word ... up to max_words words) + suffix,
+ * names at most max_len characters (0 or over 31: 31).  Work is split
+ * across threads by the first word's first two characters (each root edge
+ * and each edge below it), so a vocabulary where most words share a few
+ * initials still spreads over every thread.  Returns unique matches;
+ * *tested receives the candidates swept.
+ */
+EXPORT int dawg_search(
+    const Dawg* g,
+    const char* prefix,
+    const char* separator,
+    const char* suffix,
+    int max_words,
+    int max_len,
+    const uint32_t* targets,
+    int target_count,
+    int num_threads,
+    uint32_t* found_hashes,
+    char (*found_names)[32],
+    int max_found,
+    uint64_t* tested
+) {
+    fnv_thread_t threads[MAX_THREADS];
+    DawgWalker* walkers;
+    DawgItem* items;
+    DawgRun run;
+    int started = 0;
+
+    if (tested) *tested = 0;
+    prefix = prefix ? prefix : "";
+    separator = separator ? separator : "";
+    suffix = suffix ? suffix : "";
+    if (max_len <= 0 || max_len > DICT_MAX_WORD) max_len = DICT_MAX_WORD;
+
+    memset(&run, 0, sizeof(run));
+    run.g = g;
+    run.prefix_len = (int)strlen(prefix);
+    run.separator_len = (int)strlen(separator);
+    run.suffix = suffix;
+    run.suffix_len = (int)strlen(suffix);
+    if (run.prefix_len > DICT_MAX_WORD || run.separator_len > DICT_MAX_WORD) return 0;
+    for (int i = 0; i < run.prefix_len; i++) run.prefix[i] = (char)tolower((unsigned char)prefix[i]);
+    for (int i = 0; i < run.separator_len; i++) run.separator[i] = (char)tolower((unsigned char)separator[i]);
+    run.prefix_state = wwise_hash_len(run.prefix, run.prefix_len);
+    run.max_words = max_words < 1 ? 1 : (max_words > DAWG_MAX_WORDS ? DAWG_MAX_WORDS : max_words);
+    run.fit = max_len - run.suffix_len;
+    run.out.hashes = found_hashes;
+    run.out.names = found_names;
+    run.out.max = max_found;
+    if (run.fit <= run.prefix_len || g->nodes[g->root].edge_count == 0) return 0;
+    if (!target_filter_build(&run.filter, targets, target_count, suffix, run.suffix_len)) return 0;
+
+    const DawgNode* root = &g->nodes[g->root];
+    for (uint32_t e = root->first_edge; e < root->first_edge + root->edge_count; e++) {
+        run.item_count += 1 + g->nodes[g->edges[e] >> 8].edge_count;
+    }
+    items = (DawgItem*)malloc(sizeof(DawgItem) * run.item_count);
+    num_threads = resolve_thread_count(num_threads);
+    if (num_threads > run.item_count) num_threads = run.item_count;
+    walkers = (DawgWalker*)calloc(num_threads, sizeof(DawgWalker));
+    if (!items || !walkers) {
+        free(items);
+        free(walkers);
+        target_filter_free(&run.filter);
+        return 0;
+    }
+    run.item_count = 0;
+    for (uint32_t e = root->first_edge; e < root->first_edge + root->edge_count; e++) {
+        const DawgNode* child = &g->nodes[g->edges[e] >> 8];
+        items[run.item_count].first = e;
+        items[run.item_count++].second = DAWG_ITEM_END;
+        for (uint32_t c = child->first_edge; c < child->first_edge + child->edge_count; c++) {
+            items[run.item_count].first = e;
+            items[run.item_count++].second = c;
+        }
+    }
+    run.items = items;
+    fnv_mutex_init(&run.lock);
+    run.slot = numa_reserve_slots(num_threads);
+    for (; started < num_threads; started++) {
+        walkers[started].run = &run;
+        walkers[started].index = started;
+        if (!fnv_thread_start(&threads[started], dawg_worker, &walkers[started])) break;
+    }
+    for (int t = 0; t < started; t++) fnv_thread_join(threads[t]);
+    fnv_mutex_destroy(&run.lock);
+    free(walkers);
+    free(items);
+    target_filter_free(&run.filter);
+    match_index_free(&run.out.seen);
+    if (tested) *tested = run.tested;
+    return run.out.count;
+}
+
+/* ============================================================================
+ * STREAM MATCHING
+ * Any external generator can feed the native hasher through a pipe or FIFO
+ * instead of re-implementing FNV or calling ctypes per string.  The calling
+ * thread reads newline- or NUL-delimited candidates in STREAM_BLOCK-sized
+ * blocks and hands each block, cut after its last delimiter, to a worker.
+ * Slots are filled and drained in a fixed round-robin order, two per
+ * worker, so no queue is needed and reading overlaps hashing.  Workers
+ * split lines with a 32-byte AVX2 delimiter scan (memchr elsewhere), hash
+ * them with the packed batch hasher and write only the matches, one line
+ * per set entry hit: name, ID, class, bank.  Lines over a whole block long
+ * are dropped.
+ * ============================================================================ */
+
+#define STREAM_BLOCK    (1 << 22)
+#define STREAM_FILL     (1 << 18)   /* read until this much is buffered (or EOF) */
+#define STREAM_LINES    PACK_CHUNK  /* lines hashed per packed call */
+#define STREAM_OUT      (1 << 16)
+#define STREAM_MAX_TAGS 64          /* set entries reported per matching line */
+
+static const char* const target_class_names[TARGET_CLASS_COUNT] = {
+    "event", "switch_group", "switch", "state_group", "state", "rtpc", "bus", "bank"
+};
+
+#ifdef _WIN32
+#define stream_read(fd, p, n)   _read(fd, p, (unsigned)(n))
+#define stream_write(fd, p, n)  _write(fd, p, (unsigned)(n))
+#else
+#define stream_read(fd, p, n)   read(fd, p, n)
+#define stream_write(fd, p, n)  write(fd, p, n)
+#endif
+
+typedef struct {
+    char* buf;
+    uint32_t start;             /* first byte of the first whole line */
+    uint32_t end;               /* one past the last delimiter (or EOF) */
+    volatile uint32_t full;     /* set by the reader, cleared by the worker */
+} StreamSlot;
+
+typedef struct {
+    const TargetSet* set;
+    const char** bank_names;
+    int bank_count;
+    char delimiter;
+    int out_fd;
+    int workers;
+    StreamSlot* slots;          /* 2 * workers; slot s belongs to worker s % workers */
+    volatile uint32_t done;     /* reader finished, set after its last fill */
+    uint64_t low16[1024];       /* low-16-bit prefilter over set->ids */
+    fnv_mutex_t lock;           /* output and totals */
+    int64_t matches;
+    uint64_t tested;
+    int slot;
+} StreamRun;
+
+typedef struct {
+    StreamRun* run;
+    int index;
+    uint32_t offsets[STREAM_LINES];
+    uint32_t lengths[STREAM_LINES];
+    uint32_t hashes[STREAM_LINES];
+    int count;                  /* lines collected for the next packed call */
+    int64_t found;
+    uint64_t tested;
+    char out[STREAM_OUT];
+    int out_len;
+} StreamWorker;
+
+static void stream_write_all(int fd, const char* p, size_t n) {
+    while (n > 0) {
+        long w = (long)stream_write(fd, p, n);
+        if (w < 0 && errno == EINTR) continue;
+        if (w <= 0) return;
+        p += w;
+        n -= (size_t)w;
+    }
+}
+
+static void stream_flush(StreamWorker* w) {
+    if (w->out_len == 0) return;
+    fnv_mutex_lock(&w->run->lock);
+    stream_write_all(w->run->out_fd, w->out, (size_t)w->out_len);
+    fnv_mutex_unlock(&w->run->lock);
+    w->out_len = 0;
+}
+
+/* Hash one batch of lines and format a line per set entry hit */
+static int64_t stream_match_lines(StreamWorker* w, const char* buf, int count) {
+    const StreamRun* run = w->run;
+    const TargetSet* set = run->set;
+    int64_t found = 0;
+
+    hash_packed(buf, w->offsets, w->lengths, count, w->hashes);
+    for (int i = 0; i < count; i++) {
+        uint32_t h = w->hashes[i];
+        int entries[STREAM_MAX_TAGS];
+        if (!((run->low16[(h & 0xFFFF) >> 6] >> (h & 63)) & 1)) continue;
+        int hits = target_set_classify(set, h, entries, STREAM_MAX_TAGS);
+        for (int e = 0; e < hits && e < STREAM_MAX_TAGS; e++) {
+            const TaggedTarget* t = &set->entries[entries[e]];
+            char bank[16];
+            const char* bank_name = bank;
+            if (t->bank == TARGET_BANK_NONE) bank_name = "-";
+            else if (run->bank_names && t->bank < run->bank_count) bank_name = run->bank_names[t->bank];
+            else snprintf(bank, sizeof(bank), "%u", t->bank);
+
+            int need = (int)w->lengths[i] + (int)strlen(bank_name) + 40;
+            if (w->out_len + need > STREAM_OUT) stream_flush(w);
+            if (need > STREAM_OUT) continue;
+            memcpy(w->out + w->out_len, buf + w->offsets[i], w->lengths[i]);
+            w->out_len += (int)w->lengths[i];
+            w->out_len += snprintf(w->out + w->out_len, STREAM_OUT - w->out_len, "\t0x%08X\t%s\t%s\n",
+                                   t->id, target_class_names[t->cls], bank_name);
+            found++;
+        }
+    }
+    return found;
+}
+
+/* Queue buf[line, at) (at: its delimiter or the block end), matching every STREAM_LINES lines */
+static inline void stream_line(StreamWorker* w, const char* buf, uint32_t line, uint32_t at) {
+    uint32_t len = at - line;
+    if (w->run->delimiter == '\n' && len > 0 && buf[at - 1] == '\r') len--;
+    if (len == 0) return;
+    w->offsets[w->count] = line;
+    w->lengths[w->count] = len;
+    if (++w->count == STREAM_LINES) {
+        w->found += stream_match_lines(w, buf, w->count);
+        w->tested += w->count;
+        w->count = 0;
+    }
+}
+
+/* Split buf[start, end) into lines and match them */
+static void stream_process(StreamWorker* w, const char* buf, uint32_t start, uint32_t end) {
+    const char delim = w->run->delimiter;
+    uint32_t line = start, p = start;
+
+#ifdef __AVX2__
+    const __m256i d = _mm256_set1_epi8(delim);
+    for (; p + 32 <= end; p += 32) {
+        uint32_t bits = (uint32_t)_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(buf + p)), d));
+        while (bits) {
+            uint32_t at = p + (uint32_t)__builtin_ctz(bits);
+            bits &= bits - 1;
+            stream_line(w, buf, line, at);
+            line = at + 1;
+        }
+    }
+#endif
+    for (const char* q; p < end && (q = (const char*)memchr(buf + p, delim, end - p)); ) {
+        p = (uint32_t)(q - buf);
+        stream_line(w, buf, line, p);
+        line = ++p;
+    }
+    if (line < end) stream_line(w, buf, line, end);
+    if (w->count) {
+        w->found += stream_match_lines(w, buf, w->count);
+        w->tested += w->count;
+        w->count = 0;
+    }
+}
+
+THREAD_FUNC(stream_worker, arg) {
+    StreamWorker* w = (StreamWorker*)arg;
+    StreamRun* run = w->run;
+    int idle = 0;
+
+    numa_pin_worker(run->slot + w->index);
+    for (uint32_t seq = 0;; seq++) {
+        StreamSlot* s = &run->slots[(w->index + seq * run->workers) % (2 * run->workers)];
+        for (;;) {
+            uint32_t done = RING_LOAD(&run->done);     /* before the check: no fill can follow */
+            if (RING_LOAD(&s->full)) break;
+            if (done) goto finished;
+            pipe_backoff(&idle);
+        }
+        idle = 0;
+        stream_process(w, s->buf, s->start, s->end);
+        stream_flush(w);
+        RING_STORE(&s->full, 0);
+    }
+finished:
+    stream_flush(w);
+    fnv_mutex_lock(&run->lock);
+    run->matches += w->found;
+    run->tested += w->tested;
+    fnv_mutex_unlock(&run->lock);
+    THREAD_RETURN;
+}
+
+/*
+ * Match every line read from in_fd (until EOF) against a tagged set and
+ * write "name\t0xID\tclass\tbank\n" to out_fd for every entry hit.
+ * delimiter is '\n' (a trailing '\r' is stripped) or '\0'; empty lines are
+ * skipped.  bank_names (may be NULL) name the set's bank indices.  Returns
+ * the number of lines written, or -1 if the run could not be set up;
+ * *tested receives the candidates hashed.
+ */
+EXPORT int64_t stream_match(
+    int in_fd,
+    int out_fd,
+    const TargetSet* set,
+    const char** bank_names,
+    int bank_count,
+    int delimiter,
+    int num_threads,
+    uint64_t* tested
+) {
+    fnv_thread_t threads[MAX_THREADS];
+    StreamWorker* workers;
+    StreamRun* run;
+    char* carry;
+    uint32_t carry_len = 0;
+    int started = 0, slot_count, skipping = 0, eof = 0, idle = 0;
+
+    if (tested) *tested = 0;
+    run = (StreamRun*)calloc(1, sizeof(StreamRun));
+    if (!run) return -1;
+    run->set = set;
+    run->bank_names = bank_names;
+    run->bank_count = bank_names ? bank_count : 0;
+    run->delimiter = (char)delimiter;
+    run->out_fd = out_fd;
+    run->workers = resolve_thread_count(num_threads);
+    for (int i = 0; i < set->id_count; i++) {
+        run->low16[(set->ids[i] & 0xFFFF) >> 6] |= (uint64_t)1 << (set->ids[i] & 63);
+    }
+
+    slot_count = 2 * run->workers;
+    workers = (StreamWorker*)calloc(run->workers, sizeof(StreamWorker));
+    run->slots = (StreamSlot*)calloc(slot_count, sizeof(StreamSlot));
+    carry = (char*)malloc(STREAM_BLOCK);
+    int ok = workers && run->slots && carry;
+    for (int i = 0; ok && i < slot_count; i++) {
+        run->slots[i].buf = (char*)malloc(STREAM_BLOCK);
+        ok = run->slots[i].buf != NULL;
+    }
+    if (!ok) goto cleanup;
+
+    fnv_mutex_init(&run->lock);
+    run->slot = numa_reserve_slots(run->workers);
+    for (; started < run->workers; started++) {
+        workers[started].run = run;
+        workers[started].index = started;
+        if (!fnv_thread_start(&threads[started], stream_worker, &workers[started])) break;
+    }
+    /* the slots of a worker that never started would never drain */
+    ok = started == run->workers;
+
+    /* Reader: fill slot seq % slot_count in order, carry the partial last line over */
+    for (uint32_t seq = 0; ok && !eof; ) {
+        StreamSlot* s = &run->slots[seq % slot_count];
+        while (RING_LOAD(&s->full)) pipe_backoff(&idle);
+        idle = 0;
+
+        uint32_t len = carry_len;
+        int reads = 0;
+        memcpy(s->buf, carry, carry_len);
+        carry_len = 0;
+        /* at least one read: the carry alone may already be over STREAM_FILL */
+        while (len < STREAM_BLOCK && (reads++ == 0 || len < STREAM_FILL || skipping)) {
+            long n = (long)stream_read(in_fd, s->buf + len, STREAM_BLOCK - len);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) {
+                eof = 1;
+                break;
+            }
+            len += (uint32_t)n;
+        }
+
+        uint32_t start = 0, end = len;
+        if (skipping) {
+            /* still inside an over-long line: drop up to its delimiter */
+            const char* q = (const char*)memchr(s->buf, run->delimiter, len);
+            if (!q) continue;
+            start = (uint32_t)(q - s->buf) + 1;
+            skipping = 0;
+        }
+        if (!eof) {
+            uint32_t last = len;
+            while (last > start && s->buf[last - 1] != run->delimiter) last--;
+            if (last == start) {
+                /* no delimiter in a whole block */
+                if (len == STREAM_BLOCK) skipping = 1;
+                else {
+                    memcpy(carry, s->buf + start, len - start);
+                    carry_len = len - start;
+                }
+                continue;
+            }
+            end = last;
+            carry_len = len - end;
+            memcpy(carry, s->buf + end, carry_len);
+        }
+        if (end <= start) continue;
+        s->start = start;
+        s->end = end;
+        RING_STORE(&s->full, 1);
+        seq++;
+    }
+    RING_STORE(&run->done, 1);
+
+    for (int t = 0; t < started; t++) fnv_thread_join(threads[t]);
+    fnv_mutex_destroy(&run->lock);
+    if (tested) *tested = run->tested;
+
+cleanup:;
+    int64_t matches = ok ? run->matches : -1;
+    for (int i = 0; run->slots && i < slot_count; i++) free(run->slots[i].buf);
+    free(run->slots);
+    free(workers);
+    free(carry);
+    free(run);
+    return matches;
+}
+
+/* ============================================================================
+ * BENCHMARK (standalone mode)
+ * ============================================================================ */
+
+#ifdef BENCHMARK
+int main() {
+    printf("FNV-1 Hash Benchmark\n");
+    printf("====================\n\n");
+    
+    const char* test_strings[] = {
+        "test", "hello_world", "play_music", "footstep_grass_run",
+        "abcdefghij", "ui_button_click", "explosion_large"
+    };
+    int num_strings = sizeof(test_strings) / sizeof(test_strings[0]);
+    
+    /* Verify hash values */
+    printf("Hash verification:\n");
+    for (int i = 0; i < num_strings; i++) {
+        printf("  %s -> 0x%08X\n", test_strings[i], wwise_hash(test_strings[i]));
+    }
+    
+    /* Benchmark */
+    printf("\nBenchmarking...\n");
+    int iterations = 10000000;
+    
+    clock_t start = clock();
+    volatile uint32_t h = 0;
+    for (int i = 0; i < iterations; i++) {
+        for (int j = 0; j < num_strings; j++) {
+            h ^= wwise_hash(test_strings[j]);
+        }
+    }
+    clock_t end = clock();
+    
+    double elapsed = (double)(end - start) / CLOCKS_PER_SEC;
+    double rate = (iterations * num_strings) / elapsed / 1e6;
+    
+    printf("  %d iterations x %d strings = %lld hashes\n", 
+           iterations, num_strings, (long long)iterations * num_strings);
+    printf("  Time: %.2f seconds\n", elapsed);
+    printf("  Rate: %.2f M hashes/sec\n", rate);
+    printf("  (dummy: 0x%08X)\n", h);
+
+    /* Kernel backends: length-6 brute force against 1500 targets */
+    printf("\nKernel backends (len 6, 1500 targets, one thread):\n");
+    printf("  scalar:    %8.1f M candidates/sec\n", kernel_benchmark(KERNEL_SCALAR, 6, 1500, 2.0, 1) / 1e6);
+    printf("  lowbits16: %8.1f M candidates/sec\n", kernel_benchmark(KERNEL_LOWBITS16, 6, 1500, 2.0, 1) / 1e6);
+    printf("  bitslice:  %8.1f M candidates/sec\n", kernel_benchmark(KERNEL_BITSLICE, 6, 1500, 2.0, 1) / 1e6);
+    
+    return 0;
+}
+
+/* ============================================================================
+ * STREAM CLI (standalone mode)
+ *   gcc -O3 -march=native -DSTREAM fnv1_hash.c -o fnv_stream -pthread -lm
+ *   generator | fnv_stream targets.txt [-0] [-j threads] [input]
+ * targets.txt: one "id [class [bank]]" per line (id decimal or 0x hex,
+ * class a name or number, '#' starts a comment).  Matches go to stdout as
+ * name, ID, class, bank; totals go to stderr.  BENCHMARK and STREAM each
+ * provide main(), so BENCHMARK wins when both are defined.
+ * ============================================================================ */
+
+#elif defined(STREAM)
+static TargetSet* stream_load_targets(const char* path, char*** bank_names, int* bank_count) {
+    FILE* in = fopen(path, "r");
+    uint32_t* ids = NULL;
+    uint8_t* classes = NULL;
+    uint16_t* banks = NULL;
+    int count = 0, max = 0;
+    char line[512];
+    TargetSet* set = NULL;
+
+    *bank_names = NULL;
+    *bank_count = 0;
+    if (!in) return NULL;
+    while (fgets(line, sizeof(line), in)) {
+        char id_text[64], cls_text[64], bank_text[256];
+        char* hash_mark = strchr(line, '#');
+        if (hash_mark) *hash_mark = '\0';
+        int fields = sscanf(line, "%63s %63s %255s", id_text, cls_text, bank_text);
+        if (fields < 1) continue;
+
+        if (count == max) {
+            max = max ? max * 2 : 4096;
+            ids = (uint32_t*)realloc(ids, sizeof(uint32_t) * max);
+            classes = (uint8_t*)realloc(classes, max);
+            banks = (uint16_t*)realloc(banks, sizeof(uint16_t) * max);
+            if (!ids || !classes || !banks) goto done;
+        }
+        ids[count] = (uint32_t)strtoul(id_text, NULL, 0);
+        classes[count] = TARGET_CLASS_EVENT;
+        banks[count] = TARGET_BANK_NONE;
+        if (fields >= 2) {
+            for (int c = 0; c < TARGET_CLASS_COUNT; c++) {
+                if (strcmp(cls_text, target_class_names[c]) == 0) classes[count] = (uint8_t)c;
+            }
+            if (isdigit((unsigned char)cls_text[0])) classes[count] = (uint8_t)atoi(cls_text);
+        }
+        if (fields >= 3) {
+            int b = 0;
+            while (b < *bank_count && strcmp((*bank_names)[b], bank_text) != 0) b++;
+            if (b == *bank_count && b < TARGET_BANK_NONE) {
+                char** grown = (char**)realloc(*bank_names, sizeof(char*) * (b + 1));
+                if (!grown) goto done;
+                *bank_names = grown;
+                grown[b] = (char*)malloc(strlen(bank_text) + 1);
+                if (!grown[b]) goto done;
+                strcpy(grown[b], bank_text);
+                (*bank_count)++;
+            }
+            if (b < *bank_count) banks[count] = (uint16_t)b;
+        }
+        count++;
+    }
+    set = target_set_create(ids, classes, banks, NULL, count);
+
+done:
+    fclose(in);
+    free(ids);
+    free(classes);
+    free(banks);
+    return set;
+}
+
+int main(int argc, char** argv) {
+    const char* targets_path = NULL;
+    const char* input_path = NULL;
+    int delimiter = '\n', threads = 0, in_fd = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-0") == 0) delimiter = '\0';
+        else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) threads = atoi(argv[++i]);
+        else if (!targets_path) targets_path = argv[i];
+        else input_path = argv[i];
+    }
+    if (!targets_path) {
+        fprintf(stderr, "usage: %s targets.txt [-0] [-j threads] [input]\n", argv[0]);
+        return 2;
+    }
+
+    char** bank_names;
+    int bank_count;
+    TargetSet* set = stream_load_targets(targets_path, &bank_names, &bank_count);
+    if (!set) {
+        fprintf(stderr, "cannot read targets from %s\n", targets_path);
+        return 1;
+    }
+#ifdef _WIN32
+    _setmode(0, _O_BINARY);
+    _setmode(1, _O_BINARY);
+    if (input_path) in_fd = _open(input_path, _O_RDONLY | _O_BINARY);
+#else
+    if (input_path) in_fd = open(input_path, O_RDONLY);
+#endif
+    if (in_fd < 0) {
+        fprintf(stderr, "cannot open %s\n", input_path);
+        return 1;
+    }
+
+    uint64_t tested = 0;
+    double start = fnv_now();
+    int64_t matches = stream_match(in_fd, 1, set, (const char**)bank_names, bank_count, delimiter,
+                                   threads, &tested);
+    double elapsed = fnv_now() - start;
+    fprintf(stderr, "%llu candidates, %lld matches against %d IDs in %.2fs (%.1f M/s)\n",
+            (unsigned long long)tested, (long long)matches, set->id_count, elapsed,
+            elapsed > 0 ? tested / elapsed / 1e6 : 0.0);
+
+    for (int b = 0; b < bank_count; b++) free(bank_names[b]);
+    free(bank_names);
+    target_set_free(set);
+    return matches < 0;
+}
 #endif
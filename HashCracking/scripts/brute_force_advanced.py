@@ -41,19 +41,27 @@ Author: LOTR Conquest RE Project
 """
 
 import os
+import re
 import sys
 import json
 import time
 import ctypes
+import socket
 import struct
+import hashlib
 import argparse
+import array
+import bisect
+import threading
+import socketserver
 import itertools
 import multiprocessing as mp
+import contextlib
 from pathlib import Path
 from datetime import datetime, timedelta
-from typing import Set, Dict, List, Tuple, Optional
+from typing import Set, Dict, List, Tuple, Optional, Iterator
 from dataclasses import dataclass
-from collections import defaultdict
+from collections import defaultdict, Counter
 
 # ============================================================================
 # MATRIX-STYLE VERBOSE LOGGING
@@ -130,6 +138,68 @@ WWISE_SUFFIXES = [
     '_light', '_heavy', '_quick', '_slow', '_chain',
 ]
 
+# Per-bank vocabulary for routed attacks (bank-name tokens are added automatically).
+# A word here is only ever tested against its own bank's targets.
+BANK_VOCABULARY = {
+    'SFXCatapult': ['catapult', 'crank', 'winch', 'boulder', 'rock', 'launch', 'release',
+                    'load', 'fire', 'impact', 'rope', 'arm', 'wood'],
+    'SFXBallista': ['ballista', 'bolt', 'crank', 'winch', 'fire', 'load', 'release', 'impact', 'wood'],
+    'SFXSiegeTower': ['siege', 'tower', 'wheel', 'creak', 'ramp', 'move', 'collapse', 'wood', 'firepot'],
+    'SFXOliphant': ['oliphant', 'oliphaunt', 'oli', 'mumak', 'stomp', 'trumpet', 'roar', 'tusk',
+                    'footstep', 'death', 'fall'],
+    'SFXBalrog': ['balrog', 'whip', 'fire', 'wing', 'wings', 'roar', 'sword', 'stomp', 'flame'],
+    'SFXFellBeast': ['fellbeast', 'fell', 'beast', 'wing', 'flap', 'screech', 'shriek', 'dive', 'grab'],
+    'SFXTroll': ['troll', 'club', 'stomp', 'roar', 'grunt', 'swing', 'hit', 'footstep'],
+    'Creatures': ['creature', 'warg', 'horse', 'eagle', 'ent', 'orc', 'uruk', 'goblin', 'spider',
+                  'growl', 'roar', 'snarl', 'howl', 'neigh', 'screech', 'vocal', 'death', 'attack'],
+    'Ambience': ['amb', 'ambience', 'wind', 'fire', 'water', 'birds', 'crowd', 'rain', 'thunder',
+                 'loop', 'battle', 'distant', 'cave', 'forest', 'river'],
+    'BaseCombat': ['sword', 'shield', 'arrow', 'bow', 'axe', 'spear', 'hit', 'block', 'swing',
+                   'impact', 'kill', 'death', 'parry', 'whoosh', 'flesh', 'metal', 'wood'],
+    'Effects': ['fx', 'explosion', 'explode', 'fire', 'magic', 'spark', 'smoke', 'impact', 'debris',
+                'flame', 'burn', 'light', 'heal', 'shield'],
+}
+
+# Target classes, in TARGET_CLASS_* order (fnv1_hash.c). Besides events, switch and
+# state groups, switches, states, RTPCs, busses and bank IDs are hashed names too.
+TARGET_CLASSES = ['event', 'switch_group', 'switch', 'state_group', 'state', 'rtpc', 'bus', 'bank']
+
+# Paired event templates (play_X/stop_X) for the native joint pair search
+PAIR_TEMPLATES = [
+    ('play_%s', 'stop_%s'), ('start_%s', 'end_%s'), ('start_%s', 'stop_%s'),
+    ('%s_start', '%s_end'), ('%s_start', '%s_stop'), ('play_%s_loop', 'stop_%s_loop'),
+    ('%s_on', '%s_off'), ('play_%s', 'end_%s'), ('pause_%s', 'resume_%s'),
+]
+
+# Subject alias table for the native template transplant engine.
+# Class -> subjects -> aliases; a cracked name's subject token is swapped for
+# every alias of the same class (legolas_sa1 -> isildur_sa1).
+TRANSPLANT_SUBJECTS = {
+    'hero': [
+        ['aragorn'], ['gandalf'], ['legolas'], ['gimli'], ['frodo'], ['sam'],
+        ['isildur'], ['elendil'], ['theoden'], ['faramir'], ['boromir'], ['eowyn'],
+        ['elrond'], ['haldir'], ['treebeard'], ['sauron'], ['saruman'], ['lurtz'],
+        ['gothmog'], ['wormtongue', 'worm'], ['witchking', 'witch_king', 'wk'],
+        ['mouth', 'mouth_of_sauron', 'mos'], ['nazgul', 'ringwraith'], ['balrog'],
+    ],
+    'creature': [
+        ['balrog'], ['troll', 'cave_troll'], ['ent'], ['warg'], ['horse'], ['eagle'],
+        ['oliphaunt', 'oliphant', 'oli', 'mumak'], ['fellbeast', 'fell_beast', 'fb'],
+        ['creature'], ['orc'], ['uruk', 'uruk_hai'], ['goblin'], ['spider', 'shelob'],
+    ],
+    'level': [
+        ['isengard', 'isen'], ['helmsdeep', 'helms_deep', 'helms', 'hd'],
+        ['pelennor', 'pf', 'pelennor_fields'], ['moria'], ['minastir', 'minas_tirith', 'mt'],
+        ['rivendell', 'riv'], ['shire'], ['weathertop', 'wt'], ['mountdoom', 'mount_doom', 'md'],
+        ['trng', 'training'], ['minasmorg', 'minas_morgul', 'mm'], ['osgiliath', 'osg'],
+        ['blackgates', 'black_gates', 'bg'],
+    ],
+    'siege': [
+        ['ballista'], ['catapult'], ['siege_tower', 'siegetower', 'tower'],
+        ['battering_ram', 'ram', 'batteringram'],
+    ],
+}
+
 # LOTR Conquest specific terms - creatures, heroes, units, locations
 LOTR_TERMS = [
     # Heroes - Good
@@ -836,12 +906,38 @@ class PatternGenerator:
                 results.append('_'.join(reversed(combo)))
         return results
 
+    def priority_words(self) -> List[str]:
+        """Shorter, more likely terms (38k -> ~2k most useful)."""
+        return sorted([w for w in self.base_words if 3 <= len(w) <= 15], key=len)[:2000]
+
+    def pipeline_runs(self) -> List[Tuple[str, List[str], List[str]]]:
+        """
+        generate_all() as native pipeline runs (kind, words, templates):
+        the same candidates, expanded by generator threads instead of Python.
+        """
+        priority_words = self.priority_words()
+        return [('templates', priority_words, self.word_templates()),
+                ('permute', sorted(self.base_words, key=len)[:200], []),
+                ('templates', priority_words[:200], self.affix_templates())]
+
+    def word_templates(self) -> List[str]:
+        """Per-word patterns ('%s' = the word): plain, prefixed, suffixed, numbered, Roman."""
+        templates = ['%s'] + [f"{p}%s" for p in self.prefixes] + [f"%s{s}" for s in self.suffixes]
+        for i in range(6):
+            templates += [f"%s_{i}", f"%s_{i:02d}", f"%s{i}"]
+        for i in range(1, 6):
+            templates += [f"%s_{to_roman(i)}", f"%s{to_roman(i)}"]
+        return templates
+
+    def affix_templates(self) -> List[str]:
+        """prefix + word + suffix patterns."""
+        return [f"{p}%s{s}" for p in self.prefixes for s in self.suffixes]
+
     def generate_all(self) -> List[str]:
         """Generate all pattern variations for all base words."""
         candidates = set()
 
-        # Limit to shorter, more likely terms (38k -> ~2k most useful)
-        priority_words = sorted([w for w in self.base_words if 3 <= len(w) <= 15], key=len)[:2000]
+        priority_words = self.priority_words()
         print(f"    Processing {len(priority_words)} priority words (of {len(self.base_words)} total)...", flush=True)
 
         for i, word in enumerate(priority_words):
@@ -1210,9 +1306,11 @@ class BidirectionalSearch:
 class DictionaryAttack:
     """Enhanced dictionary attack using patterns and word combinations."""
 
-    def __init__(self, targets: Set[int], ngram_filter: Optional[NgramFilter] = None):
+    def __init__(self, targets: Set[int], ngram_filter: Optional[NgramFilter] = None,
+                 native: Optional['NativeHasher'] = None):
         self.targets = targets
         self.ngram_filter = ngram_filter
+        self.native = native if native and native.available else None
         self.matches: List[Tuple[str, int]] = []
 
     def load_wordlist(self, path: Path) -> List[str]:
@@ -1226,8 +1324,33 @@ class DictionaryAttack:
                         words.append(word)
         return words
 
+    def native_pipeline(self, runs: List[Tuple[str, List[str], List[str]]],
+                        depth: int = 2) -> List[Tuple[str, int]]:
+        """
+        Hash (kind, words, templates) runs through the native pipeline. The
+        n-gram filter only ever rejects candidates, so applying it to the
+        hits gives the same matches as filtering before hashing.
+        """
+        matches, seen, total = [], set(), 0
+        for kind, words, templates in runs:
+            hits, tested = self.native.pipeline_search(kind, words, self.targets, templates, depth=depth)
+            total += tested
+            for candidate, h in hits:
+                if (candidate, h) in seen:
+                    continue
+                seen.add((candidate, h))
+                if self.ngram_filter and not self.ngram_filter.is_valid(candidate):
+                    continue
+                matches.append((candidate, h))
+                log_match(candidate, h)
+        log(f"  Done: tested={total:,} (native pipeline) matches={len(matches)}")
+        return matches
+
     def test_candidates(self, candidates: List[str]) -> List[Tuple[str, int]]:
         """Test list of candidate strings against targets."""
+        if self.native:
+            log(f"Testing {len(candidates):,} candidates against {len(self.targets):,} targets (native)...")
+            return self.native_pipeline([('list', candidates, [])])
         matches = []
         total = len(candidates)
         tested = 0
@@ -1255,12 +1378,19 @@ class DictionaryAttack:
         """Run pattern-based dictionary attack."""
         log(f"Starting pattern attack with {len(base_words):,} base words...")
         generator = PatternGenerator(base_words)
+        if self.native:
+            return self.native_pipeline(generator.pipeline_runs())
         candidates = generator.generate_all()
         log(f"Generated {len(candidates):,} pattern candidates")
         return self.test_candidates(candidates)
 
     def run_combination_attack(self, words: List[str], depth: int = 3) -> List[Tuple[str, int]]:
         """Test multi-word combinations."""
+        if self.native:
+            matches = []
+            for r in range(1, depth + 1):
+                matches += self.native_pipeline([('permute', words[:100], [])], depth=r)
+            return matches
         matches = []
         total = 0
 
@@ -1334,12 +1464,600 @@ class SuffixOptimizedSearch:
 # NATIVE C LIBRARY INTEGRATION
 # ============================================================================
 
+class AliasForm(ctypes.Structure):
+    """Mirror of the native AliasForm record (weighted abbreviation)."""
+    _fields_ = [('state', ctypes.c_uint32), ('offset', ctypes.c_uint32),
+                ('len', ctypes.c_uint16), ('weight', ctypes.c_uint16),
+                ('term', ctypes.c_int32)]
+
+
+class AttackPlan(ctypes.Structure):
+    """Mirror of the native AttackPlan record (planner estimates for one attack)."""
+    _fields_ = [('keyspace', ctypes.c_uint64), ('seconds', ctypes.c_double),
+                ('false_positives', ctypes.c_double), ('expected_real', ctypes.c_double),
+                ('real_per_second', ctypes.c_double), ('fraction', ctypes.c_double)]
+
+
+class LedgerPass(ctypes.Structure):
+    """Mirror of the native LedgerPass record (range still to search)."""
+    _fields_ = [('start', ctypes.c_uint64), ('end', ctypes.c_uint64), ('since', ctypes.c_uint32)]
+
+
+class NativeLedger:
+    """
+    Persistent search-space ledger (Ledger in fnv1_hash.c): completed keyspace
+    units per target-set version, so re-runs only check targets added since.
+    """
+
+    def __init__(self, lib, path: Path):
+        self.lib = lib
+        self.handle = lib.ledger_open(str(path).encode())
+
+    def register(self, targets: Set[int]) -> int:
+        """Register the current target set (targets left out are retired); returns its version."""
+        ids = sorted(targets)
+        return self.lib.ledger_register_targets(self.handle, (ctypes.c_uint32 * max(len(ids), 1))(*ids), len(ids))
+
+    def targets_since(self, since: int, targets: Set[int]) -> Set[int]:
+        """Targets a range covered at version `since` has not been checked against."""
+        ids = sorted(targets)
+        out = (ctypes.c_uint32 * max(len(ids), 1))()
+        n = self.lib.ledger_targets_since(self.handle, since, (ctypes.c_uint32 * max(len(ids), 1))(*ids),
+                                          len(ids), out)
+        return set(out[:n])
+
+    def plan(self, descriptor: str, start: int, end: int) -> List[Tuple[int, int, int]]:
+        """(start, end, since) passes still needed for [start, end)."""
+        passes = (LedgerPass * 256)()
+        n = self.lib.ledger_plan(self.handle, descriptor.encode(), start, end, passes, 256)
+        if n > 256:
+            passes = (LedgerPass * n)()
+            n = self.lib.ledger_plan(self.handle, descriptor.encode(), start, end, passes, n)
+        return [(p.start, p.end, p.since) for p in passes[:n]]
+
+    def record(self, descriptor: str, start: int, end: int, since: int, searched: Set[int]) -> int:
+        """
+        Record that [start, end), covered at version `since`, has now been
+        checked against `searched`; returns the version it is covered at.
+        """
+        ids = sorted(searched)
+        return self.lib.ledger_record(self.handle, descriptor.encode(), start, end, since,
+                                      (ctypes.c_uint32 * max(len(ids), 1))(*ids), len(ids))
+
+    def stats(self) -> Tuple[int, int, int]:
+        """(version, live registered targets, stored units)."""
+        version, targets, units = ctypes.c_uint32(), ctypes.c_int(), ctypes.c_int()
+        self.lib.ledger_stats(self.handle, ctypes.byref(version), ctypes.byref(targets), ctypes.byref(units))
+        return version.value, targets.value, units.value
+
+    def close(self):
+        if self.handle:
+            self.lib.ledger_close(self.handle)
+            self.handle = None
+
+
+class JobConfig(ctypes.Structure):
+    """Mirror of the native JobConfig (job_start input)."""
+    _fields_ = [('kind', ctypes.c_int), ('mask', ctypes.c_char_p),
+                ('words', ctypes.POINTER(ctypes.c_char_p)), ('word_count', ctypes.c_int),
+                ('min_len', ctypes.c_int), ('max_len', ctypes.c_int),
+                ('start', ctypes.c_uint64), ('end', ctypes.c_uint64),
+                ('backend', ctypes.c_int), ('num_threads', ctypes.c_int), ('chunk', ctypes.c_uint64),
+                ('targets', ctypes.POINTER(ctypes.c_uint32)), ('target_count', ctypes.c_int)]
+
+
+class JobStatus(ctypes.Structure):
+    """Mirror of the native JobStatus (job_poll snapshot)."""
+    _fields_ = [('state', ctypes.c_int), ('threads', ctypes.c_int), ('tested', ctypes.c_uint64),
+                ('total', ctypes.c_uint64), ('elapsed', ctypes.c_double), ('rate', ctypes.c_double),
+                ('found', ctypes.c_int), ('targets', ctypes.c_int), ('target_version', ctypes.c_uint32),
+                ('overflow', ctypes.c_int)]
+
+
+class PipeConfig(ctypes.Structure):
+    """Mirror of the native PipeConfig (pipeline_search input)."""
+    _fields_ = [('words', ctypes.POINTER(ctypes.c_char_p)), ('word_count', ctypes.c_int),
+                ('templates', ctypes.POINTER(ctypes.c_char_p)), ('template_count', ctypes.c_int),
+                ('separator', ctypes.c_char_p), ('depth', ctypes.c_int), ('kind', ctypes.c_int),
+                ('generators', ctypes.c_int), ('hashers', ctypes.c_int),
+                ('targets', ctypes.POINTER(ctypes.c_uint32)), ('target_count', ctypes.c_int)]
+
+
+class NativeJob:
+    """
+    Handle of an asynchronous native job (job_start in fnv1_hash.c): native
+    threads sweep the keyspace while Python polls, cancels or waits.
+    """
+
+    STATES = ('running', 'done', 'cancelled', 'failed')
+
+    def __init__(self, lib, handle):
+        self.lib = lib
+        self.handle = handle
+
+    def poll(self, max_new: int = 4096) -> Tuple[Dict, List[Tuple[str, int]]]:
+        """(status, matches found since the previous poll)."""
+        status = JobStatus()
+        hashes = (ctypes.c_uint32 * max_new)()
+        names = ((ctypes.c_char * 32) * max_new)()
+        n = self.lib.job_poll(self.handle, ctypes.byref(status), hashes, names, max_new)
+        info = {'state': self.STATES[status.state], 'threads': status.threads, 'tested': status.tested,
+                'total': status.total, 'elapsed': status.elapsed, 'rate': status.rate, 'found': status.found,
+                'targets': status.targets, 'target_version': status.target_version, 'overflow': status.overflow}
+        return info, [(names[i].value.decode('ascii'), hashes[i]) for i in range(n)]
+
+    def update_targets(self, add: Set[int] = (), remove: Set[int] = ()) -> int:
+        """Swap in live targets + add - remove without stopping; returns the new version (0 = failed)."""
+        add, remove = sorted(add), sorted(remove)
+        return self.lib.job_update_targets(self.handle, (ctypes.c_uint32 * max(len(add), 1))(*add), len(add),
+                                           (ctypes.c_uint32 * max(len(remove), 1))(*remove), len(remove))
+
+    def cancel(self):
+        self.lib.job_cancel(self.handle)
+
+    def wait(self) -> str:
+        """Block until the job's threads exit (safe from several threads at once)."""
+        return self.STATES[self.lib.job_wait(self.handle)]
+
+    def close(self):
+        if self.handle:
+            self.lib.job_free(self.handle)
+            self.handle = None
+
+
+def native_bytes(s: str) -> Optional[bytes]:
+    """
+    s as the native hashers read it: latin-1 bytes, lowercased ASCII-only.
+    None when that would hash differently from fnv1_hash(s) (characters
+    past U+00FF, or non-ASCII capitals Python lowercases).
+    """
+    try:
+        encoded = s.encode('latin-1')
+        return encoded if encoded.lower() == s.lower().encode('latin-1') else None
+    except UnicodeEncodeError:
+        return None
+
+
+def pipeline_overflow(kind: str, words: List[str], templates: List[str] = (),
+                      separator: str = '_', depth: int = 2, limit: int = 31) -> Iterator[str]:
+    """
+    The candidates of a pipeline_search() run the native stages skip: longer
+    than limit bytes, or built from a word or template native_bytes() rejects.
+    Short native-only branches are pruned, so the cost follows the number of
+    candidates yielded rather than the whole space.
+    """
+    native = [native_bytes(w) is not None for w in words]
+    if kind == 'list':
+        yield from (w for w, ok in zip(words, native) if not ok or len(w) > limit)
+        return
+    if kind == 'templates':
+        order = sorted(range(len(words)), key=lambda i: len(words[i]))
+        lengths = [len(words[i]) for i in order]
+        foreign = [w for w, ok in zip(words, native) if not ok]
+        for t in templates:
+            k = t.count('%s')
+            fixed = len(t) - 2 * k
+            if native_bytes(t) is None or fixed > limit:
+                fits = -1
+            else:
+                fits = (limit - fixed) // k if k else limit   # longest word the native stage expands
+            skipped = [words[i] for i in order[bisect.bisect_right(lengths, fits):]]
+            skipped += [w for w in foreign if len(w) <= fits]
+            yield from (t.replace('%s', w) for w in skipped)
+        return
+    longest = max(map(len, words), default=0)
+    used = [False] * len(words)
+    parts: List[str] = []
+    foreign_free = [native.count(False)]
+
+    def walk(length: int, foreign: bool) -> Iterator[str]:
+        level = len(parts)
+        if level == depth:
+            if foreign or length > limit:
+                yield separator.join(parts)
+            return
+        reach = length + (depth - level) * (len(separator) + longest) - (0 if level else len(separator))
+        if not foreign and not foreign_free[0] and reach <= limit:
+            return
+        for i, w in enumerate(words):
+            if used[i]:
+                continue
+            used[i] = True
+            foreign_free[0] -= not native[i]
+            parts.append(w)
+            yield from walk(length + (len(separator) if level else 0) + len(w), foreign or not native[i])
+            parts.pop()
+            foreign_free[0] += not native[i]
+            used[i] = False
+
+    yield from walk(0, False)
+
+
+def pack_strings(strings: List[str]) -> Tuple[bytes, ctypes.Array, ctypes.Array, List[int]]:
+    """
+    One buffer plus offset/length arrays (wwise_hash_packed input), and the
+    indices of the strings it cannot carry. Strings are packed lowercased as
+    latin-1 bytes, which hash like fnv1_hash(); ones with characters past
+    U+00FF are packed empty and left to fnv1_hash().
+    """
+    encoded, foreign = [], []
+    for i, x in enumerate(strings):
+        try:
+            encoded.append(x.lower().encode('latin-1'))
+        except UnicodeEncodeError:
+            encoded.append(b'')
+            foreign.append(i)
+    encoded = encoded or [b'']
+    lengths = array.array('I', map(len, encoded))
+    offsets = array.array('I', itertools.accumulate(lengths, initial=0))
+    return (b''.join(encoded), (ctypes.c_uint32 * len(encoded)).from_buffer(offsets),
+            (ctypes.c_uint32 * len(encoded)).from_buffer(lengths), foreign)
+
+
+class NativeTargetSet:
+    """
+    Native tagged target set (TargetSet in fnv1_hash.c): mixed-class IDs with
+    class and bank tags. Engines take .ids; hits are classified afterwards.
+    """
+
+    def __init__(self, lib, tagged: Dict[int, List[Tuple[str, str]]]):
+        self.lib = lib
+        self.banks = sorted({bank for tags in tagged.values() for _, bank in tags if bank})
+        bank_index = {b: i for i, b in enumerate(self.banks)}
+        rows = [(h, TARGET_CLASSES.index(cls), bank_index.get(bank, 0xFFFF))
+                for h, tags in tagged.items() for cls, bank in tags]
+
+        self.handle = lib.target_set_create(
+            (ctypes.c_uint32 * len(rows))(*[r[0] for r in rows]),
+            (ctypes.c_uint8 * len(rows))(*[r[1] for r in rows]),
+            (ctypes.c_uint16 * len(rows))(*[r[2] for r in rows]),
+            None, len(rows))
+
+        n = lib.target_set_ids(self.handle, None, 0)
+        ids = (ctypes.c_uint32 * max(n, 1))()
+        lib.target_set_ids(self.handle, ids, n)
+        self.ids = set(ids[:n])
+
+    def entry(self, index: int) -> Tuple[str, str]:
+        """(class, bank) of one set entry."""
+        id_, cls, bank, form = ctypes.c_uint32(), ctypes.c_int(), ctypes.c_int(), ctypes.c_int()
+        self.lib.target_set_entry(self.handle, index, ctypes.byref(id_), ctypes.byref(cls),
+                                  ctypes.byref(bank), ctypes.byref(form))
+        return TARGET_CLASSES[cls.value], self.banks[bank.value] if bank.value >= 0 else 'unknown'
+
+    def classify(self, h: int) -> List[Tuple[str, str]]:
+        """Every (class, bank) an FNV-1/32 hash hits."""
+        entries = (ctypes.c_int * 64)()
+        n = self.lib.target_set_classify(self.handle, h, entries, 64)
+        return [self.entry(entries[i]) for i in range(min(n, 64))]
+
+    def mask_search(self, mask: str, backend: str = 'lowbits16', start: int = 0, end: int = 0,
+                    max_found: int = 10000) -> Tuple[List[Tuple[str, int, str, str]], int]:
+        """One mask pass over every class: ((name, hash, class, bank) hits, candidates)."""
+        fn = self.lib.mask_search_set
+        found_hashes = (ctypes.c_uint32 * max_found)()
+        found_names = ((ctypes.c_char * 32) * max_found)()
+        found_entries = (ctypes.c_int * max_found)()
+        tested = ctypes.c_uint64(0)
+
+        count = fn(mask.encode('ascii'), start, end, NativeHasher.KERNEL_BACKENDS[backend], self.handle,
+                   found_hashes, found_names, found_entries, max_found, ctypes.byref(tested))
+
+        return [(found_names[i].value.decode('ascii'), found_hashes[i]) + self.entry(found_entries[i])
+                for i in range(count)], tested.value
+
+    def stream(self, in_fd: int, out_fd: int, nul: bool = False, threads: int = 0) -> Tuple[int, int]:
+        """
+        Match every newline- (or NUL-) delimited candidate read from in_fd until
+        EOF, writing 'name<TAB>0xID<TAB>class<TAB>bank' lines to out_fd.
+        Returns (lines written, candidates); lines written is -1 on setup failure.
+        """
+        fn = self.lib.stream_match
+        banks = [b.encode('ascii', 'replace') for b in self.banks]
+        tested = ctypes.c_uint64(0)
+        count = fn(in_fd, out_fd, self.handle, (ctypes.c_char_p * max(len(banks), 1))(*banks), len(banks),
+                   0 if nul else ord('\n'), threads, ctypes.byref(tested))
+        return count, tested.value
+
+    def match(self, strings: List[str]) -> List[Tuple[str, int]]:
+        """(string, hash) of every string whose hash is in the set, via packed SIMD hashing."""
+        if not strings:
+            return []
+        fn = self.lib.wwise_hash_packed_match
+        buf, offsets, lengths, foreign = pack_strings(strings)
+        max_hits = 4096
+        while True:
+            hits = (ctypes.c_int * max_hits)()
+            n = fn(buf, offsets, lengths, len(strings), self.handle, hits, max_hits)
+            if n <= max_hits:
+                break
+            max_hits = n
+        skip = set(foreign)
+        matched = [(strings[hits[i]], fnv1_hash(strings[hits[i]])) for i in range(n) if hits[i] not in skip]
+        return matched + [(strings[i], fnv1_hash(strings[i])) for i in foreign
+                          if self.classify(fnv1_hash(strings[i]))]
+
+    def close(self):
+        if self.handle:
+            self.lib.target_set_free(self.handle)
+            self.handle = None
+
+
+class NativeDictionary:
+    """
+    Compiled, memory-mapped word list (Dictionary in fnv1_hash.c): sorted,
+    deduplicated and lowercased, with every word's FNV states stored so
+    sweeps only hash the characters a word does not share with the previous one.
+    """
+
+    def __init__(self, lib, handle):
+        self.lib = lib
+        self.handle = handle
+        size = ctypes.c_uint32(0)
+        text = lib.dict_text(handle, ctypes.byref(size))
+        self.words = ctypes.string_at(text, size.value).decode('ascii', 'ignore').split('\0')[:-1]
+
+    def hash(self, index: int) -> int:
+        """Stored FNV hash of words[index]."""
+        return self.lib.dict_hash(self.handle, index)
+
+    def prefix_state(self, index: int, k: int) -> int:
+        """FNV state after the first k characters of words[index]."""
+        return self.lib.dict_prefix_state(self.handle, index, k)
+
+    def _search(self, fn, args: list, max_found: int) -> Tuple[List[Tuple[str, int]], int]:
+        found_hashes = (ctypes.c_uint32 * max_found)()
+        found_names = ((ctypes.c_char * 32) * max_found)()
+        tested = ctypes.c_uint64(0)
+        count = fn(self.handle, *args, found_hashes, found_names, max_found, ctypes.byref(tested))
+        return [(found_names[i].value.decode('ascii'), found_hashes[i]) for i in range(count)], tested.value
+
+    def templates(self, templates: List[str], targets: Set[int], threads: int = 0,
+                  max_found: int = 100000) -> Tuple[List[Tuple[str, int]], int]:
+        """Every word through every template ('%s' = the word). Returns (hits, candidates)."""
+        if not templates or not targets:
+            return [], 0
+        fn = self.lib.dict_template_search
+        encoded = [t.encode('ascii', 'ignore') for t in templates]
+        target_list = sorted(targets)
+        return self._search(fn, [(ctypes.c_char_p * len(encoded))(*encoded), len(encoded),
+                                 (ctypes.c_uint32 * len(target_list))(*target_list), len(target_list),
+                                 threads], max_found)
+
+    def combine(self, targets: Set[int], first: List[str] = None, separator: str = '_', threads: int = 0,
+                max_found: int = 100000) -> Tuple[List[Tuple[str, int]], int]:
+        """first word + separator + every word (first: None = every word). Returns (hits, candidates)."""
+        if not targets:
+            return [], 0
+        fn = self.lib.dict_combine_search
+        index = None
+        if first is not None:
+            positions = [bisect.bisect_left(self.words, w.lower()) for w in first]
+            index = [i for i, w in zip(positions, first) if i < len(self.words) and self.words[i] == w.lower()]
+            if not index:
+                return [], 0
+        target_list = sorted(targets)
+        return self._search(fn, [separator.encode('ascii'),
+                                 (ctypes.c_int * len(index))(*index) if index else None,
+                                 len(index) if index else 0,
+                                 (ctypes.c_uint32 * len(target_list))(*target_list), len(target_list),
+                                 threads], max_found)
+
+    def hybrid(self, mask: str, targets: Set[int], backend: str = 'lowbits16', start: int = 0, end: int = 0,
+               max_found: int = 10000) -> Tuple[List[Tuple[str, int]], int]:
+        """Every word followed by a mask, seeded with the stored word states. Returns (hits, candidates)."""
+        if not targets:
+            return [], 0
+        fn = self.lib.dict_hybrid_search
+        target_list = sorted(targets)
+        return self._search(fn, [mask.encode('ascii'), start, end, NativeHasher.KERNEL_BACKENDS[backend],
+                                 (ctypes.c_uint32 * len(target_list))(*target_list), len(target_list)],
+                            max_found)
+
+    def close(self):
+        if self.handle:
+            self.lib.dict_close(self.handle)
+            self.handle = None
+
+
+class NativeDawg:
+    """
+    Compiled, memory-mapped word graph (Dawg in fnv1_hash.c) for vocabularies
+    too large for a flat list: shared prefixes and suffixes are stored once
+    and sweeps hash each graph edge once per visit.
+    """
+
+    def __init__(self, lib, handle):
+        self.lib = lib
+        self.handle = handle
+        self.word_count = lib.dawg_word_count(handle)
+        self.node_count = lib.dawg_node_count(handle)
+
+    def search(self, targets: Set[int], prefix: str = '', separator: str = '_', suffix: str = '',
+               words: int = 1, max_len: int = 31, threads: int = 0,
+               max_found: int = 100000) -> Tuple[List[Tuple[str, int]], int]:
+        """
+        prefix + 1..words vocabulary words joined by separator + suffix, names
+        at most max_len characters. Returns (hits, candidates).
+        """
+        if not targets:
+            return [], 0
+        fn = self.lib.dawg_search
+        target_list = sorted(targets)
+        found_hashes = (ctypes.c_uint32 * max_found)()
+        found_names = ((ctypes.c_char * 32) * max_found)()
+        tested = ctypes.c_uint64(0)
+        count = fn(self.handle, prefix.encode('ascii'), separator.encode('ascii'), suffix.encode('ascii'),
+                   words, max_len, (ctypes.c_uint32 * len(target_list))(*target_list), len(target_list),
+                   threads, found_hashes, found_names, max_found, ctypes.byref(tested))
+        return [(found_names[i].value.decode('ascii'), found_hashes[i]) for i in range(count)], tested.value
+
+    def close(self):
+        if self.handle:
+            self.lib.dawg_close(self.handle)
+            self.handle = None
+
+
+class NativeScorer:
+    """
+    Native collision plausibility scorer (ScoreModel in fnv1_hash.c): trigram
+    model, vocabulary coverage, bank consistency and structural rules.
+    """
+
+    COMPONENTS = ['ngram', 'coverage', 'bank', 'structure']
+
+    def __init__(self, lib, corpus: List[str], vocab: Dict[Optional[str], List[str]]):
+        self.lib = lib
+        self.banks = sorted(b for b in vocab if b)
+        bank_index = {b: i for i, b in enumerate(self.banks)}
+        words = [(w.lower().encode('ascii', 'ignore'), bank_index.get(b, -1))
+                 for b, ws in vocab.items() for w in ws]
+        encoded = [c.lower().encode('ascii', 'ignore') for c in corpus]
+
+        self.handle = lib.score_model_create(
+            (ctypes.c_char_p * max(len(encoded), 1))(*encoded), len(encoded),
+            (ctypes.c_char_p * max(len(words), 1))(*[w for w, _ in words]),
+            (ctypes.c_int * max(len(words), 1))(*[b for _, b in words]), len(words))
+        self.bank_index = bank_index
+
+    def score(self, name: str, bank: str = None) -> Tuple[int, Dict[str, int]]:
+        """(total, components) for one name."""
+        comp = (ctypes.c_int * len(self.COMPONENTS))()
+        total = self.lib.score_name(self.handle, name.lower().encode('ascii', 'ignore'),
+                                    self.bank_index.get(bank, -1), comp)
+        return total, dict(zip(self.COMPONENTS, comp))
+
+    def triage(self, hits: List[Tuple[str, int, str]], min_score: int = 600,
+               margin: int = 150) -> Tuple[List[Tuple[str, int, str, int]], List[Tuple[str, int, str, int]]]:
+        """
+        Rank (name, hash, bank) hits. Returns (shortlist, suppressed), both as
+        (name, hash, bank, score) best first; repeated names are dropped.
+        """
+        if not hits:
+            return [], []
+        n = len(hits)
+        names = ((ctypes.c_char * 32) * n)()
+        for i, (name, _, _) in enumerate(hits):
+            names[i].value = name.lower().encode('ascii', 'ignore')[:31]
+        hashes = (ctypes.c_uint32 * n)(*[h for _, h, _ in hits])
+        banks = (ctypes.c_int * n)(*[self.bank_index.get(b, -1) for _, _, b in hits])
+        scores = (ctypes.c_int * n)()
+        order = (ctypes.c_int * n)()
+        suppressed = ctypes.c_int(0)
+
+        kept = self.lib.score_triage(self.handle, hashes, names, banks, n, min_score, margin,
+                                     scores, order, ctypes.byref(suppressed))
+
+        ranked = [hits[order[k]] + (scores[order[k]],) for k in range(kept + suppressed.value)]
+        return ranked[:kept], ranked[kept:]
+
+    def close(self):
+        if self.handle:
+            self.lib.score_model_free(self.handle)
+            self.handle = None
+
+
+def _native_signatures() -> Dict[str, Tuple[object, list]]:
+    """restype and argtypes of every fnv1_hash export the wrappers call."""
+    c = ctypes
+    i32, u32, u64, f64, vp, sp = c.c_int, c.c_uint32, c.c_uint64, c.c_double, c.c_void_p, c.c_char_p
+    u32p, i32p, u64p, spp = c.POINTER(u32), c.POINTER(i32), c.POINTER(u64), c.POINTER(sp)
+    # Every search writes found hashes, char[32] names, (tags,) max_found and a tested counter
+    found = [u32p, vp, i32]
+    found_tagged = [u32p, vp, i32p, i32]
+    return {
+        'wwise_hash': (u32, [sp]),
+        'wwise_hash_continue': (u32, [u32, sp]),
+        'wwise_hash_inverse': (u32, [u32, sp, i32]),
+        'wwise_hash_packed': (None, [sp, u32p, u32p, i32, u32p]),
+        'wwise_hash_packed_match': (i32, [sp, u32p, u32p, i32, vp, i32p, i32]),
+        'sibling_cluster_targets': (i32, [u32p, i32, u32p, i32p, i32]),
+        'sibling_prefix_search': (i32, [i32, i32, u32p, i32] + found),
+        'sibling_neighborhood_search': (i32, [spp, i32, i32, u32p, i32] + found_tagged),
+        'pair_targets_by_bank': (i32, [u32p, u32p, i32, u32p, u32p, i32]),
+        'pair_search_words': (i32, [spp, spp, i32, spp, i32, u32p, u32p, i32, vp, i32p, i32p, i32]),
+        'pair_search_brute': (i32, [spp, spp, i32, i32, i32, u32p, u32p, i32, vp, i32p, i32p, i32]),
+        'mutation_search': (i32, [spp, i32, i32, spp, i32, u32p, i32, i32] + found_tagged + [u64p]),
+        'transplant_search': (i32, [spp, i32, spp, i32p, i32, u32p, i32] + found_tagged + [i32p, u64p]),
+        'alias_expand': (i32, [spp, i32, i32, sp, i32, c.POINTER(AliasForm), i32]),
+        'sandwich_mitm_batch': (i32, [spp, spp, i32p, i32, sp, i32, u32p, i32, i32] + found_tagged + [u64p]),
+        'lattice_preimage_search': (i32, [sp, u32p, i32, f64, u64] + found + [u64p]),
+        'mask_keyspace': (u64, [sp]),
+        'brute_kernel_keyspace': (u64, [i32, i32]),
+        'hybrid_keyspace': (u64, [i32, sp]),
+        'shard_range': (None, [u64, i32, i32, u64p, u64p]),
+        'mask_search': (i32, [sp, u64, u64, i32, u32p, i32] + found + [u64p]),
+        'hybrid_search_range': (i32, [spp, i32, sp, u64, u64, i32, u32p, i32] + found + [u64p]),
+        'brute_force_kernel_range': (i32, [i32, i32, u64, u64, i32, u32p, i32] + found + [u64p]),
+        'kernel_benchmark': (f64, [i32, i32, i32, f64, i32]),
+        'mask_search_tagged': (i32, [sp, u64, u64, i32, vp, vp, i32] + found_tagged + [u64p]),
+        'hybrid_search_tagged': (i32, [spp, i32, sp, i32, vp, vp, i32] + found_tagged + [u64p]),
+        'target_set_create': (vp, [u32p, c.POINTER(c.c_uint8), c.POINTER(c.c_uint16), vp, i32]),
+        'target_set_free': (None, [vp]),
+        'target_set_ids': (i32, [vp, u32p, i32]),
+        'target_set_classify': (i32, [vp, u32, i32p, i32]),
+        'target_set_entry': (i32, [vp, i32, u32p, i32p, i32p, i32p]),
+        'mask_search_set': (i32, [sp, u64, u64, i32, vp] + found_tagged + [u64p]),
+        'route_search': (i32, [spp, i32p, i32, spp, i32p, i32, u32p, i32p, i32, i32, i32]
+                         + found_tagged + [u64p]),
+        'score_model_create': (vp, [spp, i32, spp, i32p, i32]),
+        'score_model_free': (None, [vp]),
+        'score_name': (i32, [vp, sp, i32, i32p]),
+        'score_triage': (i32, [vp, u32p, vp, i32p, i32, i32, i32, i32p, i32p, i32p]),
+        'schedule_search': (i32, [spp, i32p, c.POINTER(f64), i32, spp, i32p, i32, u32p, c.POINTER(f64),
+                                  i32p, i32, i32, i32, u64, f64, vp, i32] + found_tagged
+                            + [u64p, c.POINTER(c.c_uint8), u64p, i32p]),
+        'plan_attacks': (i32, [spp, i32, spp, i32p, i32, i32p, i32, spp, i32, i32, f64, f64,
+                               c.POINTER(AttackPlan), i32p]),
+        'ledger_open': (vp, [sp]),
+        'ledger_close': (None, [vp]),
+        'ledger_register_targets': (u32, [vp, u32p, i32]),
+        'ledger_targets_since': (i32, [vp, u32, u32p, i32, u32p]),
+        'ledger_record': (u32, [vp, sp, u64, u64, u32, u32p, i32]),
+        'ledger_plan': (i32, [vp, sp, u64, u64, c.POINTER(LedgerPass), i32]),
+        'ledger_stats': (None, [vp, u32p, i32p, i32p]),
+        'job_start': (vp, [c.POINTER(JobConfig)]),
+        'job_poll': (i32, [vp, c.POINTER(JobStatus), u32p, vp, i32]),
+        'job_update_targets': (u32, [vp, u32p, i32, u32p, i32]),
+        'job_cancel': (None, [vp]),
+        'job_wait': (i32, [vp]),
+        'job_free': (None, [vp]),
+        'pipeline_search': (i32, [c.POINTER(PipeConfig)] + found + [u64p]),
+        'numa_topology': (i32, [i32p, i32]),
+        'numa_set_placement': (None, [i32]),
+        'numa_set_topology': (None, [i32p, i32]),
+        'dict_compile': (i32, [spp, i32, sp]),
+        'dict_open': (vp, [sp]),
+        'dict_close': (None, [vp]),
+        'dict_count': (i32, [vp]),
+        'dict_text': (vp, [vp, u32p]),
+        'dict_hash': (u32, [vp, i32]),
+        'dict_prefix_state': (u32, [vp, i32, i32]),
+        'dict_template_search': (i32, [vp, spp, i32, u32p, i32, i32] + found + [u64p]),
+        'dict_combine_search': (i32, [vp, sp, i32p, i32, u32p, i32, i32] + found + [u64p]),
+        'dict_hybrid_search': (i32, [vp, sp, u64, u64, i32, u32p, i32] + found + [u64p]),
+        'dawg_compile': (i32, [spp, i32, sp]),
+        'dawg_open': (vp, [sp]),
+        'dawg_close': (None, [vp]),
+        'dawg_word_count': (i32, [vp]),
+        'dawg_node_count': (i32, [vp]),
+        'dawg_search': (i32, [vp, sp, sp, sp, i32, i32, u32p, i32, i32] + found + [u64p]),
+        'stream_match': (c.c_int64, [i32, i32, vp, spp, i32, i32, i32, u64p]),
+    }
+
+
+# Exports the wrapper cannot work without; everything else is optional so an
+# older build of the library still loads and only its missing engines are off.
+NATIVE_REQUIRED = ('wwise_hash', 'wwise_hash_continue', 'wwise_hash_inverse')
+
+
 class NativeHasher:
     """Wrapper for native C hash library."""
 
     def __init__(self, dll_path: Path = None):
         self.available = False
         self.lib = None
+        self.missing = set()
 
         # Try multiple paths
         if dll_path is None:
@@ -1365,24 +2083,788 @@ class NativeHasher:
                     print(f"[-] Failed to load {path}: {e}")
 
     def _setup_functions(self):
-        """Set up C function signatures."""
-        # wwise_hash
-        self.lib.wwise_hash.argtypes = [ctypes.c_char_p]
-        self.lib.wwise_hash.restype = ctypes.c_uint32
+        """
+        Set up C function signatures from _native_signatures(). Exports this
+        build of the library lacks are recorded in self.missing instead of
+        failing the load; callers check has() before using an optional engine.
+        """
+        self.missing = set()
+        for name, (restype, argtypes) in _native_signatures().items():
+            fn = getattr(self.lib, name, None)
+            if fn is None:
+                if name in NATIVE_REQUIRED:
+                    raise AttributeError(f"function '{name}' not found")
+                self.missing.add(name)
+                continue
+            fn.restype = restype
+            fn.argtypes = argtypes
+        if self.missing:
+            print(f"[!] Native library predates {len(self.missing)} exports; "
+                  f"those engines fall back or are skipped")
+
+    def has(self, *names: str) -> bool:
+        """True when the library is loaded and exports every one of names."""
+        return self.available and not self.missing.intersection(names)
+
+    def sibling_search(self, names: List[str], targets: Set[int],
+                       max_extend: int = 3, max_found: int = 10000) -> List[Tuple[str, int, str]]:
+        """
+        Native sibling solver: every truncation of every cracked name plus
+        1..max_extend chars, last char solved via shared high-24-bit clusters.
+        Returns (name, hash, seed) triples.
+        """
+        if not self.has('sibling_neighborhood_search') or not names or not targets:
+            return []
+        encoded = [n.lower().encode('ascii', 'ignore') for n in names]
+        name_arr = (ctypes.c_char_p * len(encoded))(*encoded)
+        target_list = sorted(targets)
+        target_arr = (ctypes.c_uint32 * len(target_list))(*target_list)
+        found_hashes = (ctypes.c_uint32 * max_found)()
+        found_names = ((ctypes.c_char * 32) * max_found)()
+        found_seeds = (ctypes.c_int * max_found)()
+
+        count = self.lib.sibling_neighborhood_search(
+            name_arr, len(encoded), max_extend, target_arr, len(target_list),
+            found_hashes, found_names, found_seeds, max_found)
+
+        return [(found_names[i].value.decode('ascii'), found_hashes[i], names[found_seeds[i]])
+                for i in range(count)]
+
+    def sibling_clusters(self, targets: Set[int], max_clusters: int = 65536) -> List[Tuple[int, int]]:
+        """(hash >> 8, members) of every high-24-bit group holding 2+ targets."""
+        if not self.has('sibling_cluster_targets') or not targets:
+            return []
+        target_list = sorted(targets)
+        keys = (ctypes.c_uint32 * max_clusters)()
+        sizes = (ctypes.c_int * max_clusters)()
+        count = self.lib.sibling_cluster_targets((ctypes.c_uint32 * len(target_list))(*target_list),
+                                                 len(target_list), keys, sizes, max_clusters)
+        return [(keys[i], sizes[i]) for i in range(count)]
+
+    def sibling_prefix_search(self, min_len: int, max_len: int, targets: Set[int],
+                              max_found: int = 10000) -> List[Tuple[str, int]]:
+        """
+        Brute force every name of min_len..max_len chars with the last char
+        solved for all clustered targets at once (26*37^(len-2) probes per length).
+        """
+        if not self.has('sibling_prefix_search') or not targets:
+            return []
+        target_list = sorted(targets)
+        found_hashes = (ctypes.c_uint32 * max_found)()
+        found_names = ((ctypes.c_char * 32) * max_found)()
+        count = self.lib.sibling_prefix_search(min_len, max_len,
+                                               (ctypes.c_uint32 * len(target_list))(*target_list),
+                                               len(target_list), found_hashes, found_names, max_found)
+        return [(found_names[i].value.decode('ascii'), found_hashes[i]) for i in range(count)]
+
+    def pair_search(self, targets: Dict[int, str], stems: List[str] = None, max_stem: int = 0,
+                    extra_pairs: Set[Tuple[int, int]] = None, by_bank: bool = True,
+                    max_found: int = 10000) -> List[Tuple[str, int]]:
+        """
+        Native joint pair search over PAIR_TEMPLATES. Candidate pairs are all
+        ordered target pairs within a bank (by_bank) plus extra_pairs, e.g.
+        co-occurring events (load_cooccurrence_pairs); stems come from a word
+        list and/or brute force up to max_stem chars. Returns both names of
+        every hit with the pair target each one matched.
+        """
+        if not self.has('pair_targets_by_bank', 'pair_search_words', 'pair_search_brute') or not targets:
+            return []
+        pairs = []
+        if by_bank:
+            bank_ids = {}
+            target_list = sorted(targets)
+            banks = [bank_ids.setdefault(targets[t], len(bank_ids)) for t in target_list]
+            max_pairs = sum(n * (n - 1) for n in Counter(banks).values()) or 1
+            bank_a = (ctypes.c_uint32 * max_pairs)()
+            bank_b = (ctypes.c_uint32 * max_pairs)()
+            n = self.lib.pair_targets_by_bank((ctypes.c_uint32 * len(target_list))(*target_list),
+                                              (ctypes.c_uint32 * len(banks))(*banks), len(target_list),
+                                              bank_a, bank_b, max_pairs)
+            pairs = list(zip(bank_a[:n], bank_b[:n]))
+        if extra_pairs:
+            seen = set(pairs)
+            pairs += sorted(p for p in extra_pairs if p not in seen and p[0] in targets and p[1] in targets)
+        if not pairs:
+            return []
+        pairs_a = (ctypes.c_uint32 * len(pairs))(*[a for a, _ in pairs])
+        pairs_b = (ctypes.c_uint32 * len(pairs))(*[b for _, b in pairs])
+
+        tmpl_a = (ctypes.c_char_p * len(PAIR_TEMPLATES))(*[a.encode() for a, _ in PAIR_TEMPLATES])
+        tmpl_b = (ctypes.c_char_p * len(PAIR_TEMPLATES))(*[b.encode() for _, b in PAIR_TEMPLATES])
+        found_stems = ((ctypes.c_char * 32) * max_found)()
+        found_templates = (ctypes.c_int * max_found)()
+        found_pairs = (ctypes.c_int * max_found)()
+
+        def collect(count: int) -> List[Tuple[str, int]]:
+            hits = []
+            for i in range(count):
+                stem = found_stems[i].value.decode()
+                a, b = PAIR_TEMPLATES[found_templates[i]]
+                hits += [(a % stem, pairs[found_pairs[i]][0]), (b % stem, pairs[found_pairs[i]][1])]
+            return hits
+
+        hits = []
+        if stems:
+            encoded = [w.lower().encode('ascii', 'ignore') for w in stems]
+            stem_arr = (ctypes.c_char_p * len(encoded))(*encoded)
+            hits += collect(self.lib.pair_search_words(
+                tmpl_a, tmpl_b, len(PAIR_TEMPLATES), stem_arr, len(encoded),
+                pairs_a, pairs_b, len(pairs), found_stems, found_templates, found_pairs, max_found))
+        if max_stem > 0:
+            hits += collect(self.lib.pair_search_brute(
+                tmpl_a, tmpl_b, len(PAIR_TEMPLATES), 1, max_stem,
+                pairs_a, pairs_b, len(pairs), found_stems, found_templates, found_pairs, max_found))
+        return list(dict.fromkeys(hits))
+
+    def mutation_search(self, seeds: List[str], vocab: List[str], targets: Set[int],
+                        max_edits: int = 2, threads: int = 0,
+                        max_found: int = 10000) -> Tuple[List[Tuple[str, int, str]], int]:
+        """
+        Native edit-distance / token mutation search around every seed.
+        Returns ((name, hash, seed) hits, candidates tested).
+        """
+        if not self.has('mutation_search') or not seeds or not targets:
+            return [], 0
+        seed_enc = [n.lower().encode('ascii', 'ignore') for n in seeds]
+        vocab_enc = [v.lower().encode('ascii', 'ignore') for v in vocab]
+        seed_arr = (ctypes.c_char_p * len(seed_enc))(*seed_enc)
+        vocab_arr = (ctypes.c_char_p * max(1, len(vocab_enc)))(*vocab_enc)
+        target_list = sorted(targets)
+        target_arr = (ctypes.c_uint32 * len(target_list))(*target_list)
+        found_hashes = (ctypes.c_uint32 * max_found)()
+        found_names = ((ctypes.c_char * 32) * max_found)()
+        found_seeds = (ctypes.c_int * max_found)()
+        tested = ctypes.c_uint64(0)
+
+        count = self.lib.mutation_search(
+            seed_arr, len(seed_enc), max_edits, vocab_arr, len(vocab_enc),
+            target_arr, len(target_list), threads,
+            found_hashes, found_names, found_seeds, max_found, ctypes.byref(tested))
+
+        hits = [(found_names[i].value.decode('ascii'), found_hashes[i], seeds[found_seeds[i]])
+                for i in range(count)]
+        return hits, tested.value
+
+    def transplant_search(self, cracked: List[str], targets: Set[int],
+                          subjects: Dict[str, List[List[str]]] = None,
+                          max_found: int = 10000) -> Tuple[List[Tuple[str, int, str]], int, int]:
+        """
+        Native cross-bank template transplant. Returns
+        ((name, hash, source) hits, template count, instantiations tested).
+        """
+        if not self.has('transplant_search') or not cracked or not targets:
+            return [], 0, 0
+        subjects = subjects or TRANSPLANT_SUBJECTS
+        aliases, classes = [], []
+        for cls, (_, groups) in enumerate(sorted(subjects.items())):
+            for group in groups:
+                for alias in group:
+                    aliases.append(alias.encode('ascii'))
+                    classes.append(cls)
+        cracked_enc = [n.lower().encode('ascii', 'ignore') for n in cracked]
+        cracked_arr = (ctypes.c_char_p * len(cracked_enc))(*cracked_enc)
+        alias_arr = (ctypes.c_char_p * len(aliases))(*aliases)
+        class_arr = (ctypes.c_int * len(classes))(*classes)
+        target_list = sorted(targets)
+        target_arr = (ctypes.c_uint32 * len(target_list))(*target_list)
+        found_hashes = (ctypes.c_uint32 * max_found)()
+        found_names = ((ctypes.c_char * 32) * max_found)()
+        found_seeds = (ctypes.c_int * max_found)()
+        template_count = ctypes.c_int(0)
+        tested = ctypes.c_uint64(0)
+
+        count = self.lib.transplant_search(
+            cracked_arr, len(cracked_enc), alias_arr, class_arr, len(aliases),
+            target_arr, len(target_list), found_hashes, found_names, found_seeds,
+            max_found, ctypes.byref(template_count), ctypes.byref(tested))
+
+        hits = [(found_names[i].value.decode('ascii'), found_hashes[i], cracked[found_seeds[i]])
+                for i in range(count)]
+        return hits, template_count.value, tested.value
+
+    def expand_aliases(self, terms: List[str], min_weight: int = 0,
+                       min_len: int = 2) -> List[Tuple[str, int, str]]:
+        """
+        Native abbreviation expansion (isengard -> isen, pelennor_fields -> pf).
+        Returns (form, weight, source term), highest weight first.
+        """
+        if not self.has('alias_expand') or not terms:
+            return []
+        encoded = [t.lower().encode('ascii', 'ignore') for t in terms]
+        term_arr = (ctypes.c_char_p * len(encoded))(*encoded)
+        max_forms = len(encoded) * 40 + 16
+        pool_size = sum(len(t) for t in encoded) * 40 + 1024
+        pool = ctypes.create_string_buffer(pool_size)
+        forms = (AliasForm * max_forms)()
+
+        count = self.lib.alias_expand(term_arr, len(encoded), min_len,
+                                      pool, pool_size, forms, max_forms)
+
+        result = []
+        for i in range(count):
+            f = forms[i]
+            if f.weight < min_weight:
+                break
+            text = pool.raw[f.offset:f.offset + f.len].decode('ascii')
+            result.append((text, f.weight, terms[f.term]))
+        return result
+
+    @staticmethod
+    def parse_sandwich(pattern: str) -> Optional[Tuple[str, int, str]]:
+        """Split 'saruman_??????_01' or 'saruman_?{6}_01' into (lit1, m, lit2)."""
+        import re
+        m = re.fullmatch(r'([^?]*)\?\{(\d+)\}([^?]*)', pattern)
+        if m:
+            return m.group(1), int(m.group(2)), m.group(3)
+        m = re.fullmatch(r'([^?]*)(\?+)([^?]*)', pattern)
+        if m:
+            return m.group(1), len(m.group(2)), m.group(3)
+        return None
+
+    def sandwich_search(self, patterns: List[str], targets: Set[int], charset: str = None,
+                        threads: int = 0, max_found: int = 10000) -> Tuple[List[Tuple[str, int, str]], int]:
+        """
+        Native sandwich MITM over LIT1 ?{m} LIT2 patterns.
+        Returns ((name, hash, pattern) hits, probes).
+        """
+        if not self.has('sandwich_mitm_batch') or not targets:
+            return [], 0
+        parsed = sorted((p for p in (self.parse_sandwich(x) for x in patterns) if p),
+                        key=lambda x: (x[0], x[1]))
+        if not parsed:
+            return [], 0
+        lit1 = (ctypes.c_char_p * len(parsed))(*[a.lower().encode() for a, _, _ in parsed])
+        lit2 = (ctypes.c_char_p * len(parsed))(*[c.lower().encode() for _, _, c in parsed])
+        mids = (ctypes.c_int * len(parsed))(*[m for _, m, _ in parsed])
+        target_list = sorted(targets)
+        target_arr = (ctypes.c_uint32 * len(target_list))(*target_list)
+        found_hashes = (ctypes.c_uint32 * max_found)()
+        found_names = ((ctypes.c_char * 32) * max_found)()
+        found_templates = (ctypes.c_int * max_found)()
+        tested = ctypes.c_uint64(0)
+
+        count = self.lib.sandwich_mitm_batch(
+            lit1, lit2, mids, len(parsed), charset.encode() if charset else None, 0,
+            target_arr, len(target_list), threads,
+            found_hashes, found_names, found_templates, max_found, ctypes.byref(tested))
+
+        hits = []
+        for i in range(count):
+            a, m, c = parsed[found_templates[i]]
+            hits.append((found_names[i].value.decode('ascii'), found_hashes[i], f"{a}?{{{m}}}{c}"))
+        return hits, tested.value
+
+    def lattice_search(self, pattern: str, targets: Set[int], radius: float = 0.0,
+                       max_candidates: int = 50_000_000,
+                       max_found: int = 10000) -> Tuple[List[Tuple[str, int]], int]:
+        """
+        Native LLL preimage search for a '?' pattern ("pf_siege_tower_???????_hit").
+        Returns ((name, hash) hits, candidates tried).
+        """
+        if not self.has('lattice_preimage_search') or not targets:
+            return [], 0
+        fn = self.lib.lattice_preimage_search
+        target_list = sorted(targets)
+        target_arr = (ctypes.c_uint32 * len(target_list))(*target_list)
+        found_hashes = (ctypes.c_uint32 * max_found)()
+        found_names = ((ctypes.c_char * 32) * max_found)()
+        tested = ctypes.c_uint64(0)
+
+        count = fn(pattern.lower().encode('ascii'), target_arr, len(target_list), radius,
+                   max_candidates, found_hashes, found_names, max_found, ctypes.byref(tested))
+
+        return [(found_names[i].value.decode('ascii'), found_hashes[i]) for i in range(count)], tested.value
+
+    # Kernel backends for mask/hybrid/brute (KERNEL_* in fnv1_hash.c)
+    KERNEL_BACKENDS = {'scalar': 0, 'lowbits16': 1, 'bitslice': 2}
+
+    def _kernel_call(self, fn, leading: list, targets: Set[int],
+                     max_found: int) -> Tuple[List[Tuple[str, int]], int]:
+        target_list = sorted(targets)
+        target_arr = (ctypes.c_uint32 * len(target_list))(*target_list)
+        found_hashes = (ctypes.c_uint32 * max_found)()
+        found_names = ((ctypes.c_char * 32) * max_found)()
+        tested = ctypes.c_uint64(0)
+
+        count = fn(*leading, target_arr, len(target_list), found_hashes, found_names,
+                   max_found, ctypes.byref(tested))
+
+        return [(found_names[i].value.decode('latin-1'), found_hashes[i]) for i in range(count)], tested.value
+
+    def mask_search(self, mask: str, targets: Set[int], backend: str = 'lowbits16',
+                    start: int = 0, end: int = 0,
+                    max_found: int = 10000) -> Tuple[List[Tuple[str, int]], int]:
+        """
+        Native mask attack ("play_?l?l?l_loop", "vo_[a-f]?d?d") over keyspace
+        indices [start, end), end=0 meaning all. Returns (hits, candidates).
+        """
+        if not self.has('mask_search') or not targets:
+            return [], 0
+        return self._kernel_call(
+            self.lib.mask_search,
+            [mask.encode('latin-1'), start, end, self.KERNEL_BACKENDS[backend]],
+            targets, max_found)
+
+    def hybrid_search(self, words: List[str], mask: str, targets: Set[int],
+                      backend: str = 'lowbits16', start: int = 0, end: int = 0,
+                      max_found: int = 10000) -> Tuple[List[Tuple[str, int]], int]:
+        """
+        Native word + mask hybrid attack ("gandalf" + "_?l?d") over indices
+        [start, end) of word x mask (word most significant), end=0 meaning all.
+        """
+        if not self.has('hybrid_search_range') or not targets or not words:
+            return [], 0
+        word_arr = (ctypes.c_char_p * len(words))(*[w.encode('ascii', 'ignore') for w in words])
+        return self._kernel_call(
+            self.lib.hybrid_search_range,
+            [word_arr, len(words), mask.encode('ascii'), start, end, self.KERNEL_BACKENDS[backend]],
+            targets, max_found)
+
+    def brute_kernel(self, min_len: int, max_len: int, targets: Set[int],
+                     backend: str = 'lowbits16', start: int = 0, end: int = 0,
+                     max_found: int = 10000) -> Tuple[List[Tuple[str, int]], int]:
+        """
+        Native Wwise-charset brute force on the mask kernel engine over indices
+        [start, end) of the per-length masks laid end to end (end=0 meaning all).
+        """
+        if not self.has('brute_force_kernel_range') or not targets:
+            return [], 0
+        return self._kernel_call(
+            self.lib.brute_force_kernel_range,
+            [min_len, max_len, start, end, self.KERNEL_BACKENDS[backend]],
+            targets, max_found)
+
+    def keyspace(self, engine: Dict, words: List[str] = None) -> int:
+        """
+        Mixed-radix keyspace of a shardable engine: {'kind': 'mask', 'mask': M},
+        {'kind': 'hybrid', 'mask': M} (over `words`) or {'kind': 'brute', 'min': a, 'max': b}.
+        KEYSPACE_OVERFLOW means it does not fit 64 bits and cannot be ranged.
+        """
+        if not self.has('brute_kernel_keyspace', 'mask_keyspace', 'hybrid_keyspace'):
+            return 0
+        if engine['kind'] == 'brute':
+            return self.lib.brute_kernel_keyspace(engine['min'], engine['max'])
+        if engine['kind'] == 'hybrid':
+            return self.lib.hybrid_keyspace(len(words or []), engine['mask'].encode('ascii'))
+        return self.lib.mask_keyspace(engine['mask'].encode('ascii'))
+
+    # Saturated keyspace (keyspace_add / keyspace_mul in fnv1_hash.c)
+    KEYSPACE_OVERFLOW = 2 ** 64 - 1
+
+    # Job kinds (JOB_* in fnv1_hash.c)
+    JOB_KINDS = {'mask': 0, 'hybrid': 1, 'brute': 2, 'prefix': 3}
+
+    def job_start(self, engine: Dict, targets: Set[int], backend: str = 'lowbits16', start: int = 0,
+                  end: int = 0, words: List[str] = None, threads: int = 0) -> Optional[NativeJob]:
+        """
+        Start an asynchronous job over indices [start, end) of an engine (see
+        keyspace(); also {'kind': 'prefix', 'prefix': P, 'max': n}). Returns at once.
+        """
+        if not self.has('job_start') or not targets:
+            return None
+        fn = self.lib.job_start
+        target_list = sorted(targets)
+        word_list = [w.encode('ascii', 'ignore') for w in (words or [])]
+        mask = engine.get('mask', engine.get('prefix'))
+        config = JobConfig(self.JOB_KINDS[engine['kind']], mask.encode('ascii') if mask else None,
+                           (ctypes.c_char_p * max(len(word_list), 1))(*word_list), len(word_list),
+                           engine.get('min', 1), engine.get('max', 0), start, end,
+                           self.KERNEL_BACKENDS[backend], threads, 0,
+                           (ctypes.c_uint32 * len(target_list))(*target_list), len(target_list))
+        handle = fn(ctypes.byref(config))
+        return NativeJob(self.lib, handle) if handle else None
+
+    def run_job(self, engine: Dict, targets: Set[int], backend: str = 'lowbits16', start: int = 0,
+                end: int = 0, words: List[str] = None, label: str = '',
+                progress_every: float = 10.0) -> Tuple[List[Tuple[str, int]], int, bool]:
+        """
+        Run a job on every core with periodic progress; Ctrl+C cancels it at
+        the next chunk and keeps what was found. Returns (hits, candidates, completed).
+        """
+        results = self.run_jobs([(label, engine, start, end, words)], targets, backend,
+                                progress_every=progress_every)
+        return results[0] if results else ([], 0, False)
+
+    def run_jobs(self, runs: List[Tuple[str, Dict, int, int, Optional[List[str]]]], targets: Set[int],
+                 backend: str = 'lowbits16', scorer: Optional[NativeScorer] = None, prune_score: int = 600,
+                 watch: Optional[Tuple[Path, callable]] = None,
+                 progress_every: float = 10.0) -> List[Tuple[List[Tuple[str, int]], int, bool]]:
+        """
+        Run (label, engine, start, end, words) jobs side by side, cores split
+        between them. A hit scoring >= prune_score (every hit without a scorer
+        is only reported) removes its target from every running job. When the
+        `watch` file (path, loader -> Set[int]) changes, IDs it gained are
+        added to and IDs it lost are removed from every job without stopping
+        them. Returns [(hits, candidates, completed)].
+        """
+        threads = max(1, (os.cpu_count() or 1) // max(len(runs), 1))
+        jobs = [self.job_start(engine, targets, backend, start, end, words, threads)
+                for _, engine, start, end, words in runs]
+        hits = [[] for _ in runs]
+        live, cracked = set(targets), set()
+        watched = watch[0].stat().st_mtime if watch and watch[0].exists() else None
+        watched_ids = watch[1](watch[0]) if watched else set()
+        last = time.time()
+        try:
+            while any(j for j in jobs):
+                time.sleep(0.2)
+                removed, states = set(), []
+                for k, job in enumerate(jobs):
+                    if not job:
+                        states.append(None)
+                        continue
+                    status, new = job.poll()
+                    hits[k] += new
+                    states.append(status)
+                    if scorer:
+                        removed |= {h for name, h in new
+                                    if h in live and scorer.score(name)[0] >= prune_score}
+                added = set()
+                if watch and watch[0].exists() and watch[0].stat().st_mtime != watched:
+                    watched = watch[0].stat().st_mtime
+                    fresh = watch[1](watch[0])
+                    added = fresh - watched_ids - live - cracked
+                    removed |= (watched_ids - fresh) & live
+                    watched_ids = fresh
+                    log(f"  {watch[0].name} changed: +{len(added)} / -{len(removed)} targets")
+                if added or removed:
+                    cracked |= removed & live
+                    live = (live | added) - removed
+                    for job, status in zip(jobs, states):
+                        if job and status['state'] == 'running':
+                            job.update_targets(added, removed)
+                if all(st is None or st['state'] != 'running' for st in states):
+                    break
+                if time.time() - last >= progress_every:
+                    last = time.time()
+                    for (label, *_), st in zip(runs, states):
+                        if st and st['state'] == 'running':
+                            left = (st['total'] - st['tested']) / max(st['rate'], 1.0)
+                            log(f"  {label}: {st['tested']:,}/{st['total']:,} "
+                                f"({st['tested'] / max(st['total'], 1) * 100:.1f}%), {st['rate'] / 1e6:.1f} M/s, "
+                                f"ETA {timedelta(seconds=int(left))}, {st['targets']:,} live targets")
+        except KeyboardInterrupt:
+            print("\n  cancelling...")
+            for job in jobs:
+                if job:
+                    job.cancel()
+
+        results = []
+        for k, ((label, *_), job) in enumerate(zip(runs, jobs)):
+            if not job:
+                log(f"  {label}: job could not be started (bad engine or keyspace over 64 bits)")
+                results.append(([], 0, False))
+                continue
+            job.wait()
+            status, new = job.poll()
+            job.close()
+            if status['overflow']:
+                log(f"  {label}: the job's match buffer overflowed, some matches were dropped")
+            results.append((hits[k] + new, status['tested'], status['state'] == 'done'))
+        return results
 
-        # wwise_hash_continue
-        self.lib.wwise_hash_continue.argtypes = [ctypes.c_uint32, ctypes.c_char_p]
-        self.lib.wwise_hash_continue.restype = ctypes.c_uint32
+    PIPE_KINDS = {'list': 0, 'templates': 1, 'permute': 2}
 
-        # wwise_hash_inverse
-        self.lib.wwise_hash_inverse.argtypes = [ctypes.c_uint32, ctypes.c_char_p, ctypes.c_int]
-        self.lib.wwise_hash_inverse.restype = ctypes.c_uint32
+    def pipeline_search(self, kind: str, words: List[str], targets: Set[int],
+                        templates: List[str] = None, separator: str = '_', depth: int = 2,
+                        generators: int = 0, hashers: int = 0,
+                        max_found: int = 100000) -> Tuple[List[Tuple[str, int]], int]:
+        """
+        Hash variable-length candidates on every core through the native
+        generate -> hash -> match pipeline. kind 'list' tests the words as
+        given, 'templates' every word through every template ('%s' = the
+        word), 'permute' every ordered pick of `depth` distinct words joined
+        by separator. Candidates the native stages skip (pipeline_overflow())
+        are hashed here, so the hits match the Python generators.
+        Returns (hits, candidates tested).
+        """
+        if not self.has('pipeline_search') or not words or not targets:
+            return [], 0
+        hits, total = {}, 0
+        for candidate in pipeline_overflow(kind, words, templates or [], separator, depth):
+            total += 1
+            h = fnv1_hash(candidate)
+            if h in targets:
+                hits[candidate] = h
+        fn = self.lib.pipeline_search
+        word_list = [b for b in map(native_bytes, words) if b is not None]
+        template_list = [b for b in map(native_bytes, templates or []) if b is not None]
+        if not word_list:
+            return list(hits.items()), total
+        target_list = sorted(targets)
+        config = PipeConfig((ctypes.c_char_p * len(word_list))(*word_list), len(word_list),
+                            (ctypes.c_char_p * max(len(template_list), 1))(*template_list),
+                            len(template_list), separator.encode('ascii'), depth, self.PIPE_KINDS[kind],
+                            generators, hashers,
+                            (ctypes.c_uint32 * len(target_list))(*target_list), len(target_list))
+        found_hashes = (ctypes.c_uint32 * max_found)()
+        found_names = ((ctypes.c_char * 32) * max_found)()
+        tested = ctypes.c_uint64(0)
+        count = fn(ctypes.byref(config), found_hashes, found_names, max_found, ctypes.byref(tested))
+        native_hits = [(found_names[i].value.decode('latin-1'), found_hashes[i]) for i in range(count)]
+        return list(hits.items()) + native_hits, total + tested.value
+
+    def shard_range(self, keyspace: int, shard: Optional[Tuple[int, int]]) -> Tuple[int, int]:
+        """[start, end) of shard (i, N) over a keyspace; the whole keyspace when unsharded."""
+        if not shard:
+            return 0, keyspace
+        if not self.has('shard_range'):
+            q, r = divmod(keyspace, shard[1])  # same split as the native shard_range
+            return q * shard[0] + min(shard[0], r), q * (shard[0] + 1) + min(shard[0] + 1, r)
+        start, end = ctypes.c_uint64(), ctypes.c_uint64()
+        self.lib.shard_range(keyspace, shard[0], shard[1], ctypes.byref(start), ctypes.byref(end))
+        return start.value, end.value
+
+    # Target forms for the tagged searches (HASH_* in fnv1_hash.c)
+    HASH_POLICIES = {'fnv1': 0, 'hash30': 1, 'fnv1a': 2, 'fnv1_64': 3}
+
+    def mask_search_tagged(self, mask: str, tagged: List[Tuple[int, str]],
+                           backend: str = 'lowbits16', words: List[str] = None,
+                           start: int = 0, end: int = 0,
+                           max_found: int = 10000) -> Tuple[List[Tuple[str, int, str]], int]:
+        """
+        Native mask (or word + mask hybrid) search against (value, form) targets,
+        form in HASH_POLICIES. FNV-1/32 and Hash30 targets share a single pass.
+        [start, end) restricts a plain mask to that index range.
+        Returns ((name, value, form) hits, candidates).
+        """
+        if not self.has('mask_search_tagged', 'hybrid_search_tagged') or not tagged:
+            return [], 0
+        values = (ctypes.c_uint64 * len(tagged))(*[v for v, _ in tagged])
+        forms = (ctypes.c_int * len(tagged))(*[self.HASH_POLICIES[f] for _, f in tagged])
+        found_hashes = (ctypes.c_uint32 * max_found)()
+        found_names = ((ctypes.c_char * 32) * max_found)()
+        found_targets = (ctypes.c_int * max_found)()
+        tested = ctypes.c_uint64(0)
+
+        if words is None:
+            fn = self.lib.mask_search_tagged
+            count = fn(mask.encode('ascii'), start, end, self.KERNEL_BACKENDS[backend], values, forms,
+                       len(tagged), found_hashes, found_names, found_targets, max_found,
+                       ctypes.byref(tested))
+        else:
+            fn = self.lib.hybrid_search_tagged
+            word_arr = (ctypes.c_char_p * len(words))(*[w.encode('ascii', 'ignore') for w in words])
+            count = fn(word_arr, len(words), mask.encode('ascii'), self.KERNEL_BACKENDS[backend],
+                       values, forms, len(tagged), found_hashes, found_names, found_targets,
+                       max_found, ctypes.byref(tested))
+
+        return [(found_names[i].value.decode('ascii'), tagged[found_targets[i]][0],
+                 tagged[found_targets[i]][1]) for i in range(count)], tested.value
+
+    def route_search(self, routes: List[Tuple[str, List[str], Set[int]]], masks: List[str],
+                     backend: str = 'lowbits16',
+                     max_found: int = 10000) -> Tuple[List[Tuple[str, int, str]], int]:
+        """
+        Native bank-routed search: every route's words x masks are tested only
+        against that route's targets. Returns ((name, hash, route name) hits, candidates).
+        """
+        if not self.has('route_search') or not routes:
+            return [], 0
+        fn = self.lib.route_search
+        words = [(w.encode('ascii', 'ignore'), r) for r, (_, ws, _) in enumerate(routes) for w in ws]
+        target_rows = [(h, r) for r, (_, _, subset) in enumerate(routes) for h in subset]
+        word_arr = (ctypes.c_char_p * len(words))(*[w for w, _ in words])
+        word_routes = (ctypes.c_int * len(words))(*[r for _, r in words])
+        mask_arr = (ctypes.c_char_p * len(masks))(*[m.encode('ascii') for m in masks])
+        mask_routes = (ctypes.c_int * len(masks))(*([-1] * len(masks)))
+        target_arr = (ctypes.c_uint32 * len(target_rows))(*[h for h, _ in target_rows])
+        target_routes = (ctypes.c_int * len(target_rows))(*[r for _, r in target_rows])
+        found_hashes = (ctypes.c_uint32 * max_found)()
+        found_names = ((ctypes.c_char * 32) * max_found)()
+        found_routes = (ctypes.c_int * max_found)()
+        tested = ctypes.c_uint64(0)
+
+        count = fn(word_arr, word_routes, len(words), mask_arr, mask_routes, len(masks),
+                   target_arr, target_routes, len(target_rows), len(routes),
+                   self.KERNEL_BACKENDS[backend], found_hashes, found_names, found_routes,
+                   max_found, ctypes.byref(tested))
+
+        return [(found_names[i].value.decode('ascii'), found_hashes[i], routes[found_routes[i]][0])
+                for i in range(count)], tested.value
+
+    def target_set(self, tagged: Dict[int, List[Tuple[str, str]]]) -> Optional[NativeTargetSet]:
+        """Build a native tagged target set from {hash: [(class, bank), ...]}."""
+        if not self.has('target_set_create') or not tagged:
+            return None
+        return NativeTargetSet(self.lib, tagged)
+
+    def schedule_search(self, attacks: List[Tuple[str, Optional[List[str]], int, float]],
+                        targets: List[Tuple[int, float, int]], backend: str = 'lowbits16',
+                        max_seconds: float = 0.0, scorer: 'NativeScorer' = None, prune_score: int = 600,
+                        threads: int = 0, max_found: int = 10000) -> Tuple[List[Tuple[str, int, int]], List[int], Set[int]]:
+        """
+        Native priority-weighted scheduler. attacks are (mask, hybrid words or
+        None, route or -1, expected yield); targets are (hash, weight, route).
+        Returns ((name, hash, attack index) hits, candidates per attack, cracked hashes).
+        """
+        if not self.has('schedule_search') or not attacks or not targets:
+            return [], [0] * len(attacks), set()
+        fn = self.lib.schedule_search
+        words = [(w.encode('ascii', 'ignore'), k) for k, (_, ws, _, _) in enumerate(attacks) for w in ws or []]
+        n, m, t = len(attacks), max(len(words), 1), len(targets)
+        found_hashes = (ctypes.c_uint32 * max_found)()
+        found_names = ((ctypes.c_char * 32) * max_found)()
+        found_attacks = (ctypes.c_int * max_found)()
+        attack_tested = (ctypes.c_uint64 * n)()
+        cracked = (ctypes.c_uint8 * t)()
+        tested = ctypes.c_uint64(0)
+        overflow = ctypes.c_int(0)
+
+        count = fn((ctypes.c_char_p * n)(*[a[0].encode('ascii') for a in attacks]),
+                   (ctypes.c_int * n)(*[a[2] for a in attacks]), (ctypes.c_double * n)(*[a[3] for a in attacks]), n,
+                   (ctypes.c_char_p * m)(*[w for w, _ in words]), (ctypes.c_int * m)(*[k for _, k in words]),
+                   len(words), (ctypes.c_uint32 * t)(*[h for h, _, _ in targets]),
+                   (ctypes.c_double * t)(*[w for _, w, _ in targets]), (ctypes.c_int * t)(*[r for _, _, r in targets]),
+                   t, self.KERNEL_BACKENDS[backend], threads, 0, max_seconds,
+                   scorer.handle if scorer else None, prune_score, found_hashes, found_names,
+                   found_attacks, max_found, attack_tested, cracked, ctypes.byref(tested),
+                   ctypes.byref(overflow))
+
+        if overflow.value:
+            print(f"  [!] {overflow.value} scheduler slices overflowed their match buffer, some matches were dropped")
+        hits = [(found_names[i].value.decode('ascii'), found_hashes[i], found_attacks[i]) for i in range(count)]
+        return hits, list(attack_tested), {targets[i][0] for i in range(t) if cracked[i]}
+
+    def plan_attacks(self, attacks: List[Tuple[str, Optional[List[str]], int]], known: List[str],
+                     target_count: int, backend: str = 'lowbits16', budget_seconds: float = 0.0,
+                     throughput: float = 0.0) -> Tuple[List[AttackPlan], List[int], int]:
+        """
+        Native planner over (mask, hybrid words or None, target count) attacks.
+        Returns (plans, order best first, how many of order[] the budget reaches).
+        """
+        if not self.has('plan_attacks') or not attacks:
+            return [], [], 0
+        fn = self.lib.plan_attacks
+        words = [(w.encode('ascii', 'ignore'), k) for k, (_, ws, _) in enumerate(attacks) for w in ws or []]
+        known_enc = [n.encode('ascii', 'ignore') for n in known]
+        n, m = len(attacks), max(len(words), 1)
+        plans = (AttackPlan * n)()
+        order = (ctypes.c_int * n)()
+
+        selected = fn((ctypes.c_char_p * n)(*[a[0].encode('ascii') for a in attacks]), n,
+                      (ctypes.c_char_p * m)(*[w for w, _ in words]), (ctypes.c_int * m)(*[k for _, k in words]),
+                      len(words), (ctypes.c_int * n)(*[a[2] for a in attacks]), target_count,
+                      (ctypes.c_char_p * max(len(known_enc), 1))(*known_enc), len(known_enc),
+                      self.KERNEL_BACKENDS[backend], throughput, budget_seconds, plans, order)
+
+        return list(plans), list(order), selected
+
+    def ledger(self, path: Path) -> Optional[NativeLedger]:
+        """Open (or create) a search-space ledger file."""
+        if not self.has('ledger_open'):
+            return None
+        ledger = NativeLedger(self.lib, path)
+        return ledger if ledger.handle else None
+
+    def ledger_mask_search(self, ledger: NativeLedger, mask: str, targets: Set[int],
+                           backend: str = 'lowbits16', lo: int = 0,
+                           hi: int = None) -> Tuple[List[Tuple[str, int]], int, int, bool]:
+        """
+        Mask attack over indices [lo, hi) scoped by the ledger: only ranges /
+        targets not yet covered are searched, completed passes are recorded.
+        Returns (hits, candidates, candidates skipped as already covered, completed).
+        """
+        if hi is None:
+            hi = self.keyspace({'kind': 'mask', 'mask': mask})
+        descriptor = f"mask:fnv1:{mask}"
+        ledger.register(targets)
+        hits, tested, skipped = [], 0, hi - lo
+
+        for start, end, since in ledger.plan(descriptor, lo, hi):
+            subset = targets if since == 0 else ledger.targets_since(since, targets)
+            skipped -= end - start
+            if subset:
+                found, n, completed = self.run_job({'kind': 'mask', 'mask': mask}, subset, backend,
+                                                   start, end, label=mask)
+                hits += found
+                tested += n
+                if not completed:
+                    return hits, tested, skipped, False
+            ledger.record(descriptor, start, end, since, subset)
+        return hits, tested, skipped, True
+
+    def scorer(self, corpus: List[str], vocab: Dict[Optional[str], List[str]]) -> Optional[NativeScorer]:
+        """Build a plausibility scorer; vocab maps bank (None = every bank) to words."""
+        if not self.has('score_model_create'):
+            return None
+        return NativeScorer(self.lib, corpus, vocab)
+
+    def numa_nodes(self) -> List[int]:
+        """CPUs per NUMA node as the native pools see them (one entry off Linux)."""
+        if not self.has('numa_topology'):
+            return [os.cpu_count() or 1]
+        node_cpus = (ctypes.c_int * 16)()
+        return list(node_cpus[:self.lib.numa_topology(node_cpus, 16)])
+
+    def numa_placement(self, enabled: bool):
+        """Pin native workers per NUMA node with node-local table replicas (default on)."""
+        if self.has('numa_set_placement'):
+            self.lib.numa_set_placement(int(enabled))
+
+    def numa_layout(self, node_cpus: List[int]):
+        """Use a manual layout of node_cpus[k] CPUs per node instead of sysfs ([] probes again)."""
+        if self.has('numa_set_topology'):
+            self.lib.numa_set_topology((ctypes.c_int * max(len(node_cpus), 1))(*node_cpus), len(node_cpus))
+
+    def kernel_benchmark(self, backend: str, length: int = 6, target_count: int = 1500,
+                         seconds: float = 1.0, threads: int = 1) -> float:
+        """Kernel throughput in candidates/second of wall time (threads 0 = every core)."""
+        if not self.has('kernel_benchmark'):
+            return 0.0
+        return self.lib.kernel_benchmark(self.KERNEL_BACKENDS[backend], length, target_count, seconds, threads)
 
     def hash(self, s: str) -> int:
         if self.available:
             return self.lib.wwise_hash(s.encode('ascii'))
         return fnv1_hash(s)
 
+    # Compiled word-list forms: native prefix -> (file suffix, wrapper)
+    WORD_LIST_FORMS = {'dict': ('.fnvdict', NativeDictionary), 'dawg': ('.fnvdawg', NativeDawg)}
+
+    def word_list(self, form: str, sources: List[Path], compiled: Path = None):
+        """
+        Open the compiled form ('dict' or 'dawg') of one or more word lists,
+        compiling it first if it is missing or older than any source.
+        compiled defaults to the first source with the form's suffix.
+        """
+        suffix, wrapper = self.WORD_LIST_FORMS[form]
+        if not self.has(f'{form}_compile', f'{form}_open') or not sources:
+            return None
+        compiled = compiled or Path(sources[0]).with_suffix(suffix)
+        if not compiled.exists() or any(Path(src).stat().st_mtime > compiled.stat().st_mtime
+                                        for src in sources):
+            paths = [str(src).encode() for src in sources]
+            count = getattr(self.lib, f'{form}_compile')((ctypes.c_char_p * len(paths))(*paths), len(paths),
+                                                         str(compiled).encode())
+            if count < 0:
+                return None
+            log(f"Compiled {count:,} words into {compiled.name}")
+        handle = getattr(self.lib, f'{form}_open')(str(compiled).encode())
+        return wrapper(self.lib, handle) if handle else None
+
+    def dictionary(self, sources: List[Path], compiled: Path = None) -> Optional[NativeDictionary]:
+        """Sorted, LCP-compressed word list (.fnvdict); see word_list()."""
+        return self.word_list('dict', sources, compiled)
+
+    def dawg(self, sources: List[Path], compiled: Path = None) -> Optional[NativeDawg]:
+        """Word graph (.fnvdawg); see word_list()."""
+        return self.word_list('dawg', sources, compiled)
+
+    def hash_many(self, strings: List[str]) -> List[int]:
+        """Hash a list of strings in one packed (length-bucketed SIMD) native call."""
+        if not self.has('wwise_hash_packed'):
+            return [fnv1_hash(x) for x in strings]
+        if not strings:
+            return []
+        fn = self.lib.wwise_hash_packed
+        buf, offsets, lengths, foreign = pack_strings(strings)
+        results = (ctypes.c_uint32 * len(strings))()
+        fn(buf, offsets, lengths, len(strings), results)
+        for i in foreign:
+            results[i] = fnv1_hash(strings[i])
+        return list(results)
+
     def hash_continue(self, prev_hash: int, s: str) -> int:
         if self.available:
             return self.lib.wwise_hash_continue(prev_hash, s.encode('ascii'))
@@ -1413,6 +2895,144 @@ def load_targets(events_file: Path) -> Dict[int, str]:
 
     return targets
 
+def bank_tokens(bank: str) -> List[str]:
+    """'SFXCatapult' -> ['sfx', 'catapult'], 'Level_HelmsDeep' -> ['level', 'helms', 'deep', 'helmsdeep']."""
+    tokens = []
+    for part in bank.split('_'):
+        words = [w.lower() for w in re.findall(r'[A-Z]+(?![a-z])|[A-Z]?[a-z]+|\d+', part)]
+        tokens.extend(words)
+        if len(words) > 1:
+            tokens.append(''.join(words))
+    return list(dict.fromkeys(t for t in tokens if t))
+
+
+def build_bank_routes(targets: Dict[int, str]) -> List[Tuple[str, List[str], Set[int]]]:
+    """
+    One route per bank: (bank, vocabulary words, bank target subset).
+    Words are the bank's tokens and BANK_VOCABULARY terms, their pairwise
+    joins, and each of those behind the common Wwise prefixes.
+    """
+    by_bank = defaultdict(set)
+    for h, bank in targets.items():
+        if bank and bank != 'unknown' and not bank.startswith('val:'):
+            by_bank[bank].add(h)
+
+    routes = []
+    for bank, subset in sorted(by_bank.items()):
+        terms = list(dict.fromkeys(bank_tokens(bank) + BANK_VOCABULARY.get(bank, [])))
+        stems = terms + [f"{a}_{b}" for a in terms for b in terms if a != b]
+        words = stems + [f"{p}{stem}" for p in WWISE_PREFIXES for stem in stems]
+        routes.append((bank, words, subset))
+    return routes
+
+
+def load_tagged_targets(events_file: Path) -> Dict[int, List[Tuple[str, str]]]:
+    """
+    Load all-class targets from the 'targets' section of extracted_events.json
+    as {hash: [(class, bank), ...]}, skipping IDs whose name is already known.
+    """
+    if not events_file.exists():
+        return {}
+
+    with open(events_file, 'r') as f:
+        data = json.load(f)
+
+    tagged = {}
+    for target_id, info in data.get('targets', {}).items():
+        if info.get('name'):
+            continue
+        tags = [(cls, bank) for cls, bank in info.get('tags', []) if cls in TARGET_CLASSES]
+        if tags:
+            tagged[int(target_id)] = tags
+    for event_id, info in data.get('events', {}).items():
+        tags = tagged.setdefault(int(event_id), [])
+        tag = ('event', info.get('bank', 'unknown'))
+        if tag not in tags:
+            tags.append(tag)
+
+    return tagged
+
+def build_attack_catalog(args, lotr_dict: Set[str],
+                         targets: Dict[int, str]) -> List[Tuple[str, str, Optional[List[str]], int, Set[int]]]:
+    """
+    Planner catalog as (label, mask, hybrid words or None, route, target subset):
+    brute lengths, --mask/--hybrid masks, the suffix attack and every bank route.
+    --mitm/--bidir of length n search the same names as brute length n.
+    """
+    terms = sorted(lotr_dict)
+    prefixed = LOTR_TERMS + [f"{p}{t}" for t in LOTR_TERMS for p in WWISE_PREFIXES]
+    everything = set(targets)
+    catalog = [(f"brute len {n}", '?l' + '?w' * (n - 1), None, -1, everything)
+               for n in range(1, max(args.max_len, 8) + 1)]
+    catalog += [(f"mask {m}", m, None, -1, everything) for m in args.mask or []]
+    catalog += [(f"hybrid <word>{m}", m, terms, -1, everything) for m in args.hybrid or ['_?d?d', '_?l', '?d']]
+    catalog += [(f"suffix <prefix+term>{sfx}", sfx, prefixed, -1, everything) for sfx in WWISE_SUFFIXES]
+    for r, (bank, words, subset) in enumerate(build_bank_routes(targets)):
+        catalog += [(f"routed {bank} <word>{m}", m, words, r, subset) for m in ['', '_?d?d', '_?l']]
+    return catalog
+
+
+def load_priority_weights(script_dir: Path) -> Dict[int, float]:
+    """
+    {event ID: play count} from g_PriorityUnknownEvents (priority_unknown_events.h),
+    TXTP names ("Creatures-0442") resolved to IDs through event_mapping.json.
+    """
+    header = next((p for p in [script_dir / 'priority_unknown_events.h',
+                               script_dir.parent / 'Dll' / 'priority_unknown_events.h'] if p.exists()), None)
+    mapping = next((p for p in [script_dir / 'event_mapping.json',
+                                script_dir.parent / 'Dictionary' / 'event_mapping.json'] if p.exists()), None)
+    if not header or not mapping:
+        return {}
+
+    with open(mapping, 'r') as f:
+        by_txtp = {info.get('name'): int(event_id) for event_id, info in json.load(f).get('events', {}).items()}
+    weights = {}
+    with open(header, 'r') as f:
+        for event_id, txtp, plays in re.findall(r'\{\s*(0x[0-9A-Fa-f]+|\d+),\s*"([^"]+)",\s*(\d+)', f.read()):
+            h = int(event_id, 0) or by_txtp.get(txtp)
+            if h:
+                weights[h] = weights.get(h, 0) + int(plays)
+    return weights
+
+
+def load_cooccurrence_pairs(script_dir: Path, log_path: Path, window_ms: int = 50,
+                            min_count: int = 2) -> Set[Tuple[int, int]]:
+    """
+    Ordered (ID, ID) pairs of events that fired within window_ms of each other
+    at least min_count times in a captured_audio_names.txt log (see
+    correlation_analyzer.py), TXTP names resolved through event_mapping.json.
+    """
+    from correlation_analyzer import parse_log, find_correlations
+    mapping = next((p for p in [script_dir / 'event_mapping.json',
+                                script_dir.parent / 'Dictionary' / 'event_mapping.json'] if p.exists()), None)
+    if not mapping or not log_path.exists():
+        return set()
+    with open(mapping, 'r') as f:
+        by_txtp = {info.get('name'): int(event_id) for event_id, info in json.load(f).get('events', {}).items()}
+    pairs = set()
+    for txtp_a, related in find_correlations(parse_log(str(log_path)), window_ms).items():
+        for txtp_b, count in related.items():
+            if count >= min_count and txtp_a in by_txtp and txtp_b in by_txtp:
+                pairs.add((by_txtp[txtp_a], by_txtp[txtp_b]))
+    return pairs
+
+
+def build_score_vocabulary(lotr_dict: Set[str], known: Set[str],
+                           targets: Dict[int, str]) -> Tuple[List[str], Dict[Optional[str], List[str]]]:
+    """
+    Trigram corpus and vocabulary for the plausibility scorer: known names and
+    dictionary terms train the model, their tokens plus WWISE_PREFIXES/SUFFIXES
+    are shared words, bank tokens and BANK_VOCABULARY terms are per bank.
+    """
+    corpus = sorted(set(lotr_dict) | set(known))
+    shared = {tok for term in corpus for tok in re.split(r'[_0-9]+', term.lower()) if len(tok) > 1}
+    shared.update(a.strip('_') for a in WWISE_PREFIXES + WWISE_SUFFIXES)
+    vocab = {None: sorted(shared)}
+    for bank in {b for b in targets.values() if b and b != 'unknown' and not b.startswith('val:')}:
+        vocab[bank] = list(dict.fromkeys(bank_tokens(bank) + BANK_VOCABULARY.get(bank, [])))
+    return corpus, vocab
+
+
 def load_existing_matches(matches_file: Path) -> Set[str]:
     """Load already-found matches."""
     existing = set()
@@ -1426,6 +3046,312 @@ def load_existing_matches(matches_file: Path) -> Set[str]:
     return existing
 
 
+def sweep_sources(requested: List[str], script_dir: Path) -> List[Path]:
+    """Word lists of a --dict-sweep / --dawg-sweep flag (none given: lotr_dictionary.txt)."""
+    return [Path(src) for src in requested] or [script_dir / 'lotr_dictionary.txt']
+
+
+def open_sweep_word_list(native: 'NativeHasher', form: str, sources: List[Path], script_dir: Path,
+                         explicit: bool):
+    """
+    Compiled form ('dict' / 'dawg') of the sweep sources, or None after
+    saying why. Explicit source lists are cached next to the script under a
+    name keyed by their paths; the default list compiles beside itself.
+    """
+    if not native.available:
+        print("  [-] Native library required for compiled word-list sweeps")
+        return None
+    key = hashlib.sha1('|'.join(str(src.resolve()) for src in sources).encode()).hexdigest()[:12]
+    compiled_path = script_dir / f"{form}_{key}{NativeHasher.WORD_LIST_FORMS[form][0]}" if explicit else None
+    compiled = native.word_list(form, sources, compiled_path) if all(src.exists() for src in sources) else None
+    if not compiled:
+        print("  [-] Could not read or compile the word lists")
+    return compiled
+
+
+def parse_shard(spec: str) -> Tuple[int, int]:
+    """'i/N' -> (i, N) with 0 <= i < N."""
+    try:
+        shard, shards = (int(x) for x in spec.split('/'))
+    except ValueError:
+        raise argparse.ArgumentTypeError(f"expected i/N, got {spec!r}")
+    if shards < 1 or not 0 <= shard < shards:
+        raise argparse.ArgumentTypeError(f"shard {spec} out of range")
+    return shard, shards
+
+
+def parse_address(spec: str) -> Tuple[str, int]:
+    """'[host:]port' -> (host, port), host defaulting to localhost."""
+    host, _, port = spec.rpartition(':')
+    return host or '127.0.0.1', int(port)
+
+
+class ShardCoordinator:
+    """
+    Hands out keyspace units to shard workers over a JSON-lines TCP socket.
+
+    A unit is a contiguous index range of one engine's mixed-radix keyspace
+    (NativeHasher.keyspace). Workers lease one unit at a time and heartbeat
+    while it runs; leases not renewed within `ttl` seconds go back to the
+    queue. The job carries the tagged targets ([id, class, bank] rows), so
+    every worker matches the same FNV-1 and Hash30 set as this process.
+
+    Completed units and their hits are appended to `state_path` as JSON lines
+    (a {'job': digest} header, then {'units', 'hits', 'tested'} records), so
+    a restarted coordinator resumes where it stopped; resuming rewrites the
+    file as the header plus one merged record.
+    """
+
+    def __init__(self, job: Dict, unit_size: int, state_path: Path, ttl: float = 60.0):
+        self.job = job
+        self.ttl = ttl
+        self.state_path = state_path
+        self.units = []
+        for e, size in enumerate(job['keyspaces']):
+            for start in range(0, size, unit_size):
+                self.units.append((e, start, min(start + unit_size, size)))
+
+        digest = hashlib.sha1(json.dumps([job['engines'], job['words'], job['tagged'],
+                                          unit_size]).encode()).hexdigest()
+        self.state = {'done': [], 'hits': [], 'tested': 0}
+        try:
+            lines = state_path.read_text().splitlines() if state_path.exists() else []
+            if lines and json.loads(lines[0]).get('job') == digest:
+                for line in lines[1:]:
+                    try:
+                        record = json.loads(line)
+                    except ValueError:
+                        continue                # torn write
+                    self.state['done'] += record['units']
+                    self.state['hits'] += record['hits']
+                    self.state['tested'] += record['tested']
+        except (OSError, ValueError):
+            pass
+
+        self.done = set(self.state['done'])
+        tmp = state_path.with_suffix('.tmp')
+        with open(tmp, 'w') as f:
+            f.write(json.dumps({'job': digest}) + '\n')
+            if self.done:
+                self._write_record(f, sorted(self.done), self.state['hits'], self.state['tested'])
+        os.replace(tmp, state_path)
+        self.log = open(state_path, 'a')
+        self.pending = [u for u in range(len(self.units)) if u not in self.done]
+        self.pending.reverse()
+        self.failed = set()     # units no worker could start; retried on the next run
+        self.leases = {}        # unit -> (worker, expiry)
+        self.workers = defaultdict(int)
+        self.lock = threading.Lock()
+
+    @property
+    def finished(self) -> bool:
+        return len(self.done) + len(self.failed) == len(self.units)
+
+    @staticmethod
+    def _write_record(f, units: List[int], hits: List, tested: int):
+        f.write(json.dumps({'units': units, 'hits': hits, 'tested': tested}) + '\n')
+        f.flush()
+
+    def reap(self) -> int:
+        """Return expired leases to the queue; returns how many were re-issued."""
+        now = time.time()
+        with self.lock:
+            expired = [u for u, (_, expiry) in self.leases.items() if expiry < now]
+            for u in expired:
+                del self.leases[u]
+                self.pending.append(u)
+        return len(expired)
+
+    def handle(self, msg: Dict) -> Dict:
+        op = msg.get('op')
+        with self.lock:
+            if op == 'job':
+                return dict({k: self.job[k] for k in ('engines', 'words', 'tagged', 'backend')}, ttl=self.ttl)
+            if op == 'lease':
+                while self.pending and (self.pending[-1] in self.done or self.pending[-1] in self.failed):
+                    self.pending.pop()
+                if not self.pending:
+                    return {'unit': None, 'done': self.finished}
+                u = self.pending.pop()
+                self.leases[u] = (msg.get('worker', '?'), time.time() + self.ttl)
+                return {'unit': u, 'range': self.units[u]}
+            if op == 'heartbeat':
+                u = msg.get('unit')
+                if u in self.leases and self.leases[u][0] == msg.get('worker'):
+                    self.leases[u] = (self.leases[u][0], time.time() + self.ttl)
+                    return {'ok': True}
+                return {'ok': u not in self.done}
+            if op == 'done':
+                u = msg.get('unit')
+                self.leases.pop(u, None)
+                if u is not None and u not in self.done:
+                    self.done.add(u)
+                    self.state['hits'] += msg.get('hits', [])
+                    self.state['tested'] += msg.get('tested', 0)
+                    self.workers[msg.get('worker', '?')] += msg.get('tested', 0)
+                    self._write_record(self.log, [u], msg.get('hits', []), msg.get('tested', 0))
+                if msg.get('overflow'):
+                    print(f"  unit {u}: the job's match buffer overflowed, some matches were dropped")
+                return {'ok': True}
+            if op == 'failed':
+                u = msg.get('unit')
+                self.leases.pop(u, None)
+                if u is not None and u not in self.done:
+                    self.failed.add(u)
+                    print(f"  unit {u} failed on {msg.get('worker', '?')}: {msg.get('error', 'unknown error')}")
+                return {'ok': True}
+        return {'error': f"unknown op {op!r}"}
+
+    def serve(self, address: Tuple[str, int], progress_every: float = 10.0) -> List[Tuple[str, int]]:
+        """Serve leases until every unit is done; returns the merged hits."""
+        coordinator = self
+
+        class Handler(socketserver.StreamRequestHandler):
+            def handle(self):
+                for line in self.rfile:
+                    try:
+                        reply = coordinator.handle(json.loads(line))
+                    except ValueError:
+                        reply = {'error': 'bad request'}
+                    self.wfile.write((json.dumps(reply) + '\n').encode())
+
+        socketserver.ThreadingTCPServer.allow_reuse_address = True
+        server = socketserver.ThreadingTCPServer(address, Handler)
+        server.daemon_threads = True
+        threading.Thread(target=server.serve_forever, daemon=True).start()
+        print(f"  Serving {len(self.units):,} units on {address[0]}:{address[1]} "
+              f"({len(self.done):,} already done, lease TTL {self.ttl:.0f}s)")
+
+        start, start_tested, last = time.time(), self.state['tested'], 0.0
+        try:
+            while not self.finished:
+                time.sleep(0.5)
+                reissued = self.reap()
+                if reissued:
+                    print(f"  {reissued} expired lease(s) re-issued")
+                if time.time() - last >= progress_every:
+                    last = time.time()
+                    rate = (self.state['tested'] - start_tested) / max(last - start, 1e-9)
+                    print(f"  {len(self.done):,}/{len(self.units):,} units, {len(self.leases)} leased, "
+                          f"{len(self.workers)} workers, {rate / 1e6:.1f} M/s, {len(self.state['hits'])} hits")
+        finally:
+            server.shutdown()
+            server.server_close()
+            self.log.close()
+
+        elapsed = max(time.time() - start, 1e-9)
+        if self.failed:
+            print(f"  {len(self.failed):,} unit(s) failed and will be retried on the next run")
+        print(f"  Sweep complete: {self.state['tested']:,} candidates, "
+              f"{(self.state['tested'] - start_tested) / elapsed / 1e6:.1f} M/s aggregate this session")
+        for worker, tested in sorted(self.workers.items()):
+            print(f"    {worker}: {tested:,} candidates")
+        return [(name, h) for name, h in self.state['hits']]
+
+
+def shard_worker_loop(address: Tuple[str, int], ident: str, threads: int = 1):
+    """Lease units from a ShardCoordinator and run them until the sweep is done."""
+    native = NativeHasher()
+    if not native.available:
+        print(f"  [{ident}] native library required")
+        return
+    conn = socket.create_connection(address)
+    stream = conn.makefile('rw')
+    def call(msg: Dict) -> Dict:
+        stream.write(json.dumps(msg) + '\n')
+        stream.flush()
+        return json.loads(stream.readline())
+
+    job = call({'op': 'job'})
+    tagged = defaultdict(list)
+    for h, cls, bank in job['tagged']:
+        tagged[h].append((cls, bank))
+    target_set = native.target_set(tagged)
+    targets, words = target_set.ids if target_set else set(tagged), job['words']
+    units = 0
+    running = None
+    try:
+        while True:
+            reply = call({'op': 'lease', 'worker': ident})
+            if reply['unit'] is None:
+                if reply['done']:
+                    break
+                time.sleep(1.0)
+                continue
+
+            e, start, end = reply['range']
+            running = native.job_start(job['engines'][e], targets, job['backend'], start, end, words,
+                                       threads=threads)
+            if not running:
+                call({'op': 'failed', 'unit': reply['unit'], 'worker': ident, 'error': 'job_start failed'})
+                continue
+            hits, beat = [], time.time()
+            while True:
+                time.sleep(0.2)
+                status, new = running.poll()
+                hits += new
+                if status['state'] != 'running':
+                    break
+                if time.time() - beat >= job['ttl'] / 3:
+                    beat = time.time()
+                    if not call({'op': 'heartbeat', 'unit': reply['unit'], 'worker': ident})['ok']:
+                        running.cancel()        # unit finished elsewhere
+            running.wait()
+            status, new = running.poll()
+            running.close()
+            if status['state'] == 'done':
+                call({'op': 'done', 'unit': reply['unit'], 'worker': ident, 'hits': hits + new,
+                      'tested': status['tested'], 'overflow': status['overflow']})
+                units += 1
+    except (OSError, ValueError):
+        print(f"  [{ident}] coordinator connection lost")
+        if running and running.handle:
+            running.close()
+    finally:
+        conn.close()
+    print(f"  [{ident}] finished after {units} units")
+
+
+def run_shard_worker(args):
+    """--worker mode: one or more local worker processes against a coordinator."""
+    address = parse_address(args.worker)
+    print(f"[+] Shard worker(s) for coordinator {address[0]}:{address[1]}")
+    base = f"{socket.gethostname()}-{os.getpid()}"
+    if args.worker_procs <= 1:
+        shard_worker_loop(address, base, args.worker_threads)
+        return
+    procs = [mp.Process(target=shard_worker_loop, args=(address, f"{base}.{i}", args.worker_threads))
+             for i in range(args.worker_procs)]
+    for p in procs:
+        p.start()
+    for p in procs:
+        p.join()
+
+
+def run_stream(args):
+    """
+    --stream mode: candidates piped in on stdin (any generator), hashed natively
+    against every tagged target; only matches reach stdout, everything else stderr.
+    """
+    script_dir = Path(__file__).parent
+    with contextlib.redirect_stdout(sys.stderr):
+        native = NativeHasher()
+        target_set = native.target_set(load_tagged_targets(script_dir / 'extracted_events.json'))
+    if not target_set or not native.has('stream_match'):
+        print("[-] --stream needs the native library and targets in extracted_events.json", file=sys.stderr)
+        return
+    sys.stdout.flush()
+    start = time.time()
+    matches, tested = target_set.stream(sys.stdin.fileno(), sys.stdout.fileno(), args.stream_nul,
+                                        args.stream_threads)
+    elapsed = time.time() - start
+    if matches < 0:
+        print("[-] Could not set up the native stream matcher", file=sys.stderr)
+        return
+    print(f"[+] {tested:,} candidates, {matches:,} matches against {len(target_set.ids):,} IDs "
+          f"in {elapsed:.2f}s ({tested / max(elapsed, 1e-9) / 1e6:.1f}M/s)", file=sys.stderr)
+
+
 def run_advanced_attack(args):
     """Main attack orchestrator."""
     print("=" * 70)
@@ -1451,6 +3377,16 @@ def run_advanced_attack(args):
             targets[t] = bank
         print(f"[+] Loaded {len(legacy_targets):,} targets from extracted_events.json")
 
+    # Source 1b: switch/state/RTPC/bus/bank IDs from the same file (all classes, one sweep)
+    tagged_targets = load_tagged_targets(events_file)
+    extra = 0
+    for t, tags in tagged_targets.items():
+        if t not in targets:
+            targets[t] = tags[0][1]
+            extra += 1
+    if extra:
+        print(f"[+] Loaded {extra:,} non-event targets (switch/state/rtpc/bus/bank)")
+
     # Source 2: WWiseIDTable.audio.json
     if wwise_id_table.exists():
         wwise_hashes, hash_to_val, already_named = load_wwise_id_table(wwise_id_table)
@@ -1465,9 +3401,29 @@ def run_advanced_attack(args):
         print("[-] No targets loaded!")
         return
 
-    target_set = set(targets.keys())
+    for t, bank in targets.items():
+        if t not in tagged_targets:
+            tagged_targets[t] = [('event', bank if not bank.startswith('val:') else None)]
+    native = NativeHasher()
+    if native.available:
+        nodes = native.numa_nodes()
+        if args.no_numa:
+            native.numa_placement(False)
+        elif len(nodes) > 1:
+            print(f"[+] NUMA: {len(nodes)} nodes ({'/'.join(map(str, nodes))} CPUs), "
+                  f"native workers pinned per node with node-local tables")
+    native_set = native.target_set(tagged_targets)
+    target_set = native_set.ids if native_set else set(targets.keys())
     print(f"[+] Total unique targets: {len(targets):,}")
 
+    def describe(h: int) -> str:
+        """'Bank:class' tags of a hit (every class/bank it lands in)."""
+        if native_set:
+            tags = native_set.classify(h)
+        else:
+            tags = [(cls, bank or 'unknown') for cls, bank in tagged_targets.get(h, [])]
+        return ','.join(f"{bank}:{cls}" for cls, bank in tags) or targets.get(h, 'unknown')
+
     # Load existing matches
     existing = load_existing_matches(script_dir / 'dictionary_matches.txt')
     existing.update(already_cracked)
@@ -1498,7 +3454,7 @@ def run_advanced_attack(args):
     # 1. Pattern-based attack with LOTR terms
     if args.patterns:
         print("\n[PHASE 1] Pattern-based attack...")
-        dict_attack = DictionaryAttack(target_set, ngram_filter)
+        dict_attack = DictionaryAttack(target_set, ngram_filter, native)
         matches = dict_attack.run_pattern_attack(list(lotr_dict))
         all_matches.extend(matches)
         print(f"  Found: {len(matches)} matches")
@@ -1531,7 +3487,7 @@ def run_advanced_attack(args):
     # 4. Custom wordlist
     if args.wordlist:
         print(f"\n[PHASE 4] Custom wordlist attack: {args.wordlist}")
-        dict_attack = DictionaryAttack(target_set, ngram_filter)
+        dict_attack = DictionaryAttack(target_set, ngram_filter, native)
         words = dict_attack.load_wordlist(Path(args.wordlist))
         print(f"  Loaded {len(words):,} words")
         matches = dict_attack.run_pattern_attack(words)
@@ -1547,24 +3503,440 @@ def run_advanced_attack(args):
         print(f"  Found: {len(matches)} matches")
 
     # 6. Wwise brute force with proper charset rules (from FnvBrute)
-    if hasattr(args, 'brute') and args.brute:
+    if hasattr(args, 'brute') and args.brute and not args.coordinate:
         print(f"\n[PHASE 6] Wwise brute force (len {args.min_len}-{args.max_len})...")
         print("  Using Wwise charset rules: first char [a-z], rest [a-z0-9_]")
-        use_fuzzy = not getattr(args, 'no_fuzzy', False)
-        if use_fuzzy:
-            print("  Fuzzy hash optimization: ENABLED")
-        wwise_brute = WwiseBruteForce(target_set)
-        matches = wwise_brute.brute_force(args.min_len, args.max_len, use_fuzzy=use_fuzzy)
+        native = NativeHasher() if getattr(args, 'kernel', None) else None
+        if native and native.available:
+            print(f"  Native kernel backend: {args.kernel}")
+            start = time.time()
+            keyspace = native.keyspace({'kind': 'brute', 'min': args.min_len, 'max': args.max_len})
+            if keyspace == native.KEYSPACE_OVERFLOW:
+                print("  [-] Keyspace exceeds 64 bits: lower --max-len")
+                keyspace = 0
+            lo, hi = native.shard_range(keyspace, args.shard)
+            if args.shard:
+                print(f"  Shard {args.shard[0]}/{args.shard[1]}: indices [{lo:,}, {hi:,})")
+            ledger = None if args.no_ledger else native.ledger(script_dir / 'search_ledger.bin')
+            if ledger:
+                matches, tested, skipped, base = [], 0, 0, 0
+                for n in range(max(args.min_len, 1), args.max_len + 1):
+                    mask = '?l' + '?w' * (n - 1)
+                    size = native.keyspace({'kind': 'mask', 'mask': mask})
+                    if lo < base + size and hi > base:
+                        found, t, s, completed = native.ledger_mask_search(
+                            ledger, mask, target_set, args.kernel, max(lo - base, 0), min(hi - base, size))
+                        matches += found
+                        tested += t
+                        skipped += s
+                        if not completed:
+                            break
+                    base += size
+                print(f"  Ledger: {skipped:,} candidates already covered for every target, skipped")
+                ledger.close()
+            else:
+                matches, tested, _ = native.run_job({'kind': 'brute', 'min': args.min_len, 'max': args.max_len},
+                                                    target_set, args.kernel, lo, hi, label='brute')
+            elapsed = max(time.time() - start, 1e-9)
+            print(f"  Candidates: {tested:,} in {elapsed:.1f}s ({tested / elapsed / 1e6:.1f} M/s)")
+        else:
+            use_fuzzy = not getattr(args, 'no_fuzzy', False)
+            if use_fuzzy:
+                print("  Fuzzy hash optimization: ENABLED")
+            wwise_brute = WwiseBruteForce(target_set)
+            matches = wwise_brute.brute_force(args.min_len, args.max_len, use_fuzzy=use_fuzzy)
         all_matches.extend(matches)
         print(f"  Found: {len(matches)} matches")
 
+    # 7. Sibling solver over every cracked name (native only)
+    if hasattr(args, 'siblings') and args.siblings:
+        print(f"\n[PHASE 7] Sibling solver (extend 1-{args.sibling_extend} chars from {len(existing):,} cracked names)...")
+        native = NativeHasher()
+        if native.available:
+            clusters = native.sibling_clusters(target_set)
+            print(f"  {len(clusters):,} sibling clusters covering "
+                  f"{sum(size for _, size in clusters):,} targets")
+            seeds = sorted(existing)
+            start = time.time()
+            hits = native.sibling_search(seeds, target_set, args.sibling_extend)
+            for name, h, seed in hits:
+                log_match(name, h, f"{targets.get(h, 'unknown')} <- {seed}")
+                all_matches.append((name, h))
+            print(f"  Found: {len(hits)} matches in {time.time() - start:.2f}s")
+            if args.sibling_prefix_len >= 2:
+                # clustered targets share a prefix, so one probe per prefix covers them all
+                start = time.time()
+                keys = {k for k, _ in clusters}
+                clustered = {h for h in target_set if h >> 8 in keys}
+                prefix_hits = native.sibling_prefix_search(2, args.sibling_prefix_len, clustered)
+                for name, h in prefix_hits:
+                    log_match(name, h, targets.get(h, 'unknown'))
+                    all_matches.append((name, h))
+                print(f"  Prefix sweep 2-{args.sibling_prefix_len} chars over {len(clustered):,} "
+                      f"clustered targets: {len(prefix_hits)} matches in {time.time() - start:.2f}s")
+        else:
+            print("  [-] Native library required for sibling solver")
+
+    # 8. Paired-target joint search (native only)
+    if hasattr(args, 'pairs') and args.pairs:
+        print(f"\n[PHASE 8] Paired-target search ({len(PAIR_TEMPLATES)} templates, brute stems 1-{args.pair_stem_len})...")
+        native = NativeHasher()
+        if native.available:
+            cooccur = set()
+            if args.pair_cooccur:
+                cooccur = load_cooccurrence_pairs(script_dir, Path(args.pair_cooccur), args.pair_window)
+                print(f"  {len(cooccur):,} co-occurring event pairs from {args.pair_cooccur}")
+            hits = native.pair_search(targets, list(lotr_dict), args.pair_stem_len, cooccur,
+                                      by_bank=not args.pair_cooccur_only)
+            for name, h in hits:
+                log_match(name, h, targets.get(h, 'unknown'))
+                all_matches.append((name, h))
+            print(f"  Found: {len(hits)} matches")
+        else:
+            print("  [-] Native library required for paired search")
+
+    # 9. Edit-distance mutation search around cracked names (native only)
+    if hasattr(args, 'mutate') and args.mutate:
+        print(f"\n[PHASE 9] Mutation search (edit distance {args.mutate_edits}, {len(existing):,} seeds)...")
+        native = NativeHasher()
+        if native.available:
+            seeds = sorted(existing)
+            vocab = sorted({tok for name in seeds for tok in name.split('_') if len(tok) > 1})
+            if args.expand_aliases:
+                expanded = native.expand_aliases(vocab, args.alias_min_weight)
+                vocab = sorted(set(vocab) | {form for form, _, _ in expanded})
+                print(f"  Alias expansion: {len(expanded):,} forms (weight >= {args.alias_min_weight})")
+            start = time.time()
+            hits, tested = native.mutation_search(seeds, vocab, target_set, args.mutate_edits)
+            elapsed = time.time() - start
+            for name, h, seed in hits:
+                log_match(name, h, f"{targets.get(h, 'unknown')} <- {seed}")
+                all_matches.append((name, h))
+            print(f"  Tested {tested:,} in {elapsed:.1f}s ({tested / max(elapsed, 1e-9) / 1e6:.1f} M/s)")
+            print(f"  Found: {len(hits)} matches")
+        else:
+            print("  [-] Native library required for mutation search")
+
+    # 10. Cross-bank template transplant (native only)
+    if hasattr(args, 'transplant') and args.transplant:
+        print(f"\n[PHASE 10] Template transplant ({len(existing):,} cracked names)...")
+        native = NativeHasher()
+        if native.available:
+            subjects = TRANSPLANT_SUBJECTS
+            if args.expand_aliases:
+                subjects = {}
+                for cls, groups in TRANSPLANT_SUBJECTS.items():
+                    subjects[cls] = []
+                    for group in groups:
+                        forms = native.expand_aliases(group, args.alias_min_weight)
+                        subjects[cls].append(list(dict.fromkeys(group + [f for f, _, _ in forms])))
+            hits, n_templates, tested = native.transplant_search(sorted(existing), target_set, subjects)
+            for name, h, source in hits:
+                log_match(name, h, f"{targets.get(h, 'unknown')} <- {source}")
+                all_matches.append((name, h))
+            print(f"  Templates: {n_templates:,}, instantiations: {tested:,}")
+            print(f"  Found: {len(hits)} matches")
+        else:
+            print("  [-] Native library required for template transplant")
+
+    # 11. Templated sandwich MITM (native only)
+    if hasattr(args, 'sandwich') and args.sandwich:
+        print(f"\n[PHASE 11] Sandwich MITM ({len(args.sandwich)} templates)...")
+        native = NativeHasher()
+        if native.available:
+            start = time.time()
+            hits, probes = native.sandwich_search(args.sandwich, target_set, args.sandwich_charset)
+            for name, h, pattern in hits:
+                log_match(name, h, f"{targets.get(h, 'unknown')} <- {pattern}")
+                all_matches.append((name, h))
+            print(f"  Probes: {probes:,} in {time.time() - start:.1f}s")
+            print(f"  Found: {len(hits)} matches")
+        else:
+            print("  [-] Native library required for sandwich MITM")
+
+    # 12. Lattice (LLL) preimage search for long templated names (native only)
+    if hasattr(args, 'lattice') and args.lattice:
+        print(f"\n[PHASE 12] Lattice preimage search ({len(args.lattice)} patterns)...")
+        native = NativeHasher()
+        if native.available:
+            for pattern in args.lattice:
+                start = time.time()
+                hits, tried = native.lattice_search(pattern, target_set, args.lattice_radius)
+                for name, h in hits:
+                    log_match(name, h, f"{targets.get(h, 'unknown')} <- {pattern}")
+                    all_matches.append((name, h))
+                print(f"  {pattern}: {tried:,} lattice candidates in {time.time() - start:.1f}s, {len(hits)} matches")
+        else:
+            print("  [-] Native library required for lattice search")
+
+    # 13. Mask / hybrid attacks on the native kernel engine
+    if (getattr(args, 'mask', None) or getattr(args, 'hybrid', None)) and not args.coordinate:
+        backend = args.kernel or 'lowbits16'
+        print(f"\n[PHASE 13] Mask kernel attacks (backend {backend})...")
+        native = NativeHasher()
+        if native.available:
+            runs = [(mask, None) for mask in (args.mask or [])]
+            runs += [(mask, sorted(lotr_dict)) for mask in (args.hybrid or [])]
+            ledger = None if args.no_ledger or args.live else native.ledger(script_dir / 'search_ledger.bin')
+            if args.live and not args.hash30:
+                # every run at once: cracks prune the other runs, extracted_events.json is watched
+                scorer = native.scorer(*build_score_vocabulary(lotr_dict, existing, targets))
+                jobs = []
+                for mask, words in runs:
+                    engine = {'kind': 'mask' if words is None else 'hybrid', 'mask': mask}
+                    keyspace = native.keyspace(engine, words)
+                    if keyspace == native.KEYSPACE_OVERFLOW:
+                        print(f"  [-] {mask}: keyspace exceeds 64 bits, skipped")
+                        continue
+                    lo, hi = native.shard_range(keyspace, args.shard)
+                    jobs.append((mask if words is None else f"<word>{mask}", engine, lo, hi, words))
+                start = time.time()
+                results = native.run_jobs(jobs, target_set, backend, scorer, args.min_score,
+                                          (events_file, lambda path: set(load_targets(path))))
+                for (label, *_), (hits, tested, _) in zip(jobs, results):
+                    for name, h in hits:
+                        log_match(name, h, f"{targets.get(h, 'unknown')} <- {label}")
+                        all_matches.append((name, h))
+                    print(f"  {label}: {tested:,} candidates, {len(hits)} matches")
+                print(f"  {len(jobs)} live runs in {time.time() - start:.1f}s")
+                if scorer:
+                    scorer.close()
+                runs = []
+            for mask, words in runs:
+                start = time.time()
+                label = mask if words is None else f"<word>{mask}"
+                engine = {'kind': 'mask' if words is None else 'hybrid', 'mask': mask}
+                keyspace = native.keyspace(engine, words)
+                if keyspace == native.KEYSPACE_OVERFLOW:
+                    print(f"  [-] {label}: keyspace exceeds 64 bits, skipped")
+                    continue
+                lo, hi = native.shard_range(keyspace, args.shard)
+                if args.shard and hi <= lo:
+                    continue
+                completed = True
+                if words is None and ledger and not args.hash30:
+                    hits, tested, skipped, completed = native.ledger_mask_search(
+                        ledger, mask, target_set, backend, lo, hi)
+                    hits = [(name, h, label) for name, h in hits]
+                    if skipped:
+                        print(f"  {label}: ledger skipped {skipped:,} already-covered candidates")
+                elif args.hash30:
+                    # every target < 2^30 may also be a Hash30 ID: match both forms in one pass
+                    tagged = [(h, 'fnv1') for h in target_set]
+                    tagged += [(h, 'hash30') for h in target_set if h <= HASH30_MASK]
+                    if words is None:
+                        tagged_hits, tested = native.mask_search_tagged(mask, tagged, backend, None, lo, hi)
+                    else:
+                        # tagged hybrid shards at word granularity
+                        w_lo, w_hi = native.shard_range(len(words), args.shard)
+                        tagged_hits, tested = native.mask_search_tagged(mask, tagged, backend, words[w_lo:w_hi])
+                    hits = [(name, h, f"{label} ({form})") for name, h, form in tagged_hits]
+                elif words is None and native_set:
+                    hits, tested = native_set.mask_search(mask, backend, lo, hi)
+                    hits = [(name, h, f"{label} ({cls})") for name, h, cls, _ in hits]
+                else:
+                    hits, tested, completed = native.run_job(engine, target_set, backend, lo, hi, words, label)
+                    hits = [(name, h, label) for name, h in hits]
+                for name, h, source in hits:
+                    log_match(name, h, f"{targets.get(h, 'unknown')} <- {source}")
+                    all_matches.append((name, h))
+                print(f"  {label}: {tested:,} candidates in {time.time() - start:.1f}s, {len(hits)} matches")
+                if not completed:
+                    break
+            if ledger:
+                ledger.close()
+        else:
+            print("  [-] Native library required for mask attacks")
+
+    # 14. Bank-routed attack: each bank's vocabulary only meets that bank's targets
+    if getattr(args, 'routed', None) is not None:
+        masks = args.routed or ([''] + WWISE_SUFFIXES + ['_?d', '_?d?d', '_?l'])
+        routes = build_bank_routes(targets)
+        print(f"\n[PHASE 14] Bank-routed attack ({len(routes)} routes, {len(masks)} masks)...")
+        native = NativeHasher()
+        if native.available:
+            start = time.time()
+            hits, tested = native.route_search(routes, masks, args.kernel or 'lowbits16')
+            for name, h, bank in hits:
+                log_match(name, h, f"{bank} (routed)")
+                all_matches.append((name, h))
+            elapsed = max(time.time() - start, 1e-9)
+            print(f"  Candidates: {tested:,} in {elapsed:.1f}s, avg route size "
+                  f"{sum(len(r[2]) for r in routes) / max(len(routes), 1):.0f} targets")
+            print(f"  Found: {len(hits)} matches")
+        else:
+            print("  [-] Native library required for routed attacks")
+
+    # 15. Priority-weighted portfolio: CPU share follows play count x expected yield
+    if getattr(args, 'schedule', None) is not None:
+        masks = args.schedule or ['', '_?d?d', '_?l', '_?l?l?l']
+        weights = load_priority_weights(script_dir)
+        routes = build_bank_routes(targets)
+        bank_route = {bank: r for r, (bank, _, _) in enumerate(routes)}
+        weighted = [(h, 1.0 + weights.get(h, 0), bank_route.get(bank, -2)) for h, bank in targets.items()]
+        # bank vocabulary is a far better bet than blind masks over every target
+        attacks = [(mask, words, r, 4.0) for r, (_, words, _) in enumerate(routes) for mask in masks]
+        attacks += [(mask, None, -1, 1.0) for mask in args.schedule_brute]
+        print(f"\n[PHASE 15] Priority scheduler ({len(attacks)} attacks, {len(weights)} weighted targets, "
+              f"{args.schedule_seconds:.0f}s budget)...")
+        native = NativeHasher()
+        if native.available:
+            scorer = native.scorer(*build_score_vocabulary(lotr_dict, existing, targets))
+            start = time.time()
+            hits, per_attack, cracked = native.schedule_search(
+                attacks, weighted, args.kernel or 'lowbits16', args.schedule_seconds, scorer, args.min_score)
+            for name, h, k in hits:
+                mask, words, r, _ = attacks[k]
+                source = f"{routes[r][0] if r >= 0 else 'all'}:{'<word>' if words else ''}{mask}"
+                log_match(name, h, f"{targets.get(h, 'unknown')} <- {source} (plays {weights.get(h, 0)})")
+                all_matches.append((name, h))
+            played = sum(weights.get(h, 0) for h in cracked)
+            print(f"  Candidates: {sum(per_attack):,} in {time.time() - start:.1f}s")
+            print(f"  Cracked: {len(cracked)} targets covering {played:,} logged plays")
+            if scorer:
+                scorer.close()
+        else:
+            print("  [-] Native library required for the priority scheduler")
+
+    # 16. Attack planner: exact keyspaces, runtime, false positives, budget-bounded run
+    if getattr(args, 'plan', False):
+        backend = args.kernel or 'lowbits16'
+        if args.budget_cpu_hours > 0:
+            # planned runtimes are wall time with every core busy
+            args.budget = args.budget_cpu_hours * 3600 / (os.cpu_count() or 1)
+        catalog = build_attack_catalog(args, lotr_dict, targets)
+        print(f"\n[PHASE 16] Attack planner ({len(catalog)} attacks, {len(targets):,} targets, "
+              f"budget {args.budget:.0f}s)...")
+        native = NativeHasher()
+        if native.available:
+            plans, order, selected = native.plan_attacks(
+                [(mask, words, len(subset)) for _, mask, words, _, subset in catalog],
+                sorted(existing), len(targets), backend, args.budget)
+            print(f"  {'attack':44} {'keyspace':>18} {'time':>10} {'false pos':>10} {'real':>8}  run")
+            for rank, k in enumerate(order):
+                p = plans[k]
+                run = f"{p.fraction:.0%}" if rank < selected else "-"
+                print(f"  {catalog[k][0][:44]:44} {p.keyspace:>18,} {p.seconds:>9.1f}s "
+                      f"{p.false_positives:>10.1f} {p.expected_real:>8.2f}  {run}")
+            if args.plan_run:
+                scorer = native.scorer(*build_score_vocabulary(lotr_dict, existing, targets))
+                deadline = time.time() + args.budget if args.budget > 0 else None
+                for k in order[:selected]:
+                    label, mask, words, route, subset = catalog[k]
+                    left = deadline - time.time() if deadline else 0.0
+                    if deadline and left <= 0:
+                        break
+                    cap = min(left, plans[k].seconds * plans[k].fraction * 1.2) if deadline else 0.0
+                    hits, tested, _ = native.schedule_search(
+                        [(mask, words, -1, 1.0)], [(h, 1.0, 0) for h in subset], backend,
+                        max(cap, 1.0) if deadline else 0.0, scorer, args.min_score)
+                    for name, h, _ in hits:
+                        log_match(name, h, f"{targets.get(h, 'unknown')} <- {label}")
+                        all_matches.append((name, h))
+                    print(f"  ran {label}: {sum(tested):,} candidates, {len(hits)} hits")
+                if scorer:
+                    scorer.close()
+        else:
+            print("  [-] Native library required for the attack planner")
+
+    # 17. Sharded sweep: this process coordinates, --worker processes/hosts do the hashing
+    if getattr(args, 'coordinate', None):
+        print(f"\n[PHASE 17] Sharded keyspace coordinator...")
+        native = NativeHasher()
+        engines = [{'kind': 'mask', 'mask': m} for m in (args.mask or [])]
+        engines += [{'kind': 'hybrid', 'mask': m} for m in (args.hybrid or [])]
+        if args.brute:
+            engines.append({'kind': 'brute', 'min': args.min_len, 'max': args.max_len})
+        words = sorted(lotr_dict) if args.hybrid else []
+        keyspaces = [native.keyspace(e, words) for e in engines] if native.available else []
+        if not native.available:
+            print("  [-] Native library required for sharded sweeps")
+        elif not engines:
+            print("  [-] Nothing to shard: give --mask, --hybrid and/or --brute")
+        elif native.KEYSPACE_OVERFLOW in keyspaces:
+            print("  [-] An engine's keyspace exceeds 64 bits: narrow the mask or --max-len")
+        else:
+            tagged = sorted(([h, cls, bank] for h, tags in tagged_targets.items() for cls, bank in tags),
+                            key=lambda row: (row[0], row[1], row[2] or ''))
+            job = {'engines': engines, 'words': words, 'tagged': tagged,
+                   'backend': args.kernel or 'lowbits16', 'keyspaces': keyspaces}
+            coordinator = ShardCoordinator(job, args.unit_size, script_dir / 'shard_state.jsonl',
+                                           args.lease_ttl)
+            hits = coordinator.serve(parse_address(args.coordinate))
+            for name, h in hits:
+                log_match(name, h, f"{describe(h)} <- sharded sweep")
+                all_matches.append((name, h))
+            print(f"  Found: {len(hits)} matches")
+
+    # 18. Whole-dictionary sweeps over the compiled, memory-mapped word list
+    if args.dict_sweep is not None:
+        sources = sweep_sources(args.dict_sweep, script_dir)
+        print(f"\n[PHASE 18] Compiled dictionary sweep ({', '.join(src.name for src in sources)})...")
+        compiled = open_sweep_word_list(NativeHasher(), 'dict', sources, script_dir, bool(args.dict_sweep))
+        if compiled:
+            generator = PatternGenerator([])
+            first = sorted(compiled.words, key=len)[:args.dict_combine]
+            hybrids = [(f"<word>{mask}", compiled.hybrid(mask, target_set, args.kernel or 'lowbits16'))
+                       for mask in args.hybrid or ['_?d?d', '_?l', '?d']]
+            found, tested = [], 0
+            for label, (hits, count) in [
+                    ('templates', compiled.templates(generator.word_templates() + generator.affix_templates(),
+                                                     target_set)),
+                    (f"{len(first)} x {len(compiled.words):,} combinations",
+                     compiled.combine(target_set, first))] + hybrids:
+                print(f"  {label}: {count:,} candidates, {len(hits)} hits")
+                found += hits
+                tested += count
+            for name, h in found:
+                log_match(name, h, f"{targets.get(h, 'unknown')} <- dictionary sweep")
+                all_matches.append((name, h))
+            compiled.close()
+            print(f"  Found: {len(found)} matches ({tested:,} candidates)")
+
+    # 19. Multi-word concatenations over the compiled word graph
+    if args.dawg_sweep is not None:
+        sources = sweep_sources(args.dawg_sweep, script_dir)
+        print(f"\n[PHASE 19] Word-graph sweep ({', '.join(src.name for src in sources)}, "
+              f"up to {args.dawg_words} words, {args.dawg_max_len} chars)...")
+        graph = open_sweep_word_list(NativeHasher(), 'dawg', sources, script_dir, bool(args.dawg_sweep))
+        if graph:
+            print(f"  {graph.word_count:,} words in {graph.node_count:,} nodes")
+            found, tested = [], 0
+            for prefix in [''] + PatternGenerator([]).prefixes:
+                hits, count = graph.search(target_set, prefix=prefix, words=args.dawg_words,
+                                           max_len=args.dawg_max_len)
+                print(f"  {prefix or '(no prefix)'}: {count:,} candidates, {len(hits)} hits")
+                found += hits
+                tested += count
+            for name, h in found:
+                log_match(name, h, f"{targets.get(h, 'unknown')} <- word-graph sweep")
+                all_matches.append((name, h))
+            graph.close()
+            print(f"  Found: {len(found)} matches ({tested:,} candidates)")
+
     # Deduplicate and filter
     seen = set()
     new_matches = []
     for name, h in all_matches:
         if name.lower() not in existing and name.lower() not in seen:
             seen.add(name.lower())
-            new_matches.append((name, h, targets.get(h, 'unknown')))
+            new_matches.append((name, h, describe(h)))
+
+    # Plausibility triage: rank hits, move likely collisions to a suppressed bucket
+    suppressed = []
+    scorer = None if args.no_triage or not new_matches else \
+        NativeHasher().scorer(*build_score_vocabulary(lotr_dict, existing, targets))
+    if scorer:
+        ranked, suppressed = scorer.triage([(name, h, targets.get(h, 'unknown')) for name, h, _ in new_matches],
+                                           args.min_score)
+        scores = {(name, h): score for name, h, _, score in ranked + suppressed}
+        keep = {(name, h) for name, h, _, _ in ranked}
+        suppressed = [(name, h, describe(h), score) for name, h, _, score in suppressed]
+        new_matches = [(name, h, tags, scores[(name, h)]) for name, h, tags in new_matches if (name, h) in keep]
+        new_matches.sort(key=lambda x: (-x[3], x[0]))
+        scorer.close()
+    else:
+        new_matches = [(name, h, tags, None) for name, h, tags in sorted(new_matches, key=lambda x: x[0])]
 
     # Results
     print("\n" + "=" * 70)
@@ -1572,19 +3944,32 @@ def run_advanced_attack(args):
     print("=" * 70)
     print(f"Total matches:    {len(all_matches)}")
     print(f"NEW matches:      {len(new_matches)}")
+    if scorer:
+        print(f"Suppressed:       {len(suppressed)} (score < {args.min_score} or far below a better name)")
 
     if new_matches:
         print("\nNew matches found:")
-        for name, h, bank in sorted(new_matches, key=lambda x: x[0]):
-            print(f"  0x{h:08X} -> {name:30} [{bank}]")
+        for name, h, bank, score in new_matches:
+            score_str = f" score {score}" if score is not None else ""
+            print(f"  0x{h:08X} -> {name:30} [{bank}]{score_str}")
 
         # Save
         with open(script_dir / 'advanced_matches.txt', 'a') as f:
             f.write(f"\n# Advanced attack: {datetime.now().isoformat()}\n")
-            for name, h, bank in new_matches:
-                f.write(f"0x{h:08X},{name},{bank}\n")
+            for name, h, bank, score in new_matches:
+                f.write(f"0x{h:08X},{name},{bank}" + (f",{score}" if score is not None else "") + "\n")
         print(f"\n[+] Saved to advanced_matches.txt")
 
+    if suppressed:
+        with open(script_dir / 'advanced_suppressed.txt', 'a') as f:
+            f.write(f"\n# Suppressed collisions: {datetime.now().isoformat()}\n")
+            for name, h, bank, score in suppressed:
+                f.write(f"0x{h:08X},{name},{bank},{score}\n")
+        print(f"[+] {len(suppressed)} suppressed hits saved to advanced_suppressed.txt")
+
+    if native_set:
+        native_set.close()
+
 
 def main():
     parser = argparse.ArgumentParser(
@@ -1612,6 +3997,31 @@ Examples:
   python brute_force_advanced.py --bidir --bidir-length 12 # Bidirectional for 12-char
   python brute_force_advanced.py --brute --min-len 1 --max-len 6  # Wwise brute force
   python brute_force_advanced.py --suffix            # Suffix optimization
+  python brute_force_advanced.py --siblings          # Numbered variants of cracked names
+  python brute_force_advanced.py --pairs             # play_X/stop_X joint pair search
+  python brute_force_advanced.py --mutate --mutate-edits 2  # Edit-distance neighborhood of cracked names
+  python brute_force_advanced.py --transplant        # legolas_sa1 -> isildur_sa1 style swaps
+  python brute_force_advanced.py --sandwich 'saruman_?{6}_01'  # Known ends, unknown middle (MITM)
+  python brute_force_advanced.py --lattice 'pf_siege_tower_???????_hit'  # LLL preimage (experimental)
+  python brute_force_advanced.py --mask 'vo_?l?l?l_?d?d'   # Hashcat-style mask on the native kernel
+  python brute_force_advanced.py --hybrid '_?d?d'    # LOTR terms + mask suffix
+  python brute_force_advanced.py --mask 'bus_?l?l?l?l' --hash30  # Also match 30-bit IDs, same pass
+  python brute_force_advanced.py --brute --kernel lowbits16  # Native brute force, 16-bit prefilter
+  python brute_force_advanced.py --routed            # Bank vocabulary vs its own bank's targets only
+  python brute_force_advanced.py --schedule --schedule-seconds 600  # Most-played events first
+  python brute_force_advanced.py --plan --budget 7200 --plan-run  # Best expected cracks for 2 hours
+  python brute_force_advanced.py --plan --budget-cpu-hours 64 --plan-run  # Budget sized in CPU-hours over every core
+  python brute_force_advanced.py --brute --max-len 7 --min-score 700  # Stricter collision triage
+  python brute_force_advanced.py --mask 'vo_?l?l?l?l?l' --hybrid '_?d?d' --live  # Concurrent, live target swaps
+  python brute_force_advanced.py --brute --kernel lowbits16 --max-len 9 --shard 2/8  # Host 2 of 8
+  python brute_force_advanced.py --brute --max-len 9 --coordinate 0.0.0.0:7733  # Lease units to workers
+  python brute_force_advanced.py --worker farm01:7733 --worker-procs 16  # Build-farm host
+  python brute_force_advanced.py --dict-sweep        # Patterns + word_word over the compiled dictionary
+  python brute_force_advanced.py --dict-sweep game.txt exe.txt subs.txt  # Merged lists, compiled once
+  python brute_force_advanced.py --dawg-sweep --dawg-words 3 --dawg-max-len 18  # word_word_word names
+  python brute_force_advanced.py --dawg-sweep game.txt exe.txt subs.txt wiki.txt  # Millions of words
+  python filter_footsteps.py | python brute_force_advanced.py --stream  # Any generator, native matching
+  ./generator --null | python brute_force_advanced.py --stream --stream-nul > hits.tsv
   python brute_force_advanced.py --wordlist words.txt      # Custom wordlist
   python brute_force_advanced.py --all               # Run all attacks
   python brute_force_advanced.py --benchmark         # Hash speed benchmark
@@ -1639,6 +4049,109 @@ Examples:
                         help='Run suffix optimization attack')
     parser.add_argument('--wordlist', '-w', type=str,
                         help='Path to custom wordlist file')
+    parser.add_argument('--siblings', action='store_true',
+                        help='Run native sibling solver around every cracked name')
+    parser.add_argument('--sibling-extend', type=int, default=3,
+                        help='Max chars appended at each truncation point (default: 3)')
+    parser.add_argument('--sibling-prefix-len', type=int, default=0,
+                        help='Also brute force names up to N chars against sibling clusters, '
+                             'last char solved per cluster (default: 0 = off)')
+    parser.add_argument('--pairs', action='store_true',
+                        help='Run native paired-target search (play_X/stop_X must both match)')
+    parser.add_argument('--pair-stem-len', type=int, default=4,
+                        help='Max brute-forced stem length for --pairs (default: 4)')
+    parser.add_argument('--pair-cooccur', type=str, metavar='LOG',
+                        help='Also pair events co-occurring in a captured_audio_names.txt log')
+    parser.add_argument('--pair-window', type=int, default=50,
+                        help='Co-occurrence window in ms for --pair-cooccur (default: 50)')
+    parser.add_argument('--pair-cooccur-only', action='store_true',
+                        help='Use only co-occurrence pairs, not every same-bank pair')
+    parser.add_argument('--mutate', action='store_true',
+                        help='Run native edit-distance/token mutation search around cracked names')
+    parser.add_argument('--mutate-edits', type=int, default=2,
+                        help='Max character edits per mutation (1-3, default: 2)')
+    parser.add_argument('--transplant', action='store_true',
+                        help='Run native cross-bank template transplant (hero/creature/level swaps)')
+    parser.add_argument('--expand-aliases', action='store_true',
+                        help='Add native abbreviation forms (isen, oli, pf) to --mutate/--transplant vocabularies')
+    parser.add_argument('--alias-min-weight', type=int, default=600,
+                        help='Minimum plausibility weight (0-1000) for expanded aliases (default: 600)')
+    parser.add_argument('--sandwich', nargs='+', metavar='PATTERN',
+                        help="Native sandwich MITM templates, e.g. 'saruman_?{6}_01' 'play_amb_?????_loop'")
+    parser.add_argument('--sandwich-charset', type=str, default=None,
+                        help='Charset for sandwich wildcards (default: [a-z_0-9])')
+    parser.add_argument('--lattice', nargs='+', metavar='PATTERN',
+                        help="Native LLL preimage search, '?' = unknown char (e.g. 'pf_siege_tower_???????_hit')")
+    parser.add_argument('--lattice-radius', type=float, default=0.0,
+                        help='Enumeration radius for --lattice (0 = auto)')
+    parser.add_argument('--mask', nargs='+', metavar='MASK',
+                        help="Native mask attack: ?l=[a-z] ?d=[0-9] ?w=[a-z_0-9] [abc]=custom (e.g. 'vo_?l?l?l_?d?d')")
+    parser.add_argument('--hybrid', nargs='+', metavar='MASK',
+                        help="Native hybrid attack: every LOTR term followed by MASK (e.g. '_?d?d')")
+    parser.add_argument('--kernel', choices=sorted(NativeHasher.KERNEL_BACKENDS), default=None,
+                        help='Native kernel backend for --mask/--hybrid (default: lowbits16); also moves --brute to native')
+    parser.add_argument('--routed', nargs='*', metavar='MASK', default=None,
+                        help="Native bank-routed attack (bank vocabulary x MASKs vs that bank's targets only)")
+    parser.add_argument('--hash30', action='store_true',
+                        help='Also match --mask/--hybrid targets as Hash30 (30-bit folded) IDs in the same pass')
+    parser.add_argument('--schedule', nargs='*', metavar='MASK', default=None,
+                        help='Native priority scheduler: bank vocabulary x MASKs, CPU share by play count x yield')
+    parser.add_argument('--schedule-brute', nargs='*', metavar='MASK', default=[],
+                        help="Extra low-yield masks over every target for --schedule (e.g. '?l?l?l?l?l?l?l')")
+    parser.add_argument('--schedule-seconds', type=float, default=3600.0,
+                        help='Wall-clock budget for --schedule (default: 3600)')
+    parser.add_argument('--plan', action='store_true',
+                        help='Native attack planner: keyspace, runtime, false positives and expected cracks per attack')
+    parser.add_argument('--budget', type=float, default=3600.0,
+                        help='Wall-clock budget in seconds for --plan (0 = no limit, default: 3600)')
+    parser.add_argument('--budget-cpu-hours', type=float, default=0.0,
+                        help='Budget for --plan in CPU-hours over every core (overrides --budget)')
+    parser.add_argument('--plan-run', action='store_true',
+                        help='Execute the budget-bounded --plan schedule, best expected cracks/second first')
+    parser.add_argument('--no-numa', action='store_true',
+                        help='Disable NUMA placement (per-node pinning and table replicas) in native pools')
+    parser.add_argument('--live', action='store_true',
+                        help='Run every --mask/--hybrid at once; plausible cracks and extracted_events.json edits '
+                             'update all running attacks live (bypasses the ledger)')
+    parser.add_argument('--shard', type=parse_shard, default=None, metavar='I/N',
+                        help='Run only shard I of N of the --mask/--hybrid/native --brute keyspaces')
+    parser.add_argument('--coordinate', type=str, default=None, metavar='[HOST:]PORT',
+                        help='Coordinate a sharded --mask/--hybrid/--brute sweep: lease units to --worker processes')
+    parser.add_argument('--stream', action='store_true',
+                        help='Read candidates from stdin (one per line) and print only matches with their '
+                             'class and bank tags (no other attacks)')
+    parser.add_argument('--stream-nul', action='store_true',
+                        help='--stream candidates are NUL-delimited instead of newline-delimited')
+    parser.add_argument('--stream-threads', type=int, default=0,
+                        help='Hashing threads for --stream (default: all cores)')
+    parser.add_argument('--worker', type=str, default=None, metavar='HOST:PORT',
+                        help='Run as a shard worker for the coordinator at HOST:PORT (no other attacks)')
+    parser.add_argument('--worker-procs', type=int, default=1,
+                        help='Local worker processes for --worker (default: 1)')
+    parser.add_argument('--worker-threads', type=int, default=1,
+                        help='Native threads per --worker process (0 = every core, default: 1)')
+    parser.add_argument('--unit-size', type=int, default=1 << 32,
+                        help='Candidates per leased unit for --coordinate (default: 2^32)')
+    parser.add_argument('--lease-ttl', type=float, default=60.0,
+                        help='Seconds without a heartbeat before a lease is re-issued (default: 60)')
+    parser.add_argument('--dict-sweep', nargs='*', metavar='FILE', default=None,
+                        help='Sweep compiled word lists (default: lotr_dictionary.txt) through every pattern, '
+                             'word_word combination and --hybrid mask (default: _?d?d _?l ?d)')
+    parser.add_argument('--dict-combine', type=int, default=500,
+                        help='Shortest words used as first word of --dict-sweep combinations (default: 500)')
+    parser.add_argument('--dawg-sweep', nargs='*', metavar='FILE', default=None,
+                        help='Sweep word lists (default: lotr_dictionary.txt) compiled into a word graph '
+                             'as word_word... concatenations, bare and behind every prefix')
+    parser.add_argument('--dawg-words', type=int, default=2,
+                        help='Most words joined per --dawg-sweep candidate (default: 2)')
+    parser.add_argument('--dawg-max-len', type=int, default=16,
+                        help='Longest --dawg-sweep candidate in characters (default: 16)')
+    parser.add_argument('--no-ledger', action='store_true',
+                        help='Ignore search_ledger.bin: re-run --mask/native --brute keyspaces in full')
+    parser.add_argument('--min-score', type=int, default=600,
+                        help='Plausibility score (0-1000) a hit needs to make the shortlist (default: 600)')
+    parser.add_argument('--no-triage', action='store_true',
+                        help='Report every hit unranked instead of running the native plausibility triage')
     parser.add_argument('--all', '-a', action='store_true',
                         help='Run all attack modes (patterns, mitm, suffix)')
     parser.add_argument('--benchmark', '-b', action='store_true',
@@ -1649,6 +4162,8 @@ Examples:
                         help='Disable fuzzy hash optimization in brute force')
 
     args = parser.parse_args()
+    if args.shard and args.brute and not args.kernel and not args.coordinate:
+        parser.error('--shard with --brute needs --kernel (the Python brute force cannot be sharded)')
 
     # --all enables safe attacks (not brute force which can be slow)
     if args.all:
@@ -1656,9 +4171,21 @@ Examples:
         args.mitm = True
         args.suffix = True
 
+    if args.worker:
+        run_shard_worker(args)
+        return
+
+    if args.stream:
+        run_stream(args)
+        return
+
     # Default to patterns if nothing specified
     if not any([args.patterns, args.mitm, args.bidir, args.brute,
-                args.suffix, args.wordlist, args.benchmark]):
+                args.suffix, args.wordlist, args.benchmark, args.siblings,
+                args.pairs, args.mutate, args.transplant, args.sandwich,
+                args.lattice, args.mask, args.hybrid, args.routed is not None,
+                args.schedule is not None, args.plan, args.coordinate,
+                args.dict_sweep is not None, args.dawg_sweep is not None]):
         args.patterns = True
 
     if args.benchmark:
@@ -1704,6 +4231,14 @@ def run_benchmark():
         nat_time = time.time() - start
         nat_rate = (iterations * len(test_strings)) / nat_time
         print(f"Native C:          {nat_rate/1e6:.2f} M/s ({nat_rate/py_rate:.1f}x)")
+        batch = test_strings * iterations
+        start = time.time()
+        native.hash_many(batch)
+        pack_rate = len(batch) / (time.time() - start)
+        print(f"Native packed:     {pack_rate/1e6:.2f} M/s ({pack_rate/py_rate:.1f}x, incl. packing)")
+        for backend in NativeHasher.KERNEL_BACKENDS:
+            rate = native.kernel_benchmark(backend)
+            print(f"Kernel {backend + ':':11}{rate/1e6:8.1f} M candidates/s (len 6, 1500 targets, one thread)")
 
     print("-" * 50)
 
@@ -5,6 +5,7 @@ Extract Event IDs from organized BNK XML files.
 Parses the Organized_Final_AllLanguages directory structure to extract:
 - Bank name (from folder structure)
 - Event IDs (from CAkEvent objects in XML)
+- Other FNV-named IDs (switch/state groups, switches, states, RTPCs, busses, banks)
 - TXTP filenames (for initial event names)
 
 Outputs:
@@ -38,6 +39,20 @@ EVENT_ID_PATTERN = re.compile(
 # Simpler line-by-line pattern for ulID in CAkEvent context
 ULID_LINE_PATTERN = re.compile(r'name="ulID"\s+value="(\d+)"')
 
+# Any named field with a value (and the resolved name wwiser found, if any)
+FIELD_LINE_PATTERN = re.compile(r'name="(\w+)"\s+value="(\d+)"(?:[^>]*hashname="([^"]*)")?')
+
+# XML field -> target class for non-event IDs that are hashes of names
+CLASS_FIELDS = {
+    'ulSwitchID': 'switch',
+    'ulStateGroupID': 'state_group',
+    'ulStateID': 'state',
+    'RTPCID': 'rtpc',
+    'OverrideBusId': 'bus',
+    'dwSoundBankID': 'bank',
+    'bankID': 'bank',
+}
+
 
 def extract_events_from_xml(xml_path: Path) -> List[int]:
     """Extract all CAkEvent IDs from a BNK XML file."""
@@ -65,6 +80,45 @@ def extract_events_from_xml(xml_path: Path) -> List[int]:
     return event_ids
 
 
+def extract_targets_from_xml(xml_path: Path) -> List[Tuple[int, str, str]]:
+    """
+    Extract every FNV-named ID from a BNK XML as (id, class, known_name).
+    Classes: event, switch_group, switch, state_group, state, rtpc, bus, bank.
+    known_name is wwiser's resolved hashname ('' when still unknown).
+    """
+    targets = []
+    try:
+        with open(xml_path, 'r', encoding='utf-8', errors='ignore') as f:
+            content = f.read()
+
+        in_event = False
+        group_type = None
+        for line in content.split('\n'):
+            if 'name="CAkEvent"' in line:
+                in_event = True
+                continue
+            match = FIELD_LINE_PATTERN.search(line)
+            if not match:
+                if in_event and '</object>' in line:
+                    in_event = False
+                continue
+            field, value, known = match.group(1), int(match.group(2)), match.group(3) or ''
+            if field == 'eGroupType':
+                group_type = 'state_group' if value == 1 else 'switch_group'
+            elif in_event and field == 'ulID':
+                targets.append((value, 'event', known))
+                in_event = False
+            elif field == 'ulGroupID' and value and group_type:
+                targets.append((value, group_type, known))
+            elif field in CLASS_FIELDS and value:
+                targets.append((value, CLASS_FIELDS[field], known))
+
+    except Exception as e:
+        print(f"  Error parsing {xml_path.name}: {e}")
+
+    return targets
+
+
 def extract_txtp_names(bank_dir: Path) -> Dict[int, str]:
     """Extract event ID -> name mapping from TXTP filenames."""
     txtp_map = {}
@@ -84,14 +138,23 @@ def extract_txtp_names(bank_dir: Path) -> Dict[int, str]:
     return txtp_map
 
 
-def scan_bank_folder(bank_path: Path, bank_name: str) -> Dict[int, dict]:
-    """Scan a bank folder for XML and TXTP files."""
+def scan_bank_folder(bank_path: Path, bank_name: str,
+                     tagged: Dict[int, dict] = None) -> Dict[int, dict]:
+    """Scan a bank folder for XML and TXTP files (non-event IDs go to tagged)."""
     events = {}
     
     # Find the XML file (named like NNNNNN.bnk.xml)
     for xml_file in bank_path.glob("*.bnk.xml"):
         event_ids = extract_events_from_xml(xml_file)
         print(f"  {bank_name}: {len(event_ids)} events from {xml_file.name}")
+
+        if tagged is not None:
+            for tid, cls, known in extract_targets_from_xml(xml_file):
+                entry = tagged.setdefault(tid, {'tags': [], 'name': None})
+                if [cls, bank_name] not in entry['tags']:
+                    entry['tags'].append([cls, bank_name])
+                if known:
+                    entry['name'] = known
         
         for eid in event_ids:
             events[eid] = {
@@ -109,7 +172,8 @@ def scan_bank_folder(bank_path: Path, bank_name: str) -> Dict[int, dict]:
     return events
 
 
-def scan_directory(base_dir: Path, label: str) -> Dict[int, dict]:
+def scan_directory(base_dir: Path, label: str,
+                   tagged: Dict[int, dict] = None) -> Dict[int, dict]:
     """Scan a directory structure (root or language folder)."""
     all_events = {}
     
@@ -128,7 +192,7 @@ def scan_directory(base_dir: Path, label: str) -> Dict[int, dict]:
         # Each bank folder contains a subfolder with the bank ID
         for id_folder in bank_folder.iterdir():
             if id_folder.is_dir():
-                events = scan_bank_folder(id_folder, bank_name)
+                events = scan_bank_folder(id_folder, bank_name, tagged)
                 all_events.update(events)
     
     return all_events
@@ -140,13 +204,14 @@ def main():
     print("=" * 70)
     
     all_events = {}
+    tagged = {}
     
     # Scan root (SFX banks)
-    root_events = scan_directory(ROOT_DIR, "ROOT (SFX)")
+    root_events = scan_directory(ROOT_DIR, "ROOT (SFX)", tagged)
     all_events.update(root_events)
     
     # Scan english_us_ (voice banks)
-    english_events = scan_directory(ENGLISH_DIR, "ENGLISH_US (Voice)")
+    english_events = scan_directory(ENGLISH_DIR, "ENGLISH_US (Voice)", tagged)
     all_events.update(english_events)
     
     # Summary
@@ -160,6 +225,14 @@ def main():
         by_bank[info['bank']] += 1
     
     print(f"  Banks with events: {len(by_bank)}")
+
+    by_class = defaultdict(int)
+    for info in tagged.values():
+        for cls in {c for c, _ in info['tags']}:
+            by_class[cls] += 1
+    print(f"  Tagged targets (all classes): {len(tagged)}")
+    for cls, count in sorted(by_class.items(), key=lambda x: -x[1]):
+        print(f"    {cls}: {count}")
     print("\n  Events per bank:")
     for bank, count in sorted(by_bank.items(), key=lambda x: -x[1])[:20]:
         print(f"    {bank}: {count}")
@@ -168,7 +241,8 @@ def main():
     output = {
         'total_events': len(all_events),
         'banks': dict(by_bank),
-        'events': {str(k): v for k, v in all_events.items()}
+        'events': {str(k): v for k, v in all_events.items()},
+        'targets': {str(k): v for k, v in tagged.items()}
     }
     
     with open(OUTPUT_JSON, 'w') as f:
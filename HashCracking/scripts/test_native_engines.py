@@ -0,0 +1,777 @@
+"""
+Regression tests for the native engines in Dll/fnv1_hash.c, driven through
+the ctypes wrappers in brute_force_advanced.py.
+
+The shipped fnv1_hash.dll is a Windows build, so the library is compiled
+from source into a temporary directory (set FNV1_HASH_LIB to test a
+prebuilt library instead).  Tests are skipped when no compiler is found.
+
+Usage: python test_native_engines.py [-v]
+"""
+
+import os
+import sys
+import shutil
+import tempfile
+import unittest
+import subprocess
+import time
+import contextlib
+import io
+import itertools
+from pathlib import Path
+
+SCRIPT_DIR = Path(__file__).resolve().parent
+SOURCE = SCRIPT_DIR.parent / 'Dll' / 'fnv1_hash.c'
+sys.path.insert(0, str(SCRIPT_DIR))
+
+import brute_force_advanced as bfa  # noqa: E402
+
+BUILD_DIR = None
+
+
+def build(extra_flags, output):
+    """Compile fnv1_hash.c with gcc/cc; returns the output path or None."""
+    compiler = os.environ.get('CC') or shutil.which('gcc') or shutil.which('cc')
+    if not compiler:
+        return None
+    cmd = [compiler, '-O2', '-march=native', '-pthread', *extra_flags,
+           str(SOURCE), '-o', str(output), '-lm']
+    result = subprocess.run(cmd, capture_output=True, text=True)
+    return output if result.returncode == 0 else None
+
+
+def load_native():
+    global BUILD_DIR
+    path = os.environ.get('FNV1_HASH_LIB')
+    if not path:
+        if BUILD_DIR is None:
+            BUILD_DIR = Path(tempfile.mkdtemp(prefix='fnv1_test_'))
+        lib = BUILD_DIR / 'fnv1_hash.dll'
+        if not lib.exists() and not build(['-shared', '-fPIC'], lib):
+            return None
+        path = lib
+    with contextlib.redirect_stdout(io.StringIO()):
+        native = bfa.NativeHasher(Path(path))
+    return native if native.available else None
+
+
+NATIVE = load_native()
+h = bfa.fnv1_hash
+
+
+@unittest.skipUnless(NATIVE, 'native library could not be built')
+class SiblingTest(unittest.TestCase):
+    def test_neighborhood_of_cracked_names(self):
+        targets = {h(n) for n in ('amb_wind_02', 'amb_wind_13', 'amb_wx', 'zzz_q')}
+        hits = NATIVE.sibling_search(['AMB_Wind_01'], targets, max_extend=2)
+        self.assertEqual(sorted((n, v, seed) for n, v, seed in hits),
+                         [(n, h(n), 'AMB_Wind_01') for n in ('amb_wind_02', 'amb_wind_13', 'amb_wx')])
+
+    def test_clusters_and_prefix_search(self):
+        # names differing only in the last character share the upper 24 bits
+        self.assertEqual(NATIVE.sibling_clusters({h('a_01'), h('a_02'), h('zzz')}), [(h('a_01') >> 8, 2)])
+        hits = NATIVE.sibling_prefix_search(3, 3, {h('ab1'), h('ab2'), h('zz_'), h('1ab')})
+        self.assertEqual(sorted(n for n, _ in hits), ['ab1', 'ab2', 'zz_'])    # names start with a letter
+
+
+@unittest.skipUnless(NATIVE, 'native library could not be built')
+class PairTest(unittest.TestCase):
+    def test_pairs_within_a_bank(self):
+        # play_fire has no partner in its bank; stop_rain is in another bank
+        targets = {h('play_wind'): 'amb', h('stop_wind'): 'amb', h('play_fire'): 'amb', h('stop_rain'): 'other'}
+        hits = NATIVE.pair_search(targets, stems=['wind', 'fire', 'rain'])
+        self.assertEqual(sorted(hits), sorted([('play_wind', h('play_wind')), ('stop_wind', h('stop_wind'))]))
+
+    def test_brute_stems_and_extra_pairs(self):
+        targets = {h('play_ab'): 'amb', h('stop_ab'): 'music', h('zz_on'): 'amb', h('zz_off'): 'music'}
+        self.assertEqual(NATIVE.pair_search(targets, max_stem=2), [])
+        hits = NATIVE.pair_search(targets, max_stem=2, extra_pairs={(h('play_ab'), h('stop_ab'))})
+        self.assertEqual(sorted(n for n, _ in hits), ['play_ab', 'stop_ab'])
+
+
+@unittest.skipUnless(NATIVE, 'native library could not be built')
+class MutationTest(unittest.TestCase):
+    def test_edits_swaps_and_vocabulary_tokens(self):
+        names = ['amb_wnd_01', 'amb_wind_02', 'amb_wiind_01', 'wind_amb_01', 'amb_fire_wind_01']
+        far = ['amb_wind_01_x', 'amb_wnd_02']                  # two edits away
+        hits, tested = NATIVE.mutation_search(['Amb_Wind_01'], ['fire'], {h(n) for n in names + far}, 1)
+        self.assertEqual(sorted(n for n, _, _ in hits), sorted(names))
+        self.assertEqual({seed for _, _, seed in hits}, {'Amb_Wind_01'})
+        self.assertGreater(tested, len(names))
+        hits, _ = NATIVE.mutation_search(['amb_wind_01'], [], {h('amb_wnd_02')}, 2)
+        self.assertEqual([n for n, _, _ in hits], ['amb_wnd_02'])
+
+
+@unittest.skipUnless(NATIVE, 'native library could not be built')
+class TransplantTest(unittest.TestCase):
+    def test_subject_swapped_within_its_class(self):
+        subjects = {'hero': [['legolas'], ['isildur'], ['witchking', 'wk']], 'creature': [['troll']]}
+        names = ['isildur_sa1', 'wk_sa1', 'witchking_sa1']
+        other = ['troll_sa1', 'gimli_sa1', 'isildur_sa2']      # other class, unknown subject, other template
+        hits, templates, tested = NATIVE.transplant_search(['Legolas_SA1'], {h(n) for n in names + other},
+                                                           subjects)
+        self.assertEqual(sorted((n, seed) for n, _, seed in hits), [(n, 'Legolas_SA1') for n in sorted(names)])
+        self.assertEqual((templates, tested), (1, 4))
+
+
+@unittest.skipUnless(NATIVE, 'native library could not be built')
+class AliasTest(unittest.TestCase):
+    def test_forms_and_weights(self):
+        forms = NATIVE.expand_aliases(['Isengard', 'pelennor_fields', 'oliphaunt'])
+        weights = {form: (weight, term) for form, weight, term in forms}
+        self.assertEqual(weights['pf'], (900, 'pelennor_fields'))          # initialism
+        self.assertEqual(weights['pelennor'], (850, 'pelennor_fields'))    # head token
+        self.assertEqual(weights['isen'], (750, 'Isengard'))               # truncation
+        self.assertEqual(weights['isngrd'], (500, 'Isengard'))             # vowels dropped
+        self.assertIn('lphnt', weights)                                    # consonant skeleton
+        self.assertEqual([w for _, w, _ in forms], sorted((w for _, w, _ in forms), reverse=True))
+        self.assertTrue(all(w >= 700 for _, w, _ in NATIVE.expand_aliases(['isengard'], min_weight=700)))
+
+
+@unittest.skipUnless(NATIVE, 'native library could not be built')
+class SandwichTest(unittest.TestCase):
+    def test_both_pattern_forms(self):
+        self.assertEqual(NATIVE.parse_sandwich('saruman_???_01'), ('saruman_', 3, '_01'))
+        self.assertEqual(NATIVE.parse_sandwich('x_?{2}'), ('x_', 2, ''))
+        self.assertIsNone(NATIVE.parse_sandwich('a?b?c'))
+        targets = {h('saruman_ab9_01'), h('x_q1'), h('saruman_ab9_02')}
+        hits, _ = NATIVE.sandwich_search(['Saruman_???_01', 'x_?{2}'], targets, threads=2)
+        self.assertEqual(sorted(hits), [('saruman_ab9_01', h('saruman_ab9_01'), 'Saruman_?{3}_01'),
+                                        ('x_q1', h('x_q1'), 'x_?{2}')])
+
+    def test_charset(self):
+        hits, _ = NATIVE.sandwich_search(['vo_??_01'], {h('vo_ab_01'), h('vo_a1_01')}, charset='ab')
+        self.assertEqual([n for n, _, _ in hits], ['vo_ab_01'])
+
+
+@unittest.skipUnless(NATIVE, 'native library could not be built')
+class LatticeTest(unittest.TestCase):
+    def test_preimages_of_the_pattern(self):
+        for pattern, name in (('vo_????_01', 'vo_abcd_01'), ('amb_?????', 'amb_wind1')):
+            hits, tested = NATIVE.lattice_search(pattern, {h(name)}, max_candidates=2_000_000)
+            self.assertEqual(hits, [(name, h(name))], pattern)
+            self.assertLessEqual(tested, 2_000_000)
+        # a hit is any preimage of the target that fits the pattern
+        hits, _ = NATIVE.lattice_search('pf_??????_hit', {h('pf_towers_hit'), h('pf_gates1_hit')})
+        for found, value in hits:
+            self.assertEqual((h(found), len(found), found[:3], found[-4:]), (value, 13, 'pf_', '_hit'))
+        self.assertLessEqual({'pf_towers_hit', 'pf_gates1_hit'}, {found for found, _ in hits})
+
+
+@unittest.skipUnless(NATIVE, 'native library could not be built')
+class MaskParserTest(unittest.TestCase):
+    def keyspace(self, mask):
+        return NATIVE.keyspace({'kind': 'mask', 'mask': mask})
+
+    def test_trailing_lone_question_mark_is_literal(self):
+        self.assertEqual(self.keyspace('ab?'), 1)
+        hits, _ = NATIVE.mask_search('ab?', {h('ab?')})
+        self.assertEqual([name for name, _ in hits], ['ab?'])
+
+    def test_double_question_mark_is_literal(self):
+        self.assertEqual(self.keyspace('a??b?d'), 10)
+        hits, _ = NATIVE.mask_search('a??b?d', {h('a?b7')})
+        self.assertEqual([name for name, _ in hits], ['a?b7'])
+
+    def test_literals_do_not_count_as_positions(self):
+        # 19 literal chars + 10 variable positions: over 24 in total
+        self.assertEqual(self.keyspace('play_music_battle_a' + '?w' * 10), 37 ** 10)
+        self.assertEqual(self.keyspace('?l' + 'x' * 20 + '?d'), 260)
+        self.assertEqual(self.keyspace('?l' + 'x' * 23 + '?d'), 0)     # 25 positions
+
+    def test_prefix_and_suffix_fold(self):
+        name = 'play_music_battle_theme_42'
+        hits, tested = NATIVE.mask_search('play_music_battle_theme_?d?d', {h(name)})
+        self.assertEqual([n for n, _ in hits], [name])
+        self.assertEqual(tested, 100)
+        hits, tested = NATIVE.mask_search('?l?l_loop_01', {h('qz_loop_01')})
+        self.assertEqual([n for n, _ in hits], ['qz_loop_01'])
+        self.assertEqual(tested, 26 * 26)
+
+    def test_interior_literals_and_sets(self):
+        self.assertEqual(self.keyspace('[a-c]x[a]?d'), 30)
+        hits, _ = NATIVE.mask_search('[a-c]x[a]?d', {h('bxa5')})
+        self.assertEqual([n for n, _ in hits], ['bxa5'])
+
+    def test_syntax_errors(self):
+        for mask in ('?q', '[abc', '[]', 'x' * 32 + '?d'):
+            self.assertEqual(self.keyspace(mask), 0, mask)
+
+    def test_high_byte_last_set(self):
+        # 0xe9 and 'i' (0x69) differ only in bit 7: both must resolve exactly
+        targets = {h('abcde\xe9'), h('qrstui')}
+        for backend in ('scalar', 'lowbits16', 'bitslice'):
+            hits, tested = NATIVE.mask_search('?l?l?l?l?l[\xe9\xeai]', targets, backend=backend)
+            self.assertEqual(sorted(n for n, _ in hits), ['abcde\xe9', 'qrstui'], backend)
+            self.assertEqual(tested, 26 ** 5 * 3, backend)
+        # high bytes in the positions the bitslice backend transposes
+        name = 'x\xe9\xfcz'
+        for backend in ('scalar', 'lowbits16', 'bitslice'):
+            hits, _ = NATIVE.mask_search('?l[e\xe9][u\xfc][z\xfa]', {h(name)}, backend=backend)
+            self.assertEqual([n for n, _ in hits], [name], backend)
+
+    def test_tested_stops_with_full_match_list(self):
+        targets = {h('aa00'), h('aa01'), h('zz99')}
+        for backend in ('scalar', 'lowbits16', 'bitslice'):
+            hits, tested = NATIVE.mask_search('?l?l?d?d', targets, backend=backend, max_found=2)
+            self.assertEqual(len(hits), 2, backend)
+            self.assertLess(tested, 67600, backend)
+            hits, tested = NATIVE.mask_search('?l?l?d?d', targets, backend=backend)
+            self.assertEqual(len(hits), 3, backend)
+            self.assertEqual(tested, 67600, backend)
+        hits, tested = NATIVE.hybrid_search(['aa', 'x' * 30, 'zz'], '?d?d', targets)
+        self.assertEqual(len(hits), 3)
+        self.assertEqual(tested, 200)           # 30 chars + 2 digits > 31: skipped
+
+
+@unittest.skipUnless(NATIVE, 'native library could not be built')
+class TaggedSearchTest(unittest.TestCase):
+    def test_hash30_values_are_masked(self):
+        h30 = bfa.fnv1_hash30('mus_loop_7')
+        for value in (h30, h30 | 0xC0000000):
+            hits, _ = NATIVE.mask_search_tagged('mus_loop_?d', [(value, 'hash30')])
+            self.assertEqual([(n, f) for n, _, f in hits], [('mus_loop_7', 'hash30')], hex(value))
+
+    def test_one_hit_per_target_and_name(self):
+        tagged = [(h('ab1'), 'fnv1'), (bfa.fnv1_hash30('ab1'), 'hash30'), (h('ab1'), 'fnv1')]
+        hits, _ = NATIVE.mask_search_tagged('ab?d', tagged)
+        self.assertEqual(sorted(f for _, _, f in hits), ['fnv1', 'fnv1', 'hash30'])
+        hits, _ = NATIVE.mask_search_tagged('a?l?d', tagged, words=['x', ''])
+        self.assertEqual(len(hits), 3)
+
+
+@unittest.skipUnless(NATIVE, 'native library could not be built')
+class TargetSetTest(unittest.TestCase):
+    def test_classes_banks_and_hash30(self):
+        import ctypes
+        rows = [(h('amb_wind'), 0, 0, 0), (h('amb_wind'), 2, 1, 0), (h('amb_wind'), 2, 1, 0),
+                (bfa.fnv1_hash30('amb_rain') | 0x80000000, 5, 0, 1), (h('amb_fire'), 6, 1, 0)]
+        lib = NATIVE.lib
+        handle = lib.target_set_create(
+            (ctypes.c_uint32 * len(rows))(*[r[0] for r in rows]),
+            (ctypes.c_uint8 * len(rows))(*[r[1] for r in rows]),
+            (ctypes.c_uint16 * len(rows))(*[r[2] for r in rows]),
+            (ctypes.c_uint8 * len(rows))(*[r[3] for r in rows]), len(rows))
+        try:
+            entries = (ctypes.c_int * 8)()
+            self.assertEqual(lib.target_set_classify(handle, h('amb_wind'), entries, 8), 2)
+            self.assertEqual(lib.target_set_classify(handle, h('amb_rain'), entries, 8), 1)
+            cls, form = ctypes.c_int(), ctypes.c_int()
+            lib.target_set_entry(handle, entries[0], None, ctypes.byref(cls), None, ctypes.byref(form))
+            self.assertEqual((cls.value, form.value), (5, 1))
+            self.assertEqual(lib.target_set_ids(handle, None, 0), 2 + 4)
+        finally:
+            lib.target_set_free(handle)
+
+    def test_mask_search_reports_every_entry(self):
+        tset = NATIVE.target_set({h('amb_wind'): [('event', 'SFXAmb'), ('switch', 'SFXWeather')],
+                                  h('amb_fire'): [('bus', 'SFXAmb')]})
+        try:
+            self.assertEqual(sorted(tset.classify(h('amb_wind'))),
+                             [('event', 'SFXAmb'), ('switch', 'SFXWeather')])
+            hits, _ = tset.mask_search('amb_?l?l?l?l')
+            self.assertEqual(sorted((n, c) for n, _, c, _ in hits),
+                             [('amb_fire', 'bus'), ('amb_wind', 'event'), ('amb_wind', 'switch')])
+        finally:
+            tset.close()
+
+    def test_packed_hashing_matches_python_beyond_ascii(self):
+        names = ['Théoden_Hall', 'ÉOWYN', 'ŋoldor', 'amb_wind', 'x' * 70]
+        self.assertEqual(NATIVE.hash_many(names), [h(n) for n in names])
+        tset = NATIVE.target_set({h(n): [('event', 'SFX')] for n in names[:3]})
+        try:
+            self.assertEqual(sorted(n for n, _ in tset.match(names)), sorted(names[:3]))
+        finally:
+            tset.close()
+
+
+@unittest.skipUnless(NATIVE, 'native library could not be built')
+class ScorerTest(unittest.TestCase):
+    def setUp(self):
+        self.scorer = NATIVE.scorer(['play_keep_fighting', 'stop_keep_fighting', 'play_siege_tower'],
+                                    {None: ['keep', 'fighting', 'siege', 'tower', 'play']})
+
+    def tearDown(self):
+        self.scorer.close()
+
+    def test_long_letter_runs(self):
+        _, comp = self.scorer.score('play_keepfighting')
+        self.assertEqual(comp['coverage'], 1000)
+        for run in (31, 32, 63, 64, 200):
+            total, comp = self.scorer.score('play_' + 'keep' * (run // 4) + 'k' * (run % 4))
+            self.assertGreaterEqual(total, 0, run)
+        _, comp = self.scorer.score('keep' * 16 + '_play')
+        self.assertEqual(comp['coverage'], 4 * 1000 // 68)      # the 64-letter run is uncovered
+
+    def test_triage_groups_by_hash(self):
+        hits = [('play_siege_tower', 7, None), ('qxzv_wkkq', 7, None), ('play_siege_tower', 7, None)]
+        kept, suppressed = self.scorer.triage(hits, min_score=0, margin=100)
+        self.assertEqual([k[0] for k in kept], ['play_siege_tower'])
+        self.assertEqual([k[0] for k in suppressed], ['qxzv_wkkq'])
+
+
+@unittest.skipUnless(NATIVE, 'native library could not be built')
+class SchedulerTest(unittest.TestCase):
+    def test_slice_with_many_hits_loses_none(self):
+        # 300 hits in a single slice: far past the initial 64-entry buffer
+        names = [a + b + d for a, b, d in itertools.product('abc', 'abcdefghij', '0123456789')]
+        for backend in ('scalar', 'lowbits16'):
+            hits, tested, cracked = NATIVE.schedule_search(
+                [('?l?l?d', None, -1, 1.0)], [(h(n), 1.0, 0) for n in names], backend, threads=1)
+            self.assertEqual(sorted(n for n, _, _ in hits), sorted(names), backend)
+            self.assertEqual(len(cracked), 300, backend)
+            self.assertEqual(tested, [26 * 26 * 10], backend)
+
+    def test_pruning_stops_only_the_covering_attack(self):
+        # route 0 is cracked in the first slice; route 1 runs its whole keyspace
+        hits, tested, cracked = NATIVE.schedule_search(
+            [('?l?l?l?l?l', None, 0, 1.0), ('zz?l?l?l?d', None, 1, 1.0)],
+            [(h('aaaab'), 1.0, 0), (h('zzqrs7'), 1.0, 1), (h('nothere'), 1.0, 1)], threads=1)
+        self.assertEqual(sorted((n, k) for n, _, k in hits), [('aaaab', 0), ('zzqrs7', 1)])
+        self.assertEqual(cracked, {h('aaaab'), h('zzqrs7')})
+        self.assertLess(tested[0], 26 ** 5)
+        self.assertEqual(tested[1], 26 ** 3 * 10)
+
+
+@unittest.skipUnless(NATIVE, 'native library could not be built')
+class PlannerTest(unittest.TestCase):
+    def test_estimates_ranking_and_budget_fill(self):
+        attacks = [('?l?l?l?l', None, 10), ('vo_?l?l', None, 10), ('zz_?d', None, 10), ('_?d', ['amb', 'vo'], 4)]
+        known = ['vo_ab', 'VO_cd', 'abcd', 'amb_1']
+        plans, order, selected = NATIVE.plan_attacks(attacks, known, 10, budget_seconds=100.0, throughput=1000.0)
+        self.assertEqual([p.keyspace for p in plans], [26 ** 4, 676, 10, 20])
+        self.assertAlmostEqual(plans[1].seconds, 0.676)
+        self.assertAlmostEqual(plans[0].false_positives, 26 ** 4 * 10 / 2 ** 32)
+        self.assertEqual([p.expected_real for p in plans], [2.5, 5.0, 0.0, 1.0])
+        self.assertEqual(order, [3, 1, 0, 2])
+        self.assertEqual(selected, 3)
+        self.assertEqual([plans[k].fraction for k in order[:2]], [1.0, 1.0])
+        self.assertAlmostEqual(plans[0].fraction, (100.0 - 0.676 - 0.02) / 456.976)
+
+    def test_measured_throughput_is_machine_wide(self):
+        # the planner times every core; one thread cannot be faster than that
+        plans, _, _ = NATIVE.plan_attacks([('?l?l?l?l?l?l', None, 1500)], [], 1500)
+        single = NATIVE.kernel_benchmark('lowbits16', seconds=0.25)
+        self.assertGreater(plans[0].seconds, 0)
+        self.assertLess(plans[0].seconds, 26 ** 6 / single * 1.5)
+
+
+@unittest.skipUnless(NATIVE, 'native library could not be built')
+class LedgerTest(unittest.TestCase):
+    def setUp(self):
+        self.dir = Path(tempfile.mkdtemp(prefix='fnv1_ledger_'))
+        self.path = self.dir / 'search_ledger.bin'
+        self.ledger = NATIVE.ledger(self.path)
+
+    def tearDown(self):
+        if self.ledger:
+            self.ledger.close()
+        shutil.rmtree(self.dir, ignore_errors=True)
+
+    def reopen(self):
+        self.ledger.close()
+        self.ledger = NATIVE.ledger(self.path)
+
+    def test_subset_search_does_not_cover_unsearched_targets(self):
+        old, new = {1, 2, 3}, {4, 5}
+        self.assertEqual(self.ledger.register(old), 1)
+        self.assertEqual(self.ledger.record('d', 0, 100, 0, old), 1)
+        self.assertEqual(self.ledger.register(old | new), 2)
+        # one new target searched: nothing beyond version 1 is proven
+        self.assertEqual(self.ledger.record('d', 0, 100, 1, {4}), 1)
+        self.assertEqual(self.ledger.plan('d', 0, 100), [(0, 100, 1)])
+        # a fresh range searched against the old targets only stays at version 1
+        self.assertEqual(self.ledger.record('d', 100, 200, 0, old), 1)
+        self.assertEqual(self.ledger.plan('d', 100, 200), [(100, 200, 1)])
+        self.assertEqual(self.ledger.targets_since(1, old | new), new)
+        self.assertEqual(self.ledger.record('d', 0, 200, 1, new), 2)
+        self.assertEqual(self.ledger.plan('d', 0, 200), [])
+
+    def test_cracked_targets_do_not_hold_coverage_back(self):
+        self.assertEqual(self.ledger.register({1, 2, 3}), 1)
+        self.assertEqual(self.ledger.record('d', 0, 100, 0, {1, 2, 3}), 1)
+        # 3 was cracked: the next run registers and searches {1, 2} only
+        self.assertEqual(self.ledger.register({1, 2}), 1)
+        self.assertEqual(self.ledger.record('d', 100, 200, 0, {1, 2}), 1)
+        self.assertEqual(self.ledger.plan('d', 0, 200), [])
+        self.assertEqual(self.ledger.stats(), (1, 2, 1))
+        # a retired target that comes back was never checked over [100, 200)
+        self.reopen()
+        self.assertEqual(self.ledger.stats(), (1, 2, 1))
+        self.assertEqual(self.ledger.register({1, 2, 3}), 2)
+        self.assertEqual(self.ledger.plan('d', 0, 200), [(0, 200, 1)])
+        self.assertEqual(self.ledger.targets_since(1, {1, 2, 3}), {3})
+        self.reopen()
+        self.assertEqual(self.ledger.stats(), (2, 3, 1))
+        self.assertEqual(self.ledger.record('d', 0, 200, 1, {3}), 2)
+        self.assertEqual(self.ledger.plan('d', 0, 200), [])
+
+    def test_adjacent_units_merge_and_survive_reopen(self):
+        targets = {h('a'), h('b')}
+        self.ledger.register(targets)
+        for start in range(0, 20000, 10):
+            self.ledger.record('mask:fnv1:?l?l?l', start, start + 10, 0, targets)
+        self.assertEqual(self.ledger.stats(), (1, 2, 1))
+        self.assertEqual(self.ledger.plan('mask:fnv1:?l?l?l', 0, 21000), [(20000, 21000, 0)])
+        size = self.path.stat().st_size
+        self.reopen()
+        # 2002 records on disk, 3 after compaction
+        self.assertLess(self.path.stat().st_size, size)
+        self.assertEqual(self.ledger.stats(), (1, 2, 1))
+        self.assertEqual(self.ledger.plan('mask:fnv1:?l?l?l', 0, 21000), [(20000, 21000, 0)])
+        self.assertEqual(self.ledger.plan('mask:fnv1:?u?u?u', 0, 10), [(0, 10, 0)])
+
+    def test_reopen_keeps_first_target_version(self):
+        self.ledger.register({7})
+        self.ledger.register({7, 8})
+        self.ledger.record('d', 0, 10, 0, {7, 8})
+        self.reopen()
+        self.assertEqual(self.ledger.stats(), (2, 2, 1))
+        self.assertEqual(self.ledger.targets_since(1, {7, 8, 9}), {8, 9})
+        self.assertEqual(self.ledger.plan('d', 0, 10), [])
+
+
+@unittest.skipUnless(NATIVE, 'native library could not be built')
+class DictionaryTest(unittest.TestCase):
+    lines = ['Gandalf', 'gandalf_the_grey', 'gondor', 'gond', 'minas', '  orc  ', 'x' * 40, 'gondor', '']
+    words = sorted({w.strip().lower() for w in lines if 0 < len(w.strip()) <= 31})
+
+    def setUp(self):
+        self.dir = Path(tempfile.mkdtemp(prefix='fnv1_dict_'))
+        (self.dir / 'words.txt').write_text('\n'.join(self.lines) + '\n')
+        with contextlib.redirect_stdout(io.StringIO()):
+            self.compiled = NATIVE.dictionary([self.dir / 'words.txt'])
+
+    def tearDown(self):
+        if self.compiled:
+            self.compiled.close()
+        shutil.rmtree(self.dir, ignore_errors=True)
+
+    def test_stored_states(self):
+        self.assertEqual(self.compiled.words, self.words)
+        for i, w in enumerate(self.words):
+            self.assertEqual(self.compiled.hash(i), h(w))
+            for k in range(len(w) + 1):
+                self.assertEqual(self.compiled.prefix_state(i, k), h(w[:k]), (w, k))
+
+    def test_sweeps(self):
+        names = ['play_gondor', 'gandalf_01', 'gond_minas', 'orc_orc', 'orc7', 'gandalf_the_grey_x']
+        targets = {h(n) for n in names}
+        hits, tested = self.compiled.templates(['play_%s', '%s_01'], targets)
+        self.assertEqual((sorted(n for n, _ in hits), tested), (['gandalf_01', 'play_gondor'], 2 * len(self.words)))
+        hits, _ = self.compiled.combine(targets)
+        self.assertEqual(sorted(n for n, _ in hits), ['gond_minas', 'orc_orc'])
+        for mask, expected in (('?d', ['orc7']), ('_?l', ['gandalf_the_grey_x'])):
+            hits, tested = self.compiled.hybrid(mask, targets)
+            self.assertEqual(sorted(n for n, _ in hits), expected)
+            self.assertEqual(tested, len(self.words) * NATIVE.keyspace({'kind': 'mask', 'mask': mask}))
+
+    def test_corrupt_entries_are_rejected(self):
+        import struct
+        path = self.dir / 'words.fnvdict'
+        good = path.read_bytes()
+        for offset, value in ((24, 1 << 30), (24 + 4, 1 << 30), (24 + 12 + 9, 31)):   # text, state, lcp
+            data = bytearray(good)
+            struct.pack_into('<I' if value > 255 else '<B', data, offset, value)
+            path.write_bytes(bytes(data))
+            handle = NATIVE.lib.dict_open(str(path).encode())
+            self.assertFalse(handle, offset)
+        path.write_bytes(good)
+        handle = NATIVE.lib.dict_open(str(path).encode())
+        self.assertTrue(handle)
+        NATIVE.lib.dict_close(handle)
+
+
+@unittest.skipUnless(NATIVE, 'native library could not be built')
+class DawgTest(unittest.TestCase):
+    words = ['a', 'an', 'and', 'ant', 'b', 'band', 'bands', 'gondor', 'gond', 'orc', 'orcs', 'z' * 31]
+
+    def setUp(self):
+        self.dir = Path(tempfile.mkdtemp(prefix='fnv1_dawg_'))
+        (self.dir / 'words.txt').write_text('\n'.join(w.upper() for w in self.words) + '\n')
+        with contextlib.redirect_stdout(io.StringIO()):
+            self.graph = NATIVE.dawg([self.dir / 'words.txt'])
+
+    def tearDown(self):
+        if self.graph:
+            self.graph.close()
+        shutil.rmtree(self.dir, ignore_errors=True)
+
+    def expected(self, prefix, suffix, words, max_len):
+        return [prefix + '_'.join(p) + suffix for n in range(1, words + 1)
+                for p in itertools.product(self.words, repeat=n)
+                if len(prefix + '_'.join(p) + suffix) <= max_len]
+
+    def test_sweeps_match_python(self):
+        self.assertEqual(self.graph.word_count, len(self.words))
+        for prefix, suffix, words, max_len in (('', '', 1, 31), ('play_', '_01', 3, 20), ('', '', 3, 12)):
+            names = self.expected(prefix, suffix, words, max_len)
+            for threads in (1, 3, 16):    # depth-2 work items must cover the graph exactly once
+                hits, tested = self.graph.search({h(n) for n in names}, prefix, suffix=suffix, words=words,
+                                                 max_len=max_len, threads=threads)
+                self.assertEqual(tested, len(names), (prefix, words, threads))
+                self.assertEqual(sorted(n for n, _ in hits), sorted(names), (prefix, words, threads))
+
+
+@unittest.skipUnless(NATIVE, 'native library could not be built')
+class KeyspaceTest(unittest.TestCase):
+    def test_overflow_saturates_and_jobs_reject_it(self):
+        overflow = NATIVE.KEYSPACE_OVERFLOW
+        self.assertEqual(NATIVE.keyspace({'kind': 'brute', 'min': 1, 'max': 5}),
+                         26 * (1 + 37 + 37 ** 2 + 37 ** 3 + 37 ** 4))
+        self.assertEqual(NATIVE.keyspace({'kind': 'brute', 'min': 1, 'max': 24}), overflow)
+        mask = '?w' * 11
+        self.assertEqual(NATIVE.keyspace({'kind': 'hybrid', 'mask': mask}, ['a'] * 10), 37 ** 11 * 10)
+        self.assertEqual(NATIVE.keyspace({'kind': 'hybrid', 'mask': mask}, ['a'] * 200), overflow)
+        self.assertIsNone(NATIVE.job_start({'kind': 'brute', 'min': 1, 'max': 24}, {h('abc')}))
+        self.assertEqual(NATIVE.hybrid_search(['a'] * 200, mask, {h('abc')}), ([], 0))
+
+
+class ShardCoordinatorTest(unittest.TestCase):
+    def test_state_is_appended_and_resumed(self):
+        directory = Path(tempfile.mkdtemp(prefix='fnv1_shard_'))
+        try:
+            state = directory / 'shard_state.jsonl'
+            job = {'engines': [{'kind': 'mask', 'mask': '?d?d'}], 'words': [], 'backend': 'lowbits16',
+                   'tagged': [[h('ab'), 'event', 'SFX']], 'keyspaces': [100]}
+            first = bfa.ShardCoordinator(job, 10, state)
+            for _ in range(3):
+                unit = first.handle({'op': 'lease', 'worker': 'w'})['unit']
+                first.handle({'op': 'done', 'unit': unit, 'worker': 'w', 'hits': [['ab', 1]], 'tested': 10})
+            first.log.close()
+            with open(state, 'a') as f:
+                f.write('{"units": [9], "hi')          # torn tail
+            self.assertEqual(len(state.read_text().splitlines()), 5)
+
+            second = bfa.ShardCoordinator(job, 10, state)
+            second.log.close()
+            self.assertEqual((len(second.done), second.state['tested']), (3, 30))
+            self.assertEqual(len(state.read_text().splitlines()), 2)
+            third = bfa.ShardCoordinator(dict(job, tagged=[]), 10, state)
+            third.log.close()
+            self.assertEqual(len(third.done), 0)
+        finally:
+            shutil.rmtree(directory, ignore_errors=True)
+
+
+@unittest.skipUnless(NATIVE, 'native library could not be built')
+class JobTest(unittest.TestCase):
+    def test_concurrent_waits(self):
+        import threading
+        job = NATIVE.job_start({'kind': 'mask', 'mask': '?l?l?l?l?l'}, {h('zzzzz')}, threads=2)
+        states = []
+        waiters = [threading.Thread(target=lambda: states.append(job.wait())) for _ in range(4)]
+        for w in waiters:
+            w.start()
+        for w in waiters:
+            w.join()
+        status, hits = job.poll()
+        job.close()
+        self.assertEqual(states, ['done'] * 4)
+        self.assertEqual((hits, status['tested']), ([('zzzzz', h('zzzzz'))], 26 ** 5))
+
+    @staticmethod
+    def name_at(index, length=7):
+        """Name at a ?l^length keyspace index (first position most significant)."""
+        chars = []
+        for _ in range(length):
+            index, c = divmod(index, 26)
+            chars.append(chr(ord('a') + c))
+        return ''.join(reversed(chars))
+
+    def test_targets_updated_mid_job(self):
+        early, added, removed = (self.name_at(i) for i in (1000, 2_000_000_000, 3_000_000_000))
+        job = NATIVE.job_start({'kind': 'mask', 'mask': '?l' * 7}, {h(early), h(removed)},
+                               end=3_200_000_000, threads=1)
+        version = job.update_targets(add={h(added)}, remove={h(removed)})
+        status, _ = job.poll()
+        self.assertLess(status['tested'], 2_000_000_000)      # the update lands before either name
+        job.wait()
+        status, hits = job.poll()
+        job.close()
+        # compare hashes: 3.2G candidates may collide with a target
+        self.assertEqual({v for _, v in hits}, {h(early), h(added)})
+        self.assertIn(added, [n for n, _ in hits])
+        self.assertNotIn(removed, [n for n, _ in hits])
+        self.assertEqual((status['target_version'], status['targets'], status['tested']),
+                         (version, 2, 3_200_000_000))
+
+    def test_cancel_stops_within_a_chunk(self):
+        job = NATIVE.job_start({'kind': 'mask', 'mask': '?l' * 7}, {h('zzzzzzz')}, threads=1)
+        job.cancel()
+        self.assertEqual(job.wait(), 'cancelled')
+        status, hits = job.poll()
+        job.close()
+        self.assertEqual(hits, [])
+        self.assertLess(status['tested'], 26 ** 7)
+
+    def test_matches_past_the_cap_are_counted(self):
+        import itertools
+        import string
+        charset = string.ascii_lowercase + '_0123456789'
+        names = [''.join(p) for p in itertools.product(string.ascii_lowercase, charset, charset, charset)]
+        job = NATIVE.job_start({'kind': 'brute', 'min': 4, 'max': 4}, set(NATIVE.hash_many(names)))
+        job.wait()
+        status, _ = job.poll(max_new=1)
+        job.close()
+        self.assertEqual(status['found'], 1 << 20)
+        self.assertTrue(status['overflow'])
+        # dense chunks are re-run with a bigger buffer rather than losing hits
+        letters = [''.join(p) for p in itertools.product(string.ascii_lowercase, repeat=3)]
+        job = NATIVE.job_start({'kind': 'mask', 'mask': '?l?l?l'}, set(NATIVE.hash_many(letters)))
+        job.wait()
+        status, hits = job.poll(max_new=len(letters))
+        job.close()
+        self.assertEqual((sorted(n for n, _ in hits), status['overflow']), (letters, 0))
+
+    def test_worker_reports_units_that_cannot_start(self):
+        import socket
+        import threading
+        from unittest import mock
+        directory = Path(tempfile.mkdtemp(prefix='fnv1_shard_'))
+        try:
+            job = {'engines': [{'kind': 'mask', 'mask': '?l?l'}, {'kind': 'mask', 'mask': '?q'}],
+                   'words': [], 'backend': 'lowbits16', 'tagged': [[h('qz'), 'event', 'SFX']],
+                   'keyspaces': [676, 10]}
+            coordinator = bfa.ShardCoordinator(job, 300, directory / 'shard_state.jsonl')
+            with socket.socket() as probe:
+                probe.bind(('127.0.0.1', 0))
+                address = probe.getsockname()
+            hits = []
+            with contextlib.redirect_stdout(io.StringIO()):
+                server = threading.Thread(target=lambda: hits.extend(coordinator.serve(address, 60)))
+                server.start()
+                for _ in range(50):
+                    try:
+                        socket.create_connection(address).close()
+                        break
+                    except OSError:
+                        time.sleep(0.1)
+                with mock.patch.object(bfa, 'NativeHasher', lambda: NATIVE):
+                    bfa.shard_worker_loop(address, 'test')
+                server.join(10)
+            self.assertEqual(hits, [('qz', h('qz'))])
+            self.assertEqual((len(coordinator.done), coordinator.failed), (3, {3}))
+        finally:
+            shutil.rmtree(directory, ignore_errors=True)
+
+
+@unittest.skipUnless(NATIVE, 'native library could not be built')
+class NumaTest(unittest.TestCase):
+    """Pools on a fake three-node layout must find what a single node finds."""
+
+    names = ['saruman_%s_01' % m for m in ('abc3x', 'zz9qq', 'q_xor', 'orcks', 'elf1n', 'k_9mm',
+                                           'mm0de', 'dwarf', 'r2d2x', 'token', 'x_y_z', 'endgm')]
+
+    def sandwich(self):
+        hits, _ = NATIVE.sandwich_search(['saruman_?????_01'], {h(n) for n in self.names}, threads=2)
+        return sorted(n for n, *_ in hits)
+
+    def others(self):
+        targets = {h(n) for n in self.names}
+        mutated, _ = NATIVE.mutation_search(['saruman_abc4x_01', 'saruman_orcky_01'], [], targets, 1, threads=2)
+        job = NATIVE.job_start({'kind': 'mask', 'mask': 'saruman_?w?w?w?w?w_01'}, targets, threads=2)
+        job.wait()
+        _, jobbed = job.poll()
+        job.close()
+        return sorted(n for n, *_ in mutated), sorted(n for n, _ in jobbed)
+
+    def test_pools_on_every_node_layout(self):
+        expected = (['saruman_abc3x_01', 'saruman_orcks_01'], sorted(self.names))
+        self.assertEqual((self.sandwich(), self.others()), (sorted(self.names), expected))
+        for layout, nodes in (([1, 1, 1], [1, 1, 1]), ([2, 0, 1], [2, 1])):   # empty nodes are dropped
+            NATIVE.numa_layout(layout)
+            self.assertEqual(NATIVE.numa_nodes(), nodes)
+            for _ in range(3):                  # each pool starts one slot further on
+                self.assertEqual(self.sandwich(), sorted(self.names))
+            self.assertEqual(self.others(), expected)
+
+
+
+
+@unittest.skipUnless(NATIVE, 'native library could not be built')
+class PipelineTest(unittest.TestCase):
+    """The native pipeline must find what the Python generators find, long and non-ASCII names included."""
+
+    words = ['gandalf', 'théoden', 'Éowyn', 'ŋoldor', 'the_fellowship_of_the_ring', 'minas_tirith_citadel', 'orc']
+
+    def attacks(self, candidates):
+        targets = {h(c) for c in candidates}
+        return bfa.DictionaryAttack(targets, native=NATIVE), bfa.DictionaryAttack(targets)
+
+    def assertSameMatches(self, native, python):
+        self.assertEqual(sorted(set(native)), sorted(set(python)))
+
+    def test_list(self):
+        candidates = self.words + ['gandalf', 'x' * 40]
+        native, python = self.attacks(candidates)
+        with contextlib.redirect_stdout(io.StringIO()):
+            hits = native.test_candidates(candidates)
+            self.assertSameMatches(hits, python.test_candidates(candidates))
+        self.assertEqual(len(hits), len(set(candidates)))    # repeated words are reported once
+
+    def test_patterns_and_combinations(self):
+        with contextlib.redirect_stdout(io.StringIO()):
+            candidates = bfa.PatternGenerator(self.words).generate_all()
+            skipped = [c for c in candidates if len(c) > 31 or bfa.native_bytes(c) is None]
+            native, python = self.attacks(candidates[::7] + skipped)
+            self.assertSameMatches(native.run_pattern_attack(self.words), python.run_pattern_attack(self.words))
+            self.assertSameMatches(native.run_combination_attack(self.words, 3),
+                                   python.run_combination_attack(self.words, 3))
+        self.assertTrue(skipped)
+
+    def test_every_candidate_is_tested_once(self):
+        templates = ['%s_' + 'x' * 12 + '_%s', 'play_%s', 'x' * 33]
+        for kind, candidates in (
+                ('list', self.words),
+                ('templates', [t.replace('%s', w) for t in templates for w in self.words]),
+                ('permute', ['_'.join(p) for p in itertools.permutations(self.words, 3)])):
+            _, tested = NATIVE.pipeline_search(kind, self.words, {1}, templates, depth=3)
+            self.assertEqual(tested, len(candidates), kind)
+            hits, _ = NATIVE.pipeline_search(kind, self.words, {h(c) for c in candidates}, templates, depth=3)
+            self.assertEqual(sorted(n for n, _ in hits), sorted(set(candidates)), kind)
+
+
+@unittest.skipUnless(NATIVE, 'native library could not be built')
+class StreamTest(unittest.TestCase):
+    """The -DSTREAM command-line matcher."""
+
+    @classmethod
+    def setUpClass(cls):
+        cls.dir = Path(tempfile.mkdtemp(prefix='fnv1_stream_'))
+        cls.binary = build(['-DSTREAM'], cls.dir / 'fnv_stream')
+        (cls.dir / 'targets.txt').write_text(f"{h('amb_wind')} event SFXAmb\n"
+                                              f"0x{h('amb_wind'):08x} switch SFXWeather  # same ID\n"
+                                              f"{h('play_music')} 1\n")
+
+    @classmethod
+    def tearDownClass(cls):
+        shutil.rmtree(cls.dir, ignore_errors=True)
+
+    def stream(self, data, *flags):
+        if not self.binary:
+            self.skipTest('stream binary could not be built')
+        result = subprocess.run([str(self.binary), str(self.dir / 'targets.txt'), *flags],
+                                input=data, capture_output=True, check=True)
+        return result.stdout.decode().splitlines()
+
+    def test_tags_and_delimiters(self):
+        wind = ['amb_wind\t0x%08X\t%s' % (h('amb_wind'), tags) for tags in ('event\tSFXAmb', 'switch\tSFXWeather')]
+        music = 'play_music\t0x%08X\tswitch_group\t-' % h('play_music')
+        self.assertEqual(self.stream(b'amb_wind\nnothing\nplay_music'), wind + [music])
+        self.assertEqual(self.stream(b'x\0amb_wind\0play_music\0', '-0', '-j', '2'), wind + [music])
+
+    def test_matches_across_blocks(self):
+        lines = ['filler_%07d' % i for i in range(600000)]        # ~9 MB: several read blocks
+        for i in range(0, len(lines), 99991):
+            lines[i] = 'play_music'
+        output = self.stream('\n'.join(lines).encode(), '-j', '3')
+        self.assertEqual(len(output), lines.count('play_music'))
+
+if __name__ == '__main__':
+    try:
+        unittest.main()
+    finally:
+        if BUILD_DIR:
+            shutil.rmtree(BUILD_DIR, ignore_errors=True)